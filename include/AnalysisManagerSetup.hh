@@ -28,6 +28,39 @@ int GetScorePlane4NtupleId();
 // Retourne -1 si non configuré.
 int GetScorePlane5NtupleId();
 
+// Exposer l'ID du ntuple "dictionary" (identifiants internés -> noms)
+// Retourne -1 si non configuré.
+int GetDictionaryNtupleId();
+
 // GetScorePlane6NtupleId() supprimé
 
+// Spectres en énergie pondérés par plan et par classe (primaire / secondaire)
+// Index de plan des histogrammes "Spectrum_<plan>_prim" / "Spectrum_<plan>_sec"
+enum SpectrumPlane {
+    kSpectrumScorePlane = 0,   // SpecSD (z = 18 mm, sortie du plan)
+    kSpectrumScorePlane2,      // ScorePlane2SD
+    kSpectrumScorePlane3,      // ScorePlane3SD
+    kSpectrumWaterRings,       // ScorePlane4SD (couronnes d'eau)
+    kSpectrumScorePlane5,      // ScorePlane5SD
+    kNbSpectrumPlanes
+};
+
+// Exposer l'ID de l'histogramme de spectre d'un plan (secondary = false : primaires)
+// Retourne -1 si non configuré.
+int GetSpectrumH1Id(int plane, bool secondary);
+
+// Exposer les IDs des H3 de la grille de dose (DoseMesh_pGy, DoseMesh_mass_g)
+// Retourne -1 si non configuré.
+int GetDoseMeshH3Id();
+int GetDoseMeshMassH3Id();
+
+// Exposer l'ID du ntuple "dose_stats" (dose et incertitude par anneau / eau totale, par estimateur)
+// Retourne -1 si non configuré.
+int GetDoseStatsNtupleId();
+
+// Exposer les IDs des H2 anneau × profondeur (DepthEdep_keV, DepthDose_pGy)
+// Retourne -1 si non configuré.
+int GetDepthEdepH2Id();
+int GetDepthDoseH2Id();
+
 #endif
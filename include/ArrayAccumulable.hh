@@ -0,0 +1,56 @@
+#ifndef ARRAYACCUMULABLE_HH
+#define ARRAYACCUMULABLE_HH
+
+#include "G4VAccumulable.hh"
+#include "G4Version.hh"
+#include "G4ios.hh"
+#include "globals.hh"
+
+#include <algorithm>
+#include <vector>
+
+// =====================================================
+// Tableau plat de compteurs/sommes enregistrable auprès du G4AccumulableManager
+// Chaque thread remplit sa propre instance sans verrou ; le master additionne
+// les tableaux des workers élément par élément lors de G4AccumulableManager::Merge().
+//
+// Contrainte : la taille doit être identique sur le master et les workers
+// (fixée dans le constructeur de RunAction, avant Register()).
+// =====================================================
+template <typename T>
+class ArrayAccumulable : public G4VAccumulable
+{
+public:
+    explicit ArrayAccumulable(const G4String& name, std::size_t size = 0)
+    : G4VAccumulable(name), fValues(size, T()) {}
+    ~ArrayAccumulable() override = default;
+
+    void Resize(std::size_t size) { fValues.assign(size, T()); }
+
+    inline T&       operator[](std::size_t i)       { return fValues[i]; }
+    inline const T& operator[](std::size_t i) const { return fValues[i]; }
+    inline std::size_t Size() const { return fValues.size(); }
+
+    const std::vector<T>& GetValues() const { return fValues; }
+
+    void Merge(const G4VAccumulable& other) override
+    {
+        const auto& o = static_cast<const ArrayAccumulable<T>&>(other);
+        const std::size_t n = std::min(fValues.size(), o.fValues.size());
+        for (std::size_t i = 0; i < n; ++i) fValues[i] += o.fValues[i];
+    }
+
+    void Reset() override { std::fill(fValues.begin(), fValues.end(), T()); }
+
+#if G4VERSION_NUMBER >= 1130
+    void Print(G4PrintOptions /*options*/ = G4PrintOptions()) const override
+    {
+        G4cout << GetName() << " : " << fValues.size() << " éléments" << G4endl;
+    }
+#endif
+
+private:
+    std::vector<T> fValues;
+};
+
+#endif
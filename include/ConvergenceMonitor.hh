@@ -0,0 +1,79 @@
+#ifndef CONVERGENCEMONITOR_HH
+#define CONVERGENCEMONITOR_HH
+
+#include "ArrayAccumulable.hh"
+#include "globals.hh"
+
+#include <chrono>
+
+class ConvergenceMonitorMessenger;
+
+// =====================================================
+// Arrêt automatique du run sur critère d'incertitude (/convergence/...)
+//  - /run/beamOn N ne fixe plus qu'un plafond : tous les checkEvery événements,
+//    l'erreur relative des régions suivies est comparée à la cible
+//      · dose des anneaux / de l'eau totale : estimateur histoire par histoire
+//        (Σx, Σx² de RunAction, cf. RelativeError)
+//      · plan de comptage : primaires sortant du plan, pondérés par leur poids,
+//        R = √Σw² / Σw (Poisson pondéré ; 1/√N sans biaisage)
+//  - run interrompu (AbortRun doux : l'événement en cours est terminé) dès que
+//    toutes les régions suivies sont sous la cible, ou quand le budget de temps est épuisé
+//  - chaque thread juge sur ses propres événements (en MT : critère conservatif,
+//    l'incertitude du run fusionné est plus faible)
+// =====================================================
+class ConvergenceMonitor
+{
+public:
+    // Régions de dose : bits 0..4 = anneaux, bit 5 = eau totale (même indexation que RunAction::fDoseSums)
+    static const G4int kNbDoseRegions = 6;
+    static const G4int kTotalWaterRegion = kNbDoseRegions - 1;
+
+    struct Settings
+    {
+        G4bool   enabled = false;
+        G4double targetRelErr = 0.01;
+        unsigned regionMask = 1u << kTotalWaterRegion;   // défaut : eau totale
+        G4int    planeIndex = -1;                        // plan de VolumeRoleRegistry, -1 : aucun
+        G4long   checkEvery = 10000;
+        G4long   minEvents = 1000;
+        G4double maxTime_s = 0.;                         // <= 0 : pas de budget de temps
+    };
+
+    enum StopReason { kNotStopped = 0, kConverged, kTimeBudget };
+
+    ConvergenceMonitor();
+    ~ConvergenceMonitor();
+
+    // Erreur relative de la moyenne par événement : s(x̄)/x̄ avec
+    // s²(x̄) = (Σx²/N - x̄²)/(N - 1) ; -1 si non définie (N < 2 ou Σx = 0)
+    static G4double RelativeError(G4double sum, G4double sum2, G4long nEvents);
+
+    void BeginRun();
+
+    // Fin de chaque événement du thread : doseSums[2k] = Σx, [2k+1] = Σx² ;
+    // planePrimWeights[4p+2] = Σw, [4p+3] = Σw² des primaires sortant du plan p
+    // (cf. RunAction::CountPlanePrimLeave). Déclenche l'AbortRun si besoin.
+    void EndOfEvent(const ArrayAccumulable<G4double>& doseSums,
+                    const ArrayAccumulable<G4double>& planePrimWeights);
+
+    void EndRun() const;
+
+    Settings& GetSettings() { return fSettings; }
+    const Settings& GetSettings() const { return fSettings; }
+
+private:
+    // Plus grande erreur relative des régions suivies (-1 si une région n'est pas encore définie)
+    G4double WorstRelativeError(const ArrayAccumulable<G4double>& doseSums,
+                                const ArrayAccumulable<G4double>& planePrimWeights) const;
+
+    Settings fSettings;
+
+    G4long     fEvents = 0;
+    G4double   fLastRelErr = -1.;
+    StopReason fStopReason = kNotStopped;
+    std::chrono::steady_clock::time_point fStart;
+
+    ConvergenceMonitorMessenger* fMessenger = nullptr;
+};
+
+#endif
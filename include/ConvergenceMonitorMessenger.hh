@@ -0,0 +1,35 @@
+#ifndef ConvergenceMonitorMessenger_h
+#define ConvergenceMonitorMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAString;
+class G4UIcmdWithAnInteger;
+class ConvergenceMonitor;
+
+// Commandes /convergence/... (arrêt du run sur incertitude cible ou budget de temps)
+class ConvergenceMonitorMessenger : public G4UImessenger {
+public:
+    ConvergenceMonitorMessenger(ConvergenceMonitor* monitor);
+    ~ConvergenceMonitorMessenger() override;
+
+    void SetNewValue(G4UIcommand*, G4String) override;
+
+private:
+    ConvergenceMonitor* fMonitor;
+    G4UIdirectory* fDir;
+    G4UIcmdWithABool* fEnableCmd;
+    G4UIcmdWithADouble* fTargetCmd;
+    G4UIcmdWithAString* fRegionsCmd;
+    G4UIcmdWithAString* fPlaneCmd;
+    G4UIcmdWithAnInteger* fCheckEveryCmd;
+    G4UIcmdWithAnInteger* fMinEventsCmd;
+    G4UIcmdWithADoubleAndUnit* fMaxTimeCmd;
+};
+
+#endif
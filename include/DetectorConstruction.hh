@@ -17,7 +17,15 @@
 #include "G4GenericMessenger.hh"
 //#include "SensitiveDetector.hh"
 
+#include "VirtualPlaneScorer.hh"
+
+#include <vector>
+
 class DetectorMessenger;
+class ImportanceMessenger;
+class ScoringParallelWorld;
+class ImportanceParallelWorld;
+class G4GeometrySampler;
 
 class DetectorConstruction : public G4VUserDetectorConstruction{
     public:
@@ -33,6 +41,38 @@ class DetectorConstruction : public G4VUserDetectorConstruction{
 
         void ConstructGDML();
 
+        // =====================================================
+        // Mode de scoring des plans de comptage
+        //  - kScoringVolume   : boîtes d'air minces + SD + G4UserLimits (historique)
+        //  - kScoringVirtual  : plans détectés analytiquement (VirtualPlaneScorer)
+        //  - kScoringParallel : plans et couronnes dans un monde parallèle (ScoringParallelWorld)
+        // =====================================================
+        enum ScoringMode { kScoringVolume = 0, kScoringVirtual, kScoringParallel };
+        void SetScoringMode(ScoringMode mode);
+        ScoringMode GetScoringMode() const { return fScoringMode; }
+
+        // =====================================================
+        // Importance géométrique des photons (/importance/..., ImportanceParallelWorld)
+        // La première région déclarée (PreInit) enregistre le monde parallèle et G4ImportanceBiasing
+        // =====================================================
+        void AddImportanceRegion(const G4String& name, G4double zMin, G4double zMax, G4double importance);
+        void SetRegionImportance(const G4String& name, G4double importance);
+        void SetOutsideImportance(G4double importance);
+        void PrintImportanceRegions() const;
+
+        // Plans de comptage hors mode "volume" (remplis par Construct())
+        const std::vector<VirtualPlane>& GetScoringPlanes() const { return fScoringPlanes; }
+
+        // Géométrie des couronnes d'eau : pas radial, demi-épaisseur Z, centre Z
+        void GetWaterRingGeometry(G4double& radialStep, G4double& halfZ, G4double& zCenter) const
+        {
+            radialStep = fWaterRingRadialStep;
+            halfZ      = fWaterRingHalfZ;
+            zCenter    = fWaterRingCenterZ;
+        }
+        // Matériau des couronnes (et du disque d'eau en mode parallel)
+        const G4Material* GetWaterRingMaterial() const { return MyWater; }
+
         void PrintAllMaterials();
         void PrintUsedMaterials();
 
@@ -122,6 +162,17 @@ class DetectorConstruction : public G4VUserDetectorConstruction{
         G4double xWorld, yWorld, zWorld;
 
         G4bool fisGDML;
+        ScoringMode fScoringMode = kScoringVolume;
+        std::vector<VirtualPlane> fScoringPlanes;
+        ScoringParallelWorld* fScoringWorld = nullptr;   // possédé par le G4RunManager
+
+        ImportanceMessenger* fImportanceMessenger = nullptr;
+        ImportanceParallelWorld* fImportanceWorld = nullptr;   // possédé par le G4RunManager
+        G4GeometrySampler* fImportanceSampler = nullptr;
+
+        G4double fWaterRingRadialStep = 0.;
+        G4double fWaterRingHalfZ      = 0.;
+        G4double fWaterRingCenterZ    = 0.;
 
         // =====================================================
         // NOUVEAU : Pointeurs vers le volume de l'anode tungstène
@@ -9,6 +9,7 @@ class G4UIdirectory;
 class G4UIcmdWithAnInteger;
 class G4UIcmdWithADoubleAndUnit;
 class G4UIcmdWithABool;
+class G4UIcmdWithAString;
 
 class DetectorMessenger : public G4UImessenger {
 
@@ -26,5 +27,6 @@ private:
     G4UIcmdWithABool* fisPetriBoxcmd;
     G4UIcmdWithABool* fisGDMLcmd;
     G4UIcmdWithADoubleAndUnit* fPosSourcecmd;
+    G4UIcmdWithAString* fScoringModecmd;
 };
 #endif
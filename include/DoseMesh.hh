@@ -0,0 +1,115 @@
+#ifndef DOSEMESH_HH
+#define DOSEMESH_HH
+
+#include "ArrayAccumulable.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ThreeVector.hh"
+#include "Randomize.hh"
+#include "globals.hh"
+
+#include <cmath>
+#include <vector>
+
+class G4AccumulableManager;
+class DoseMeshMessenger;
+
+// =====================================================
+// Grille de dose 3D sur le fantôme d'eau (indépendante des volumes de la géométrie)
+//  - désactivée par défaut : Fill() tire un nombre aléatoire par dépôt, ce qui décalerait
+//    la séquence aléatoire des runs qui n'utilisent pas la grille
+//  - cylindrique (r, φ, z) ou cartésienne (x, y, z), configurée par /dose/mesh/...
+//    (par défaut : cylindre r ≤ rayon de l'eau, z sur l'épaisseur d'eau, lu dans DetectorConstruction)
+//  - chaque thread remplit son propre tableau (ArrayAccumulable, keV × poids) ;
+//    le dépôt d'un step est placé en un point tiré uniformément sur le segment pre -> post
+//  - fusion par G4AccumulableManager, puis écriture par le master : H3 "DoseMesh_pGy"
+//    (dose par voxel) et H3 "DoseMesh_mass_g" (masse par voxel, échantillonnage des
+//    matériaux de la géométrie : la grille peut donc déborder sur le PVC ou l'air)
+// =====================================================
+class DoseMesh
+{
+public:
+    enum Type { kCylindrical = 0, kCartesian };
+
+    // Axes : 0 = r | x, 1 = φ | y, 2 = z ; bornes en unités Geant4 (φ en rad)
+    struct Spec
+    {
+        G4bool   enabled = false;   // sur demande : /dose/mesh/enable, cylinder ou box
+        Type     type = kCylindrical;
+        G4int    n[3] = {20, 1, 30};
+        G4double min[3] = {0., -CLHEP::pi, 0.};
+        G4double max[3] = {0., CLHEP::pi, 0.};
+        G4bool   fromGeometry = true;   // bornes r / z reprises de la géométrie de l'eau
+    };
+
+    DoseMesh();
+    ~DoseMesh();
+
+    void Register(G4AccumulableManager* accMgr);
+
+    // Chaque thread, BeginOfRunAction (avant Reset des accumulables) : dimensionne la grille
+    // et le binning des H3 ; le master calcule en plus la masse des voxels
+    void BeginRun(G4bool isMaster);
+
+    inline void Fill(const G4Step* step)
+    {
+        if (!fSpec.enabled) return;
+        const G4double edep = step->GetTotalEnergyDeposit();
+        if (edep <= 0.) return;
+
+        const G4ThreeVector& p0 = step->GetPreStepPoint()->GetPosition();
+        const G4ThreeVector& p1 = step->GetPostStepPoint()->GetPosition();
+
+        // Rejet rapide : segment entièrement hors de la tranche z de la grille
+        if ((p0.z() < fSpec.min[2] && p1.z() < fSpec.min[2]) ||
+            (p0.z() >= fSpec.max[2] && p1.z() >= fSpec.max[2])) return;
+
+        const G4ThreeVector p = p0 + G4UniformRand() * (p1 - p0);
+        const G4int idx = VoxelIndex(p);
+        if (idx < 0) return;
+        fEdep[static_cast<std::size_t>(idx)] += edep / CLHEP::keV * step->GetPreStepPoint()->GetWeight();
+    }
+
+    // Master, après G4AccumulableManager::Merge() : remplit les H3 et imprime un résumé
+    void Write(G4int doseH3Id, G4int massH3Id) const;
+
+    // Configuration (DoseMeshMessenger)
+    Spec& GetSpec() { return fSpec; }
+    const Spec& GetSpec() const { return fSpec; }
+    std::size_t GetNbVoxels() const { return fEdep.Size(); }
+
+private:
+    inline G4int VoxelIndex(const G4ThreeVector& p) const
+    {
+        G4double u[3];
+        if (fSpec.type == kCylindrical) {
+            u[0] = std::sqrt(p.x()*p.x() + p.y()*p.y());
+            u[1] = (fSpec.n[1] > 1) ? std::atan2(p.y(), p.x()) : fSpec.min[1];
+        } else {
+            u[0] = p.x();
+            u[1] = p.y();
+        }
+        u[2] = p.z();
+
+        G4int i[3];
+        for (G4int a = 0; a < 3; ++a) {
+            if (u[a] < fSpec.min[a] || u[a] >= fSpec.max[a]) return -1;
+            i[a] = static_cast<G4int>((u[a] - fSpec.min[a]) * fInvWidth[a]);
+            if (i[a] >= fSpec.n[a]) i[a] = fSpec.n[a] - 1;
+        }
+        return (i[0] * fSpec.n[1] + i[1]) * fSpec.n[2] + i[2];
+    }
+
+    void ComputeVoxelMasses();
+
+    Spec fSpec;
+    G4double fInvWidth[3] = {0., 0., 0.};
+
+    ArrayAccumulable<G4double> fEdep;   // keV × poids, index (i0 * n1 + i1) * n2 + i2
+    std::vector<G4double> fMass_g;      // master uniquement
+
+    DoseMeshMessenger* fMessenger = nullptr;
+};
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef DoseMeshMessenger_h
+#define DoseMeshMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithABool;
+class DoseMesh;
+
+// Commandes /dose/mesh/enable, /dose/mesh/cylinder et /dose/mesh/box
+class DoseMeshMessenger : public G4UImessenger {
+public:
+    DoseMeshMessenger(DoseMesh* mesh);
+    ~DoseMeshMessenger() override;
+
+    void SetNewValue(G4UIcommand*, G4String) override;
+
+private:
+    G4UIcommand* MakeGridCommand(const char* path, const char* n0, const char* n1, const char* extent);
+
+    DoseMesh* fMesh;
+    G4UIdirectory* fDoseDir;
+    G4UIdirectory* fDir;
+    G4UIcmdWithABool* fEnableCmd;
+    G4UIcommand* fCylinderCmd;
+    G4UIcommand* fBoxCmd;
+};
+
+#endif
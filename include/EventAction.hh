@@ -39,6 +39,7 @@ public:
     //void RegisterToRunAction(RunAction* runAction);
 
     void SetRunAction(RunAction* runAction) { fRunAction = runAction; }
+    RunAction* GetRunAction() const { return fRunAction; }
 
     void SetVerbose(G4int level) { fEventVerboseLevel = level; }
 
@@ -60,12 +61,20 @@ public:
     }
     G4double GetEdepTotalWater() const { return fEdepTotalWater; }
 
+    // Estimateur de kerma par longueur de trace (keV, pondéré) : w · L · E · μen(E)
+    void AddTrackLengthToRing(G4int ringIndex, G4double edep) {
+        if (ringIndex >= 0 && ringIndex < kNbWaterRings) {
+            fTleRing[ringIndex] += edep;
+            fTleTotalWater += edep;
+        }
+    }
+
 
 private:
 
     G4bool enteredCube = false;
     G4bool enteredSphere = false;
-    G4String creatorProcess = "unknown";
+    G4int fCreatorProcessId = MyTrackInfo::kUnknownProcessId;
 
     // Compteurs pour Beryllium
     G4int fNbInteractedInBe = 0;
@@ -89,5 +98,9 @@ private:
     G4double fEdepRing[kNbWaterRings] = {0.0, 0.0, 0.0, 0.0, 0.0};
     G4double fEdepTotalWater = 0.0;
 
+    // Estimateur par longueur de trace (par événement)
+    G4double fTleRing[kNbWaterRings] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    G4double fTleTotalWater = 0.0;
+
 };
 #endif
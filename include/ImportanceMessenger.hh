@@ -0,0 +1,30 @@
+#ifndef ImportanceMessenger_h
+#define ImportanceMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithADouble;
+class G4UIcmdWithoutParameter;
+class DetectorConstruction;
+
+// Commandes /importance/... (splitting / roulette russe des photons par tranches en z)
+class ImportanceMessenger : public G4UImessenger {
+public:
+    ImportanceMessenger(DetectorConstruction* detector);
+    ~ImportanceMessenger() override;
+
+    void SetNewValue(G4UIcommand*, G4String) override;
+
+private:
+    DetectorConstruction* fDetector;
+    G4UIdirectory* fDir;
+    G4UIcommand* fRegionCmd;
+    G4UIcommand* fSetCmd;
+    G4UIcmdWithADouble* fOutsideCmd;
+    G4UIcmdWithoutParameter* fListCmd;
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef IMPORTANCEPARALLELWORLD_HH
+#define IMPORTANCEPARALLELWORLD_HH
+
+#include "G4VUserParallelWorld.hh"
+#include "G4VPhysicalVolume.hh"
+#include "globals.hh"
+
+#include <vector>
+
+// =====================================================
+// Monde parallèle d'importance géométrique (/importance/..., activé en PreInit)
+//  - une tranche en z par région déclarée (tube, collimateur, lame d'air, eau...),
+//    couvrant toute la section du monde ; hors tranches : importance "outside"
+//  - les importances sont écrites dans le G4IStore du monde parallèle à la fin de
+//    Construct() ; G4ImportanceBiasing (photons) fait le splitting / la roulette
+//    russe aux frontières des tranches et ajuste le poids des traces
+//  - les scorers lisent déjà le poids de la trace (dose, spectres, ntuples des plans)
+// Les tranches ne portent aucun matériau : la navigation du monde de masse est inchangée.
+// =====================================================
+class ImportanceParallelWorld : public G4VUserParallelWorld
+{
+public:
+    static constexpr const char* kWorldName = "ImportanceWorld";
+
+    struct Region {
+        G4String           name;
+        G4double           zMin = 0.;
+        G4double           zMax = 0.;
+        G4double           importance = 1.;
+        G4VPhysicalVolume* physical = nullptr;
+    };
+
+    explicit ImportanceParallelWorld(const G4String& worldName);
+    ~ImportanceParallelWorld() override = default;
+
+    void Construct() override;
+
+    // PreInit : déclaration d'une tranche [zMin, zMax] (sans recouvrement avec les autres)
+    G4bool AddRegion(const G4String& name, G4double zMin, G4double zMax, G4double importance);
+
+    // PreInit ou Idle : nouvelle importance (répercutée dans le G4IStore si la géométrie existe)
+    G4bool SetImportance(const G4String& name, G4double importance);
+    void SetOutsideImportance(G4double importance);
+
+    void Print() const;
+
+private:
+    void FillImportanceStore();
+
+    std::vector<Region> fRegions;        // triées par zMin croissant
+    G4double fOutsideImportance = 1.;
+    G4VPhysicalVolume* fGhostWorld = nullptr;   // connu après Construct() (GetWorld() le créerait)
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef MINIXSPECTRUM_HH
+#define MINIXSPECTRUM_HH
+
+#include "globals.hh"
+
+// =====================================================
+// Spectre Mini-X intégré (source 2) : 50 points de 1 à 50 keV, intensité relative,
+// linéaire par segment. Seule copie de la table : PrimaryGeneratorAction2::InitFunction
+// et tests/spectrum_sampler_test.cc l'incluent tous deux.
+// =====================================================
+namespace MiniXSpectrum
+{
+    constexpr G4int kNbPoints = 50;
+
+    // Coupure basse : les photons sous 3.5 keV ne sont pas émis
+    constexpr G4double kCut_keV = 3.5;
+
+    constexpr G4double kEnergy_keV[kNbPoints] =
+      {  1.,  2.,  3.,  4.,  5.,  6.,  7.,  8.,  9., 10.,
+        11., 12., 13., 14., 15., 16., 17., 18., 19., 20.,
+        21., 22., 23., 24., 25., 26., 27., 28., 29., 30.,
+        31., 32., 33., 34., 35., 36., 37., 38., 39., 40.,
+        41., 42., 43., 44., 45., 46., 47., 48., 49., 50. };
+
+    constexpr G4double kIntensity[kNbPoints] =
+      { 0.0205648, 63.56, 100.0, 90.93, 76.80, 64.72, 55.15, 47.59, 41.54, 36.61,
+        32.53, 29.10, 26.19, 23.68, 21.51, 19.60, 17.91, 16.41, 15.06, 13.85,
+        12.75, 11.75, 10.84, 10.00,  9.24,  8.53,  7.87,  7.26,  7.26,  6.16,
+        5.66,  5.20,  4.76,  4.35,  3.96,  3.59,  3.25,  2.92,  2.61,  2.31,
+        2.03,  1.76,  1.50,  1.26,  1.03,  0.80,  0.59,  0.39,  0.19,  0.00 };
+}
+
+#endif
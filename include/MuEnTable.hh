@@ -0,0 +1,49 @@
+#ifndef MUENTABLE_HH
+#define MUENTABLE_HH
+
+#include "globals.hh"
+
+#include <cmath>
+#include <vector>
+
+class G4Material;
+
+// =====================================================
+// Coefficient d'absorption en énergie μen(E) d'un matériau, pour l'estimateur
+// de kerma par longueur de trace (SteppingAction, /stepping/trackLengthEstimator)
+//  - données NIST μen/ρ (Hubbell & Seltzer, NISTIR 5632), interpolées log-log
+//    une fois sur une grille fine en log(E), multipliées par la densité du matériau
+//  - dans le hot path : un log et une interpolation linéaire sur la grille
+//  - matériaux reconnus par leur composition, pas par leur nom : eau = H et O seuls,
+//    fractions massiques de H2O à 1e-3 près (G4_WATER, "H2O" de DetectorConstruction, ...) ;
+//    la densité est celle du matériau. Non reconnu : ForMaterial -> nullptr
+// =====================================================
+class MuEnTable
+{
+public:
+    // Table du matériau, construite au premier appel (partagée entre threads,
+    // cache par thread indexé par G4Material::GetIndex()) ; nullptr si non tabulé
+    static const MuEnTable* ForMaterial(const G4Material* mat);
+
+    // μen linéaire (unités Geant4, 1/longueur) ; bornée aux extrémités de la grille
+    inline G4double GetMuEn(G4double energy) const
+    {
+        const G4double u = (std::log(energy) - fLogEmin) * fInvDeltaLog;
+        if (u <= 0.) return fMuEn.front();
+        if (u >= static_cast<G4double>(kNbBins)) return fMuEn.back();
+        const std::size_t i = static_cast<std::size_t>(u);
+        const G4double f = u - static_cast<G4double>(i);
+        return fMuEn[i] + f * (fMuEn[i + 1] - fMuEn[i]);
+    }
+
+private:
+    MuEnTable(const G4double* energy_MeV, const G4double* muEnRho_cm2g, std::size_t n, G4double density);
+
+    static const std::size_t kNbBins = 1024;
+
+    G4double fLogEmin = 0.;
+    G4double fInvDeltaLog = 0.;
+    std::vector<G4double> fMuEn;   // kNbBins + 1 points, 1/longueur
+};
+
+#endif
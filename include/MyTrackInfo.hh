@@ -2,32 +2,78 @@
 #define MYTRACKINFO_HH
 
 #include "G4VUserTrackInformation.hh"
+#include "G4Allocator.hh"
 #include "globals.hh"
+#include "ProcessIdTable.hh"
 
+#include <cstdint>
+
+class G4Track;
+
+// =====================================================
+// Informations utilisateur attachées à chaque G4Track
+// - attachées une seule fois dans TrackingAction::PreUserTrackingAction
+// - servies par un G4Allocator thread-local (pas de new/delete système par track)
+// - aucun G4String : processus créateur sous forme d'identifiant entier,
+//   états "entré dans ..." sous forme de bits
+// =====================================================
 class MyTrackInfo : public G4VUserTrackInformation
 {
 public:
-    MyTrackInfo();
-    virtual ~MyTrackInfo();
+    // Bits de fFlags
+    enum Flag : std::uint8_t {
+        kEnteredCube   = 1u << 0,
+        kEnteredSphere = 1u << 1
+    };
+
+    // Identifiants réservés du processus créateur (cf. ProcessIdTable)
+    static const G4int kPrimaryProcessId = ProcessIdTable::kPrimaryId;   // particule primaire
+    static const G4int kUnknownProcessId = ProcessIdTable::kUnknownId;
+
+    explicit MyTrackInfo(G4int creatorProcessId = kUnknownProcessId);
+    ~MyTrackInfo() override = default;
+
+    // Attache un MyTrackInfo au track s'il n'en a pas encore, et le retourne
+    static MyTrackInfo* Attach(const G4Track* track);
+
+    // Identifiant interné du processus créateur d'un track (kPrimaryProcessId si primaire)
+    static G4int CreatorProcessIdOf(const G4Track* track);
 
-    inline void SetEnteredCube(G4bool val) { enteredCube = val; }
-    inline G4bool HasEnteredCube() const { return enteredCube; }
+    inline void SetEnteredCube(G4bool val) { SetFlag(kEnteredCube, val); }
+    inline G4bool HasEnteredCube() const { return (fFlags & kEnteredCube) != 0; }
 
-    void SetEnteredSphere(G4bool val) { enteredSphere = val; }
-    G4bool HasEnteredSphere() const { return enteredSphere; }
+    inline void SetEnteredSphere(G4bool val) { SetFlag(kEnteredSphere, val); }
+    inline G4bool HasEnteredSphere() const { return (fFlags & kEnteredSphere) != 0; }
+
+    inline std::uint8_t GetFlags() const { return fFlags; }
 
     // Processus créateur
-    void SetCreatorProcess(const G4String& name) { creatorProcess = name; }
-    G4String GetCreatorProcess() const {
-        return creatorProcess.empty() ? "unknown" : creatorProcess;
+    inline void SetCreatorProcessId(G4int id) { fCreatorProcessId = id; }
+    inline G4int GetCreatorProcessId() const { return fCreatorProcessId; }
 
-    }
+    // Allocateur thread-local (convention Geant4)
+    void* operator new(size_t);
+    void operator delete(void*);
 
 private:
-    G4bool enteredCube;
-    G4bool enteredSphere;
-    G4String creatorProcess;
+    inline void SetFlag(Flag f, G4bool val)
+    {
+        fFlags = val ? static_cast<std::uint8_t>(fFlags | f) : static_cast<std::uint8_t>(fFlags & ~f);
+    }
 
+    G4int   fCreatorProcessId;
+    std::uint8_t fFlags = 0;
 };
 
+extern G4ThreadLocal G4Allocator<MyTrackInfo>* MyTrackInfoAllocator;
+
+inline void* MyTrackInfo::operator new(size_t){
+    if(!MyTrackInfoAllocator) MyTrackInfoAllocator = new G4Allocator<MyTrackInfo>;
+    return MyTrackInfoAllocator->MallocSingle();
+}
+
+inline void MyTrackInfo::operator delete(void* info){
+    MyTrackInfoAllocator->FreeSingle((MyTrackInfo*) info);
+}
+
 #endif // MYTRACKINFO_HH
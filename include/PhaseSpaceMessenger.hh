@@ -0,0 +1,30 @@
+#ifndef PhaseSpaceMessenger_h
+#define PhaseSpaceMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAString;
+class PhaseSpaceWriter;
+
+// Commandes /phasespace/... (écriture de l'espace des phases à un plan z, étape 1)
+class PhaseSpaceMessenger : public G4UImessenger {
+public:
+    PhaseSpaceMessenger(PhaseSpaceWriter* writer);
+    ~PhaseSpaceMessenger() override;
+
+    void SetNewValue(G4UIcommand*, G4String) override;
+
+private:
+    PhaseSpaceWriter* fWriter;
+    G4UIdirectory* fDir;
+    G4UIcmdWithABool* fEnableCmd;
+    G4UIcmdWithADoubleAndUnit* fPlaneCmd;
+    G4UIcmdWithABool* fKillCmd;
+    G4UIcmdWithAString* fFileCmd;
+};
+
+#endif
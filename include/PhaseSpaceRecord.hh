@@ -0,0 +1,51 @@
+#ifndef PHASESPACERECORD_HH
+#define PHASESPACERECORD_HH
+
+// =====================================================
+// Format binaire de l'espace des phases (plan de sortie du collimateur)
+// (écrit par PhaseSpaceWriter, relu par PrimaryGeneratorAction4 ;
+//  volontairement sans dépendance Geant4, comme StepTraceRecord.hh)
+//
+// Fichier :
+//   FileHeader
+//   Record, Record, ... (nRecords)
+//
+// nHistories : événements source simulés par le thread qui a écrit le fichier,
+// pour normaliser les grandeurs de l'étape 2 par histoire source.
+// =====================================================
+
+#include <cstdint>
+#include <type_traits>
+
+namespace PhaseSpaceIO
+{
+    constexpr char          kMagic[8] = {'P', 'H', 'S', 'P', 'A', 'C', 'E', '0'};
+    constexpr std::uint32_t kVersion  = 1;
+
+    struct FileHeader
+    {
+        char          magic[8];
+        std::uint32_t version;
+        std::uint32_t recordSize;   // sizeof(Record), contrôle de cohérence à la relecture
+        std::int32_t  threadId;     // -1 en séquentiel
+        float         zPlane_mm;    // plan de passage enregistré
+        std::uint64_t nHistories;   // réécrit en fin de run
+        std::uint64_t nRecords;     // réécrit en fin de run
+    };
+
+    // Une particule traversant le plan vers +z : 36 octets, position en mm, énergie en keV
+    struct Record
+    {
+        std::int32_t pdg;
+        float        pos_mm[3];
+        float        dir[3];
+        float        ekin_keV;
+        float        weight;
+    };
+
+    static_assert(sizeof(FileHeader) == 40, "PhaseSpaceIO::FileHeader : disposition figée (40 octets)");
+    static_assert(sizeof(Record) == 36, "PhaseSpaceIO::Record doit rester compact (36 octets)");
+    static_assert(std::is_trivially_copyable<Record>::value, "PhaseSpaceIO::Record doit rester POD");
+}
+
+#endif
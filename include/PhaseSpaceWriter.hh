@@ -0,0 +1,75 @@
+#ifndef PHASESPACEWRITER_HH
+#define PHASESPACEWRITER_HH
+
+#include "PhaseSpaceRecord.hh"
+#include "globals.hh"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+class G4Step;
+class PhaseSpaceMessenger;
+
+// =====================================================
+// Écriture de l'espace des phases à un plan z (étape 1 d'une simulation en deux étapes),
+// une instance par thread (/phasespace/...)
+//
+// - SteppingAction appelle Record() à chaque step si IsEnabled() : toute particule qui
+//   traverse z = zPlane vers +z est enregistrée (PDG, position interpolée sur le plan,
+//   direction, énergie cinétique et poids au pre-step), puis tuée si kill est actif
+//   (pas de double comptage ni de simulation inutile du fantôme).
+// - Tampon de taille fixe vidé sur disque quand il est plein et en fin de run ;
+//   nHistories / nRecords sont réécrits dans l'en-tête à la fermeture.
+// - Fichier : <base>_run<R>_<seq|tN>.psf, rejoué par /primariesgenerator/selectsource 4.
+// =====================================================
+class PhaseSpaceWriter
+{
+public:
+    // Instance propre au thread courant ; Destroy() en fin de thread (RunAction::~RunAction)
+    static PhaseSpaceWriter* Instance();
+    static void Destroy();
+
+    // Configuration (commandes /phasespace/...)
+    void SetEnabled(G4bool on) { fEnabled = on; }
+    void SetPlaneZ(G4double z) { fPlaneZ = z; }
+    void SetKillAtPlane(G4bool on) { fKillAtPlane = on; }
+    void SetBaseName(const G4String& name) { fBaseName = name; }
+
+    void BeginRun(G4int runID);
+    void EndRun(G4long nHistories);
+
+    inline G4bool IsEnabled() const { return fEnabled; }
+    inline G4bool KillAtPlane() const { return fKillAtPlane; }
+    inline G4double GetPlaneZ() const { return fPlaneZ; }
+
+    // true si le step traverse le plan vers +z (la particule a été enregistrée)
+    G4bool Record(const G4Step* step);
+
+private:
+    PhaseSpaceWriter();
+    ~PhaseSpaceWriter();
+
+    void Flush();
+    void OpenFile();
+
+    static const std::size_t kBufferSize = 16384;   // ~600 ko par thread
+
+    std::vector<PhaseSpaceIO::Record> fBuffer;
+    std::size_t fCount = 0;
+
+    G4bool   fEnabled = false;
+    G4bool   fKillAtPlane = true;
+    G4double fPlaneZ;
+    G4String fBaseName = "phasespace";
+
+    G4int  fRunID = 0;
+    G4long fRecordsWritten = 0;
+
+    std::ofstream fFile;
+    std::string   fFileName;
+
+    PhaseSpaceMessenger* fMessenger = nullptr;
+};
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef PlaneCrossingSD_hh
+#define PlaneCrossingSD_hh 1
+
+#include "G4VSensitiveDetector.hh"
+#include "G4ThreeVector.hh"
+#include "G4VPhysicalVolume.hh"
+#include "globals.hh"
+
+#include "TrackIdSet.hh"
+
+#include <algorithm>
+#include <vector>
+
+class G4Step;
+class G4HCofThisEvent;
+class G4TouchableHistory;
+class G4Track;
+class PlaneCrossingSDMessenger;
+
+// =====================================================
+// Règle d'acceptation d'un passage (modifiable via /scoring/<nomSD>/...)
+// =====================================================
+struct PlaneCrossingPolicy
+{
+    G4bool plusZOnly      = true;   // n'accepte que dir.z() > 0 au pre-step
+    G4bool firstEntryOnly = true;   // une seule ligne par trace et par événement
+};
+
+/**
+ * @brief Sensitive detector générique de passage de plan (remplace ScorePlane2SD..ScorePlane5SD)
+ *
+ * Le SD est attaché à un ou plusieurs volumes logiques ; les volumes physiques
+ * "cibles" sont déclarés par AddTargetVolume() dans DetectorConstruction::ConstructSDandField().
+ * Le test d'entrée compare des pointeurs (aucune construction / comparaison de G4String par pas).
+ * Plusieurs cibles = "n'importe quel anneau" (couronnes d'eau) : passer d'une cible à une
+ * autre n'est pas une entrée, même avec firstEntryOnly = false.
+ *
+ * Ntuple (ScorePlane2/3/5_passages, WaterRings_passages) :
+ *   - pdg            : code PDG de la particule
+ *   - is_secondary   : 0 = primaire, 1 = secondaire (issu d'une réaction)
+ *   - x_mm           : position X du premier step dans le volume (mm)
+ *   - y_mm           : position Y du premier step dans le volume (mm)
+ *   - ekin_keV       : énergie cinétique à l'entrée dans le volume (keV)
+ *   - trackID        : identifiant unique de la trace dans l'événement
+ *   - parentID       : TrackID de la particule parente (0 si primaire)
+ *   - creator_process_id : id du processus créateur (0 = primaire, cf. ntuple "dictionary")
+ */
+class PlaneCrossingSD : public G4VSensitiveDetector
+{
+public:
+    explicit PlaneCrossingSD(const G4String& name,
+                             const PlaneCrossingPolicy& policy = PlaneCrossingPolicy());
+    ~PlaneCrossingSD() override;
+
+    void Initialize(G4HCofThisEvent* hce) override;
+    G4bool ProcessHits(G4Step* step, G4TouchableHistory*) override;
+    void EndOfEvent(G4HCofThisEvent* hce) override;
+
+    // Entrée validée (position / énergie à la face d'entrée) : appliquer la règle
+    // d'acceptation et remplir le ntuple. Appelé par ProcessHits, ou par
+    // VirtualPlaneScorer en mode plans virtuels.
+    G4bool ScoreEntry(const G4Track* track, const G4ThreeVector& pos,
+                      G4double ekin, const G4ThreeVector& dir);
+
+    // Configuration
+    void AddTargetVolume(const G4VPhysicalVolume* pv);
+    const std::vector<const G4VPhysicalVolume*>& GetTargetVolumes() const { return fTargets; }
+
+    void SetNtupleId(G4int id) { fNtupleId = id; }
+    G4int GetNtupleId() const { return fNtupleId; }
+
+    // Histogrammes de spectre pondéré (primaires / secondaires), cf. AnalysisManagerSetup
+    void SetSpectrumH1Ids(G4int primId, G4int secId) { fSpectrumH1Id[0] = primId; fSpectrumH1Id[1] = secId; }
+
+    void SetPolicy(const PlaneCrossingPolicy& p) { fPolicy = p; }
+    const PlaneCrossingPolicy& GetPolicy() const { return fPolicy; }
+    void SetPlusZOnly(G4bool b)      { fPolicy.plusZOnly = b; }
+    void SetFirstEntryOnly(G4bool b) { fPolicy.firstEntryOnly = b; }
+
+    // Statistiques
+    void PrintSummary() const;
+
+private:
+    // 1 à 5 cibles : une recherche linéaire sur des pointeurs bat tout conteneur associatif
+    inline G4bool IsTarget(const G4VPhysicalVolume* pv) const
+    {
+        return pv && std::find(fTargets.begin(), fTargets.end(), pv) != fTargets.end();
+    }
+
+    std::vector<const G4VPhysicalVolume*> fTargets;
+    PlaneCrossingPolicy fPolicy;
+    G4int fNtupleId = -1;  // ID du ntuple dans G4AnalysisManager
+    G4int fSpectrumH1Id[2] = {-1, -1};  // IDs des H1 de spectre (0 = primaires, 1 = secondaires)
+
+    PlaneCrossingSDMessenger* fMessenger = nullptr;
+
+    // Compteurs pour debug/statistiques
+    G4long fCntTotal = 0;      // total d'appels à ProcessHits
+    G4long fCntAccepted = 0;   // passages acceptés (lignes écrites)
+    G4double fWeightAccepted = 0.;   // Σ poids des passages acceptés (comptage non biaisé)
+    G4long fCntRejected = 0;   // passages rejetés (direction -Z ou latérale)
+
+    // Événements avec au moins un passage primaire accepté : drapeau par événement
+    // (remis à zéro dans Initialize), compteur incrémenté dans EndOfEvent
+    G4bool fPrimaryThisEvent = false;
+    G4long fEventsWithPrimary = 0;
+
+    // Traces déjà comptées dans l'événement courant (bitset réutilisé d'un événement à l'autre)
+    TrackIdSet fTracksThisEvent;
+
+    // Trace dont le dernier step est passé directement d'une cible à une autre (-1 : aucune)
+    G4int fTransferTrackID = -1;
+};
+
+#endif // PlaneCrossingSD_hh
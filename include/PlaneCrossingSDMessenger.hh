@@ -0,0 +1,26 @@
+#ifndef PlaneCrossingSDMessenger_h
+#define PlaneCrossingSDMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class PlaneCrossingSD;
+
+// Commandes /scoring/<nomSD>/plusZOnly et /scoring/<nomSD>/firstEntryOnly
+class PlaneCrossingSDMessenger : public G4UImessenger {
+public:
+    PlaneCrossingSDMessenger(PlaneCrossingSD* sd);
+    ~PlaneCrossingSDMessenger() override;
+
+    void SetNewValue(G4UIcommand*, G4String) override;
+
+private:
+    PlaneCrossingSD* fDetector;
+    G4UIdirectory* fDir;
+    G4UIcmdWithABool* fPlusZOnlyCmd;
+    G4UIcmdWithABool* fFirstEntryOnlyCmd;
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef PlanePrimaryCounterSD_hh
+#define PlanePrimaryCounterSD_hh 1
+
+#include "G4VSensitiveDetector.hh"
+#include "globals.hh"
+
+class G4Step;
+class G4TouchableHistory;
+class RunAction;
+
+/**
+ * @brief Compteurs ENTER/LEAVE des primaires sur les plans fantômes du monde parallèle
+ *
+ * En modes volume/virtual, ces compteurs sont remplis par le SteppingAction (rôles des
+ * volumes du monde de masse). En mode parallel, les plans n'existent que dans le monde
+ * fantôme : ce SD, ajouté à chaque plan par G4MultiSensitiveDetector, reçoit les steps
+ * fantômes de G4ParallelWorldProcess et alimente les mêmes accumulables du RunAction
+ * (RUN SUMMARY, critère /convergence/plane).
+ *  - ENTER : premier step dans le plan (pre-step sur une frontière fantôme)
+ *  - LEAVE : step qui s'arrête sur une frontière fantôme vers un autre volume
+ */
+class PlanePrimaryCounterSD : public G4VSensitiveDetector
+{
+public:
+    explicit PlanePrimaryCounterSD(const G4String& name);
+    ~PlanePrimaryCounterSD() override = default;
+
+    G4bool ProcessHits(G4Step* step, G4TouchableHistory*) override;
+
+private:
+    RunAction* fRunAction = nullptr;   // résolu au premier hit (thread courant)
+};
+
+#endif // PlanePrimaryCounterSD_hh
@@ -15,6 +15,7 @@ class PrimaryGeneratorAction0;
 class PrimaryGeneratorAction1;
 class PrimaryGeneratorAction2;
 class PrimaryGeneratorAction3;
+class PrimaryGeneratorAction4;
 class PrimaryGeneratorMessenger;
 
 class G4ParticleGun;
@@ -37,6 +38,7 @@ public:
     PrimaryGeneratorAction1*  GetAction1() { return fAction1; };
     PrimaryGeneratorAction2*  GetAction2() { return fAction2; };
     PrimaryGeneratorAction3*  GetAction3() { return fAction3; };
+    PrimaryGeneratorAction4*  GetAction4() { return fAction4; };
 
 private:
     G4ParticleGun *fParticleGun= nullptr;
@@ -45,6 +47,7 @@ private:
     PrimaryGeneratorAction1* fAction1 = nullptr;
     PrimaryGeneratorAction2* fAction2 = nullptr;
     PrimaryGeneratorAction3* fAction3 = nullptr;
+    PrimaryGeneratorAction4* fAction4 = nullptr;
 
     G4int fSelectedAction = 1;
 
@@ -4,6 +4,9 @@
 #include "G4VUserPrimaryGeneratorAction.hh"
 #include "globals.hh"
 #include "G4ThreeVector.hh"
+#include "G4SystemOfUnits.hh"
+#include "SpectrumSampler.hh"
+#include "VoxelOccupancySampler.hh"
 #include <vector>
 
 class G4ParticleGun;
@@ -23,28 +26,43 @@ class PrimaryGeneratorAction2
    void GeneratePrimaries(G4Event*);
 
   public:
-    G4double RejectAccept();
-    G4double InverseCumul();
-    
     // =====================================================
     // NOUVEAU : Méthode pour générer une position aléatoire
     //           dans le volume de l'anode (source volumique)
     // =====================================================
     G4ThreeVector GeneratePositionInAnode();
     
+    // Spectre en énergie : fichier texte / CSV (E_keV intensité), ou "builtin" (Mini-X intégré)
+    // Table partagée entre threads, cache binaire sur disque (cf. SpectrumSampler::FromFile)
+    void SetSpectrumFile(const G4String& path);
+
     // Active/désactive le mode source volumique
     void SetVolumeSourceMode(G4bool mode) { fUseVolumeSource = mode; }
     G4bool GetVolumeSourceMode() const { return fUseVolumeSource; }
 
+    // =====================================================
+    // Biaisage de la direction d'émission (/primariesgenerator/bias/...)
+    //  - kBiasCone     : directions tirées dans un cône (axe, demi-angle) vers la sortie
+    //                    du collimateur, mélangé à une fraction "défensive" de tirages analogues
+    //  - kBiasCosTheta : carte d'importance en cos(alpha), N bins égaux sur le cône source
+    // Le primaire porte le poids p_source / q_biaisée (poids du vertex), hérité par les
+    // secondaires : toutes les grandeurs pondérées restent non biaisées.
+    // =====================================================
+    enum BiasMode { kBiasNone = 0, kBiasCone, kBiasCosTheta };
+
+    void SetBiasMode(BiasMode mode);
+    void SetBiasConeAxis(const G4ThreeVector& axis);
+    void SetBiasConeHalfAngle(G4double halfAngle);
+    void SetBiasDefensiveFraction(G4double fraction);
+    void SetCosThetaImportance(const std::vector<G4double>& importance);
+    BiasMode GetBiasMode() const { return fBiasMode; }
+
   private:
     G4ParticleGun*         fParticleGun = nullptr;
 
-    G4int                  fNPoints = 0; //nb of points
     std::vector<G4double>  fX;           //abscisses X
     std::vector<G4double>  fY;           //values of Y(X)
-    std::vector<G4double>  fSlp;         //slopes
-    std::vector<G4double>  fYC;          //cumulative function of Y
-    G4double               fYmax = 0.;   //max(Y)
+    const SpectrumSampler* fSpectrum = nullptr;   //table d'alias partagée, spectre tronqué à kEcut
 
     G4double fCosAlphaMin = 0., fCosAlphaMax = 0.;      //solid angle
     G4double fPsiMin = 0., fPsiMax = 0.;
@@ -67,10 +85,30 @@ class PrimaryGeneratorAction2
     
     // Flag pour initialisation
     G4bool fAnodeInitialized = false;
+
+    // Grille d'occupation de (anode ∩ boîte), construite dans InitializeAnodeVolume :
+    // tirage à coût constant, Inside() seulement dans les voxels partiels
+    VoxelOccupancySampler fAnodeVoxels;
     
     // Méthode d'initialisation du volume source
     void InitializeAnodeVolume();
 
+    // =====================================================
+    // Biaisage de la direction
+    // =====================================================
+    BiasMode      fBiasMode = kBiasNone;
+    G4ThreeVector fBiasAxis = G4ThreeVector(0., 0., 1.);
+    G4double      fBiasHalfAngle = 6.*CLHEP::deg;   // demandé (/primariesgenerator/bias/coneHalfAngle)
+    G4double      fBiasCosHalfAngle = 1.;           // effectif, cône biaisé borné au cône source
+    G4double      fBiasDefensive = 0.;        // fraction de tirages dans le cône source complet
+    std::vector<G4double> fCosImportance;     // importance par bin de cos(alpha) (bin 0 : cos le plus faible)
+    std::vector<G4double> fCosImportanceCumul;
+
+    // Direction selon le mode de biaisage ; weight = p_source(u) / q(u)
+    G4ThreeVector SampleDirection(G4double& weight);
+    void UpdateBiasCone();
+    void PrintBiasSettings() const;
+
   private:
     void InitFunction();
 };
@@ -0,0 +1,78 @@
+#ifndef PrimaryGeneratorAction4_h
+#define PrimaryGeneratorAction4_h
+
+#include "G4VUserPrimaryGeneratorAction.hh"
+#include "globals.hh"
+#include "PhaseSpaceRecord.hh"
+
+#include <cstdint>
+#include <vector>
+
+class G4ParticleGun;
+class G4ParticleDefinition;
+class G4Event;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+// =====================================================
+// Source 4 : relecture d'un espace des phases (étape 2, /primariesgenerator/phasespace/...)
+//  - fichiers .psf écrits par PhaseSpaceWriter, projetés en mémoire (mmap, lecture séquentielle)
+//  - une particule du fichier par événement, avec son poids
+//  - recyclage : chaque particule est rejouée N fois (poids / N) dans le même événement
+//    (N vertex), avec une rotation aléatoire autour de l'axe z si randomRotation (source
+//    et collimateur axisymétriques) ; les copies corrélées restent une seule histoire
+//    pour l'incertitude histoire par histoire
+//  - en MT, chaque thread relit sa propre plage [begin, end) des particules (fichiers mis
+//    bout à bout) et reboucle dans cette plage, avec un avertissement à la première reprise
+// =====================================================
+class PrimaryGeneratorAction4
+{
+  public:
+    PrimaryGeneratorAction4(G4ParticleGun*);
+   ~PrimaryGeneratorAction4();
+
+  public:
+    void GeneratePrimaries(G4Event*);
+
+    // Liste de fichiers séparés par des espaces (ex. les fichiers _t0.psf _t1.psf d'un run MT)
+    void SetFiles(const G4String& fileList);
+    void SetRecycling(G4int n) { fRecycle = (n > 0) ? n : 1; }
+    void SetRandomRotation(G4bool on) { fRandomRotation = on; }
+
+  private:
+    struct MappedFile {
+        void*                       base = nullptr;
+        std::size_t                 size = 0;
+        const PhaseSpaceIO::Record* records = nullptr;
+        std::uint64_t               nRecords = 0;
+        std::uint64_t               nHistories = 0;
+    };
+
+    G4bool OpenFiles();
+    void   CloseFiles();
+    void   Seek(std::uint64_t index);
+    void   Advance();
+
+    std::vector<G4String>   fFileNames;
+    std::vector<MappedFile> fFiles;
+    G4bool                  fOpened = false;
+    std::uint64_t           fTotalRecords = 0;
+
+    std::uint64_t fBegin = 0;      // plage du thread, en indice global (fichiers bout à bout)
+    std::uint64_t fEnd = 0;
+    std::uint64_t fCursor = 0;     // position courante : indice global, fichier, particule dans le fichier
+    std::size_t   fFileIdx = 0;
+    std::uint64_t fRecordIdx = 0;
+    G4int         fRecycle = 1;
+    G4bool        fRandomRotation = true;
+    G4bool        fWrapped = false;
+
+    G4int                 fLastPdg = 0;
+    G4ParticleDefinition* fLastParticle = nullptr;
+
+    G4ParticleGun*  fParticleGun = nullptr;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -7,6 +7,11 @@
 class PrimaryGeneratorAction;
 class G4UIdirectory;
 class G4UIcmdWithAnInteger;
+class G4UIcmdWithAString;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWith3Vector;
+class G4UIcmdWithABool;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -23,6 +28,21 @@ class PrimaryGeneratorMessenger: public G4UImessenger
 
     G4UIdirectory*        fDirGenerator = nullptr;;
     G4UIcmdWithAnInteger* fSelectActionCmd = nullptr;
+    G4UIcmdWithAString*   fSpectrumFileCmd = nullptr;
+
+    // Biaisage de la direction (source 2, PrimaryGeneratorAction2)
+    G4UIdirectory*             fDirBias = nullptr;
+    G4UIcmdWithAString*        fBiasModeCmd = nullptr;
+    G4UIcmdWith3Vector*        fBiasAxisCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* fBiasHalfAngleCmd = nullptr;
+    G4UIcmdWithADouble*        fBiasDefensiveCmd = nullptr;
+    G4UIcmdWithAString*        fBiasCosImportanceCmd = nullptr;
+
+    // Relecture d'un espace des phases (source 4, PrimaryGeneratorAction4)
+    G4UIdirectory*        fDirPhaseSpace = nullptr;
+    G4UIcmdWithAString*   fPhaseSpaceFileCmd = nullptr;
+    G4UIcmdWithAnInteger* fPhaseSpaceRecycleCmd = nullptr;
+    G4UIcmdWithABool*     fPhaseSpaceRotationCmd = nullptr;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,67 @@
+#ifndef PRIMARYLOSSTABLE_HH
+#define PRIMARYLOSSTABLE_HH
+
+#include "ArrayAccumulable.hh"
+#include "G4Material.hh"
+#include "G4VProcess.hh"
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+#include <algorithm>
+#include <vector>
+
+class G4AccumulableManager;
+
+// =====================================================
+// [LOSS] Bilan des primaires perdus avant z = 60 mm
+// Compteurs denses (processus × matériau × bin d'énergie), un tableau par thread,
+// fusionnés par G4AccumulableManager en fin de run (remplace gLostByProc / gLostByMat).
+//
+//  - processus : sous-type entier (GetProcessSubType) -> slot compact, table
+//                construite au début du run depuis le G4ProcessTable du thread
+//  - matériau  : G4Material::GetIndex()
+//  - énergie   : énergie cinétique pre-step, bins de 5 keV de 0 à 60 keV
+// =====================================================
+class PrimaryLossTable
+{
+public:
+    static const G4int kNbProcSlots = 32;   // slot 0 = inconnu / autre
+    static const G4int kNbMatSlots  = 64;   // dernier slot = inconnu / autre
+    static const G4int kNbEBins     = 12;   // dernier bin = débordement
+    static constexpr G4double kEBinWidth = 5.0*keV;
+
+    PrimaryLossTable();
+
+    void Register(G4AccumulableManager* accMgr);
+
+    // À appeler sur chaque thread au début du run (tables de processus par thread)
+    void BuildProcessSlots();
+
+    inline void Count(const G4VProcess* proc, const G4Material* mat, G4double ekin)
+    {
+        const G4int sub = proc ? proc->GetProcessSubType() : -1;
+        const G4int p = (sub >= 0 && sub < static_cast<G4int>(fSlotBySubType.size()))
+                        ? fSlotBySubType[sub] : 0;
+        const G4int m = mat ? std::min(static_cast<G4int>(mat->GetIndex()), kNbMatSlots - 1)
+                            : kNbMatSlots - 1;
+        const G4int e = std::min(static_cast<G4int>(ekin / kEBinWidth), kNbEBins - 1);
+        ++fCounts[Index(p, m, std::max(0, e))];
+    }
+
+    // Résumé [LOSS][BY-PROC] / [BY-MAT] / [BY-E] / détail énergie (master, après Merge)
+    void Print() const;
+
+private:
+    static inline std::size_t Index(G4int p, G4int m, G4int e)
+    {
+        return (static_cast<std::size_t>(p) * kNbMatSlots + m) * kNbEBins + e;
+    }
+
+    static const G4int kMaxSubType = 1024;
+
+    ArrayAccumulable<G4long> fCounts;
+    std::vector<G4int>    fSlotBySubType;   // sous-type -> slot
+    std::vector<G4String> fSlotNames;       // slot -> nom du (premier) processus
+};
+
+#endif
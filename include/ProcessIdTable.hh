@@ -0,0 +1,48 @@
+#ifndef PROCESSIDTABLE_HH
+#define PROCESSIDTABLE_HH
+
+#include "globals.hh"
+
+#include <cstdint>
+#include <vector>
+
+class G4VProcess;
+
+// =====================================================
+// Table d'internement des noms de processus (run-wide)
+// Construite une fois, après l'initialisation de la physique, à partir du
+// G4ProcessTable : noms triés -> identifiant entier compact (uint16).
+// Les mêmes identifiants sont donc valables sur tous les threads.
+//
+// Chaque thread garde un cache pointeur de processus -> identifiant, rempli au
+// premier appel : les SD et le tracking n'ont plus à copier de G4String par hit.
+// Le dictionnaire (processus -> id, PDG -> particule) est écrit une seule fois
+// dans le fichier de sortie (ntuple "dictionary").
+// =====================================================
+class ProcessIdTable
+{
+public:
+    using Id = std::uint16_t;
+
+    static const Id kPrimaryId = 0;   // pas de processus créateur (primaire)
+    static const Id kUnknownId = 1;   // processus absent de la table
+
+    // Construit la table (sans effet si déjà construite) — master, BeginOfRunAction
+    static void Build();
+
+    // Identifiant d'un processus (nullptr -> kPrimaryId)
+    static Id GetId(const G4VProcess* proc);
+
+    static const G4String& GetName(G4int id);
+    static G4int Size() { return static_cast<G4int>(fNames.size()); }
+
+    // Remplit l'ntuple dictionnaire : kind (0 = processus, 1 = particule), id, name
+    static void FillDictionaryNtuple(G4int ntupleId);
+
+private:
+    static Id LookupSlow(const G4VProcess* proc);
+
+    static std::vector<G4String> fNames;   // index = identifiant
+};
+
+#endif
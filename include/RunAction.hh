@@ -7,15 +7,23 @@
 #include "G4AnalysisManager.hh"
 #include "G4Accumulable.hh"
 #include "G4AccumulableManager.hh"
-
+#include "PrimaryLossTable.hh"
+#include "DoseMesh.hh"
+#include "ConvergenceMonitor.hh"
+#include "ArrayAccumulable.hh"
+#include "VolumeRoleRegistry.hh"
+#include "G4Timer.hh"
+#include "G4Step.hh"
+#include "G4VTouchable.hh"
+#include "G4NavigationHistory.hh"
+
+#include <algorithm>
 #include <vector>
-#include <map>
 #include <fstream>
 
 class G4Run;
 class G4Event;
 class RunMessenger;
-class SphereHit;
 class EventAction;
 
 class RunAction : public G4UserRunAction
@@ -36,9 +44,6 @@ class RunAction : public G4UserRunAction
 
         void UpdateFromEvent(const EventAction* event);
 
-        // Ajoute les hits d’un événement
-        void AddHitsForEvent(G4int eventID, const std::vector<SphereHit>& hits);
-
         G4int GetTotalEntrantInBe() const;
         G4int GetTotalInteractedInBe() const;
         G4int GetTotalEntrantInWaterSphere() const;
@@ -74,6 +79,9 @@ class RunAction : public G4UserRunAction
         
         // Ajouter l'énergie déposée d'un événement
         void AddEdepFromEvent(const G4double* edepRing, G4double edepTotal);
+
+        // Idem pour l'estimateur par longueur de trace (/stepping/trackLengthEstimator)
+        void AddTrackLengthFromEvent(const G4double* tleRing, G4double tleTotal);
         
         // Accesseurs pour les énergies accumulées
         G4double GetTotalEdepRing(G4int ringIndex) const;
@@ -82,9 +90,57 @@ class RunAction : public G4UserRunAction
         // Pour les histogrammes par 10000 événements
         void CheckAndFillDoseHistograms(G4int eventID);
         
-        // Compteur de photons transmis (mis à jour depuis SurfaceSpectrumSD)
-        void AddTransmittedPhoton() { fTransmitted10000++; fTransmittedTotal++; }
+        // Compteur de photons transmis (mis à jour depuis SurfaceSpectrumSD) : nombre brut et Σ poids
+        void AddTransmittedPhoton(G4double weight)
+        {
+            fTransmitted10000++; fTransmittedTotal++;
+            fTransmittedWeight10000 += weight; fTransmittedWeightTotal += weight;
+        }
         G4long GetTransmittedTotal() const { return fTransmittedTotal; }
+        G4double GetTransmittedWeightTotal() const { return fTransmittedWeightTotal; }
+
+        // [LOSS] Bilan des primaires perdus avant z=60 mm (rempli par SteppingAction)
+        PrimaryLossTable* GetLossTable() { return &fLossTable; }
+        DoseMesh* GetDoseMesh() { return &fDoseMesh; }
+
+        // Primaires entrant / sortant de chaque plan de scoring (planeIndex du registre des rôles) :
+        // nombre brut et Σw, Σw² (poids de biaisage, transmission non biaisée)
+        void CountPlanePrimEnter(G4int plane, G4double weight)
+        {
+            ++fPlanePrimCrossings[2*plane];
+            fPlanePrimWeights[4*plane]     += weight;
+            fPlanePrimWeights[4*plane + 1] += weight * weight;
+        }
+        void CountPlanePrimLeave(G4int plane, G4double weight)
+        {
+            ++fPlanePrimCrossings[2*plane + 1];
+            fPlanePrimWeights[4*plane + 2] += weight;
+            fPlanePrimWeights[4*plane + 3] += weight * weight;
+        }
+
+        // ==================== Profil en profondeur dans les couronnes d'eau ====================
+        static const G4int kNbDepthBins = 30;   // 0.1 mm pour 3 mm d'eau
+
+        // Dépôt d'un step dans la couronne ringIndex (keV × poids), placé au milieu du
+        // segment pre -> post (aucun tirage aléatoire : la séquence des runs existants est
+        // inchangée) ; profondeur = z local de la couronne + demi-épaisseur
+        // (sans tranches de géométrie ni limitation de pas). Appelé par SteppingAction
+        // (couronnes dans le monde de masse) ou WaterRingDoseSD (monde parallèle).
+        inline void AddDepthEdep(G4int ringIndex, const G4Step* step)
+        {
+            const G4StepPoint* pre = step->GetPreStepPoint();
+            const G4ThreeVector& p0 = pre->GetPosition();
+            const G4ThreeVector p = p0 + 0.5 * (step->GetPostStepPoint()->GetPosition() - p0);
+            const G4double localZ = pre->GetTouchable()->GetHistory()->GetTopTransform().TransformPoint(p).z();
+
+            G4int bin = static_cast<G4int>((localZ + fDepthHalfZ) * fDepthInvWidth);
+            bin = std::min(std::max(bin, 0), kNbDepthBins - 1);
+            fDepthEdep[ringIndex * kNbDepthBins + bin] +=
+                step->GetTotalEnergyDeposit() / CLHEP::keV * pre->GetWeight();
+        }
+
+        // Fin d'événement (EventAction, après AddEdepFromEvent) : arrêt sur incertitude cible
+        void CheckConvergence() { fConvergence.EndOfEvent(fDoseSums, fPlanePrimWeights); }
 
     private:
 
@@ -102,9 +158,6 @@ class RunAction : public G4UserRunAction
         G4Accumulable<G4int> fTotalEntrantInWaterSphere;
         G4Accumulable<G4int> fTotalInteractedInWaterSphere;
 
-        //Ajoute : stockage des hits par événement
-        std::map<G4int, std::vector<SphereHit>> fHitsByEvent;
-
         // ← mutable pour autoriser l’incrément depuis une méthode const
         mutable G4Accumulable<G4long> fPrimariesGenerated;
 
@@ -120,6 +173,44 @@ class RunAction : public G4UserRunAction
         // Compteur de photons transmis par lot de 10000 événements
         G4long fTransmitted10000 = 0;
         G4long fTransmittedTotal = 0;
+        G4double fTransmittedWeight10000 = 0.;
+        G4double fTransmittedWeightTotal = 0.;
+
+        // [LOSS] Compteurs processus × matériau × énergie, fusionnés par G4AccumulableManager
+        PrimaryLossTable fLossTable;
+
+        // Grille de dose 3D (par thread, fusionnée en fin de run)
+        DoseMesh fDoseMesh;
+
+        // [2*plan] = ENTER, [2*plan+1] = LEAVE (primaires uniquement)
+        ArrayAccumulable<G4long> fPlanePrimCrossings{"PlanePrimCrossings",
+                                                     2 * VolumeRoleRegistry::kNbScorePlanes};
+        // [4*plan] = Σw ENTER, [4*plan+1] = Σw² ENTER, [4*plan+2] = Σw LEAVE, [4*plan+3] = Σw² LEAVE
+        ArrayAccumulable<G4double> fPlanePrimWeights{"PlanePrimWeights",
+                                                     4 * VolumeRoleRegistry::kNbScorePlanes};
+
+        // ==================== Incertitude statistique de la dose (histoire par histoire) ====================
+        // Région k = 0..4 : anneaux, k = kNbWaterRings : eau totale
+        // [2*k] = Σ Edep_evt (keV), [2*k+1] = Σ Edep_evt² (keV²)
+        static const G4int kNbDoseRegions = kNbWaterRings + 1;
+        ArrayAccumulable<G4double> fDoseSums{"DoseSums", 2 * kNbDoseRegions};
+        ArrayAccumulable<G4double> fTleSums{"TrackLengthDoseSums", 2 * kNbDoseRegions};   // même indexation
+        G4Timer fRunTimer;   // temps réel du run (master), pour l'efficacité 1/(R²·T)
+        static_assert(kNbDoseRegions == ConvergenceMonitor::kNbDoseRegions, "régions de dose incohérentes");
+
+        // [ring * kNbDepthBins + bin] = Σ Edep (keV × poids) ; binning fixé en BeginOfRunAction
+        ArrayAccumulable<G4double> fDepthEdep{"DepthEdep", kNbWaterRings * kNbDepthBins};
+        G4double fDepthHalfZ = 1.5 * CLHEP::mm;
+        G4double fDepthInvWidth = kNbDepthBins / (3. * CLHEP::mm);
+        void WriteDepthProfile() const;
+
+        // Arrêt du run sur incertitude cible / budget de temps (/convergence/...)
+        ConvergenceMonitor fConvergence;
+
+        // RUN SUMMARY + ntuple "dose_stats" (master, après Merge)
+        // estimator : 0 = dépôt analogique (fDoseSums), 1 = longueur de trace (fTleSums)
+        void ReportDoseStatistics(const ArrayAccumulable<G4double>& sums, G4int estimator,
+                                  G4long nEvents, G4double time_s);
 
 };
 #endif
@@ -0,0 +1,53 @@
+#ifndef SCORINGPARALLELWORLD_HH
+#define SCORINGPARALLELWORLD_HH
+
+#include "G4VUserParallelWorld.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class DetectorConstruction;
+
+// =====================================================
+// Monde parallèle de scoring (/detector/scoringMode parallel)
+// Contient uniquement des volumes fantômes (matériau nul, monde non "layered") :
+//  - les plans de comptage logicScorePlane / 2 / 3 / 5 (mêmes noms, mêmes z et dimensions
+//    que les boîtes du mode "volume", décrits par DetectorConstruction::GetScoringPlanes())
+//  - les 5 couronnes logicWaterRing0..4, superposées au disque d'eau unique du monde de masse
+// Le monde de masse n'est donc plus fragmenté par le scoring : pas de frontières
+// ni de G4UserLimits supplémentaires pour la navigation physique.
+//
+// Les SD sont créés par DetectorConstruction::ConstructSDandField() (noms, ntuples, règles
+// d'acceptation) puis attachés ici aux volumes fantômes. Ce qui dépend des rôles plan /
+// couronne dans le SteppingAction est repris par des SD fantômes, sur les mêmes compteurs :
+//  - plans : PlanePrimaryCounterSD (ENTER/LEAVE des primaires, critère /convergence/plane)
+//  - couronnes : WaterRingDoseSD (dépôt d'énergie, profil en profondeur, longueur de trace)
+// =====================================================
+class ScoringParallelWorld : public G4VUserParallelWorld
+{
+public:
+    static constexpr const char* kWorldName = "ScoringWorld";
+
+    ScoringParallelWorld(const G4String& worldName, DetectorConstruction* detector);
+    ~ScoringParallelWorld() override = default;
+
+    void Construct() override;
+    void ConstructSD() override;
+
+private:
+    DetectorConstruction* fDetector = nullptr;
+
+    struct GhostPlane {
+        G4String           sdName;
+        G4LogicalVolume*   logical  = nullptr;
+        G4VPhysicalVolume* physical = nullptr;
+    };
+    std::vector<GhostPlane> fPlanes;
+
+    std::vector<G4LogicalVolume*>   fRingLVs;
+    std::vector<G4VPhysicalVolume*> fRingPVs;
+};
+
+#endif
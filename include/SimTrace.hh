@@ -0,0 +1,37 @@
+#ifndef SIMTRACE_HH
+#define SIMTRACE_HH
+
+// =====================================================
+// Niveaux de trace éliminés à la compilation
+//
+// SIM_TRACE_MAX_LEVEL (défini par CMake, option SIM_TRACE_LEVEL) :
+//   0 : aucune trace compilée (cible sim_fast) — les blocs de diagnostic
+//       deviennent des conditions constantes fausses, supprimées par le compilateur
+//   1 : traces "verbose 1" + traces échantillonnées (N premiers passages)
+//   2 : toutes les traces (défaut, comportement historique)
+//
+// Usage :
+//   if (SIM_TRACE(fSteppingVerboseLevel, 1)) { ... }   // remplace "fSteppingVerboseLevel == 1"
+//   if (SIM_TRACE_SAMPLED()) { static G4ThreadLocal int seen = 0; ... } // blocs "N premiers passages"
+//   (compteurs G4ThreadLocal : un plafond par thread, sans course entre workers)
+// =====================================================
+
+#ifndef SIM_TRACE_MAX_LEVEL
+#define SIM_TRACE_MAX_LEVEL 2
+#endif
+
+namespace SimTrace
+{
+    constexpr int kMaxLevel = SIM_TRACE_MAX_LEVEL;
+
+    // Vrai si le niveau est compilé dans ce binaire
+    constexpr bool Compiled(int level) { return level <= kMaxLevel; }
+}
+
+// Niveau compilé ET égal au niveau courant (sémantique historique "verbose == N")
+#define SIM_TRACE(current, level) (SimTrace::Compiled(level) && (current) == (level))
+
+// Blocs de diagnostic échantillonnés (compteurs "static G4ThreadLocal int seen")
+#define SIM_TRACE_SAMPLED() (SimTrace::Compiled(1))
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef SPECTRUMSAMPLER_HH
+#define SPECTRUMSAMPLER_HH
+
+#include "globals.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// =====================================================
+// Tirage en O(1) d'un spectre tabulé linéaire par morceaux (source 2)
+//  - construit une fois : troncature sous xCut (point interpolé ajouté à xCut),
+//    aire de chaque segment, table d'alias de Walker (méthode de Vose) sur les segments
+//  - tirage exact, sans rejet ni recherche ni sqrt : segment par la table d'alias,
+//    puis densité linéaire dans le segment comme mélange des lois 2t et 2(1-t),
+//    tirées par max(u1,u2) et min(u1,u2)
+//  - tables partagées en lecture seule entre threads (registre global, jamais détruites
+//    avant la fin) : FromTable pour un spectre en mémoire, FromFile pour un fichier
+//    texte / CSV (E en keV, intensité), prétraité une fois dans un cache binaire
+//    <fichier>.<hash>.spt (hash FNV-1a du contenu et de la coupure) ; un cache tronqué
+//    ou incohérent (alias >= nSegments, keep hors [0,1]) est ignoré et réécrit
+// =====================================================
+class SpectrumSampler
+{
+public:
+    SpectrumSampler() = default;
+
+    // Table partagée construite au premier appel pour cette clé (x, y en unités Geant4)
+    static const SpectrumSampler* FromTable(const G4String& key, const std::vector<G4double>& x,
+                                            const std::vector<G4double>& y, G4double xCut);
+    // Table partagée d'un fichier spectre ; nullptr si illisible ou vide
+    static const SpectrumSampler* FromFile(const G4String& path, G4double xCut);
+
+    // x croissants, y >= 0 ; seule la partie x > xCut est conservée. false si spectre vide
+    G4bool Build(const std::vector<G4double>& x, const std::vector<G4double>& y, G4double xCut = 0.);
+
+    G4bool IsValid() const { return !fSegments.empty(); }
+
+    inline G4double Sample() const
+    {
+        const std::size_t n = fSegments.size();
+        const G4double u = G4UniformRand() * static_cast<G4double>(n);
+        std::size_t j = static_cast<std::size_t>(u);
+        if (j >= n) j = n - 1;
+        const Segment& s = fSegments[(u - static_cast<G4double>(j) < fSegments[j].keep) ? j : fSegments[j].alias];
+
+        const G4double u1 = G4UniformRand(), u2 = G4UniformRand();
+        const G4double t = (G4UniformRand() < s.upFraction) ? std::max(u1, u2) : std::min(u1, u2);
+        return s.x0 + t * s.dx;
+    }
+
+    // Moments exacts du spectre tronqué (contrôle de la construction)
+    G4double GetMean() const { return fMean; }
+    G4double GetRms() const { return fRms; }
+    G4double GetXmin() const { return IsValid() ? fSegments.front().x0 : 0.; }
+    G4double GetXmax() const { return IsValid() ? fSegments.back().x0 + fSegments.back().dx : 0.; }
+    std::size_t GetNbSegments() const { return fSegments.size(); }
+
+private:
+    G4bool ReadCache(const std::string& fileName, std::uint64_t hash);
+    void   WriteCache(const std::string& fileName, std::uint64_t hash) const;
+    void   Print(const G4String& label) const;
+
+    struct Segment {
+        G4double      x0 = 0.;
+        G4double      dx = 0.;
+        G4double      upFraction = 0.5;   // y1 / (y0 + y1) : poids de la composante croissante
+        G4double      keep = 1.;          // seuil d'alias : garder ce segment si frac(u) < keep
+        std::uint32_t alias = 0;
+    };
+
+    std::vector<Segment> fSegments;
+    G4double fMean = 0.;
+    G4double fRms = 0.;
+};
+
+#endif
@@ -6,9 +6,16 @@
 #include "G4Threading.hh"
 #include "G4Allocator.hh"
 #include "G4ThreeVector.hh"
+#include "G4SystemOfUnits.hh"
 #include "globals.hh"
 
+#include "SphereHitRecord.hh"
+
+class G4VPhysicalVolume;
+
 // Hit élémentaire enregistré par SphereSurfaceSD
+// Données stockées dans un enregistrement POD de taille fixe (SphereHitIO::Record,
+// identifiants au lieu de chaînes / pointeurs), transmis tel quel à SphereHitSink.
 class SphereHit : public G4VHit {
 public:
     SphereHit();
@@ -20,44 +27,53 @@ public:
     G4bool operator==(const SphereHit&) const;
 
     //  Identifiants de contexte
-    void SetEventID(G4int id) { fEventID = id; };
-    G4int GetEventID() const { return fEventID; };
+    void SetEventID(G4int id) { fData.eventID = id; };
+    G4int GetEventID() const { return fData.eventID; };
 
-    void SetTrackID(G4int track) {fTrackID = track;};
-    G4int GetTrackID() const { return fTrackID;};
+    void SetTrackID(G4int track) { fData.trackID = track; };
+    G4int GetTrackID() const { return fData.trackID; };
 
-    // Géométrie & énergie
-    void SetPosition(const G4ThreeVector& pos) { fPosition = pos; }
-    G4ThreeVector GetPosition() const{ return fPosition;}
+    // Géométrie & énergie (unités Geant4 en entrée / sortie, stockage mm / keV / ns)
+    void SetPosition(const G4ThreeVector& pos) {
+        fData.pos_mm[0] = static_cast<float>(pos.x()/mm);
+        fData.pos_mm[1] = static_cast<float>(pos.y()/mm);
+        fData.pos_mm[2] = static_cast<float>(pos.z()/mm);
+    }
+    G4ThreeVector GetPosition() const {
+        return G4ThreeVector(fData.pos_mm[0]*mm, fData.pos_mm[1]*mm, fData.pos_mm[2]*mm);
+    }
 
-    void SetEnergy(G4double e) { fEnergy = e; }
-    G4double GetEnergy() const { return fEnergy; }
+    void SetEnergy(G4double e) { fData.ekin_keV = static_cast<float>(e/keV); }
+    G4double GetEnergy() const { return fData.ekin_keV*keV; }
 
-    void SetEdep(G4double edep) {fEdep = edep;};
-    G4double GetEdep() const{ return fEdep;}
+    void SetEdep(G4double edep) { fData.edep_keV = static_cast<float>(edep/keV); };
+    G4double GetEdep() const { return fData.edep_keV*keV; }
 
-    void SetTime(G4double time) {fTime = time;};
-    G4double GetTime() const{ return fTime;}
+    void SetTime(G4double time) { fData.time_ns = static_cast<float>(time/ns); };
+    G4double GetTime() const { return fData.time_ns*ns; }
 
-    // Contexte particule & volume
-    void SetParticleName(const G4String& name) {fParticleName = name;};
-    G4String GetParticleName() const{ return fParticleName;}
-
-    void SetVolumeName(const G4String& name) {fVolumeName = name;};
-    G4String GetVolumeName() const{ return fVolumeName;}
+    // Contexte volume : InstanceID du volume logique, nom résolu seulement à l'affichage
+    void SetVolume(const G4VPhysicalVolume* pv);
+    G4int GetVolumeId() const { return fData.volumeId; }
+    G4String GetVolumeName() const;
 
     // Identifiant particule & processus du step ---
-    void    SetPDG(G4int v)                 { fPDG = v; }
-    G4int   GetPDG()                  const { return fPDG; }
+    void    SetPDG(G4int v)                 { fData.pdg = v; }
+    G4int   GetPDG()                  const { return fData.pdg; }
+
+    // Processus : identifiant interné (ProcessIdTable), nom résolu à la demande
+    void    SetProcessId(G4int id)            { fData.processId = static_cast<std::uint16_t>(id); }
+    G4int   GetProcessId()              const { return fData.processId; }
+    const G4String& GetProcessName()    const;
 
-    void          SetProcessName(const G4String& s)  { fProcessName = s; }
-    const G4String& GetProcessName()           const { return fProcessName; }
+    void    SetProcessType(G4int v)           { fData.processType = static_cast<std::int16_t>(v); }   // enum G4ProcessType
+    G4int   GetProcessType()            const { return fData.processType; }
 
-    void    SetProcessType(G4int v)           { fProcessType = v; }   // enum G4ProcessType
-    G4int   GetProcessType()            const { return fProcessType; }
+    void    SetProcessSubType(G4int v)        { fData.processSubType = static_cast<std::int16_t>(v); } // e.g. G4EmProcessSubType
+    G4int   GetProcessSubType()         const { return fData.processSubType; }
 
-    void    SetProcessSubType(G4int v)        { fProcessSubType = v; } // e.g. G4EmProcessSubType
-    G4int   GetProcessSubType()         const { return fProcessSubType; }
+    // Enregistrement brut (écriture par SphereHitSink)
+    const SphereHitIO::Record& GetRecord() const { return fData; }
 
 
     // Allocateur thread-local (convention Geant4)
@@ -70,24 +86,7 @@ public:
 
 private:
 
-    G4int fEventID = -1;
-    G4int fTrackID = -1;
-
-    // Kinematics & space
-    G4ThreeVector fPosition;    // mm
-    G4double fEnergy;           // kinetic energy (MeV or internal units)
-    G4double fTime;             // global time (ns)
-    G4double fEdep;             // deposited energy (MeV or internal units)
-
-    // Context
-    G4String fParticleName;
-    G4String fVolumeName;
-
-    // Particle & process identifiers
-    G4int         fPDG           = 0;      // PDG code (e.g. 11, 22, ...)
-    G4String      fProcessName;            // e.g. "eIoni", "eBrem", "compt"
-    G4int         fProcessType   = -1;     // enum G4ProcessType
-    G4int         fProcessSubType= -1;     // e.g. G4EmProcessSubType
+    SphereHitIO::Record fData;   // 44 octets, cf. SphereHitRecord.hh
 };
 
 using SphereHitsCollection = G4THitsCollection<SphereHit>;
@@ -0,0 +1,53 @@
+#ifndef SPHEREHITRECORD_HH
+#define SPHEREHITRECORD_HH
+
+// =====================================================
+// Disposition compacte d'un SphereHit et format du fichier de hits
+// (écrit par SphereHitSink ; sans dépendance Geant4, comme StepTraceRecord.hh)
+//
+// Fichier :
+//   FileHeader
+//   nVolumes x { uint32 volumeId ; uint16 nameLength ; char name[nameLength] }
+//   Record, Record, ... jusqu'à la fin du fichier
+//
+// Processus : identifiants ProcessIdTable (noms dans l'ntuple "dictionary" du fichier ROOT)
+// =====================================================
+
+#include <cstdint>
+#include <type_traits>
+
+namespace SphereHitIO
+{
+    constexpr char          kMagic[8] = {'S', 'P', 'H', 'E', 'R', 'E', 'H', 'T'};
+    constexpr std::uint32_t kVersion  = 1;
+
+    struct FileHeader
+    {
+        char          magic[8];
+        std::uint32_t version;
+        std::uint32_t recordSize;   // sizeof(Record), contrôle de cohérence au décodage
+        std::uint32_t nVolumes;     // entrées du dictionnaire de volumes qui suivent
+        std::int32_t  threadId;     // -1 en séquentiel
+    };
+
+    // Un hit : 44 octets, position en mm, énergies en keV, temps en ns
+    struct Record
+    {
+        std::int32_t  eventID;
+        std::int32_t  trackID;
+        std::int32_t  pdg;
+        std::int16_t  volumeId;        // InstanceID du volume logique, -1 si inconnu
+        std::uint16_t processId;       // ProcessIdTable (1 = inconnu)
+        std::int16_t  processType;     // enum G4ProcessType, -1 si aucun
+        std::int16_t  processSubType;  // ex. G4EmProcessSubType, -1 si aucun
+        float         pos_mm[3];
+        float         ekin_keV;        // énergie cinétique au post-step
+        float         edep_keV;
+        float         time_ns;         // temps global au pre-step
+    };
+
+    static_assert(sizeof(Record) == 44, "SphereHitIO::Record doit rester compact (44 octets)");
+    static_assert(std::is_trivially_copyable<Record>::value, "SphereHitIO::Record doit rester POD");
+}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef SPHEREHITSINK_HH
+#define SPHEREHITSINK_HH
+
+#include "SphereHitRecord.hh"
+#include "globals.hh"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+class G4HCofThisEvent;
+
+// =====================================================
+// Sortie en flux des hits SphereSurfaceSD, une instance par thread
+// (remplace RunAction::fHitsByEvent, qui gardait tous les hits du run en mémoire)
+//
+// - EventAction::EndOfEventAction transmet la collection "SphereSD/SphereHitsCollection"
+//   de l'événement terminé ; les hits (SphereHitIO::Record, POD) sont copiés dans
+//   un tampon de taille fixe, vidé sur disque quand il est plein et en fin de run.
+//   La collection elle-même est libérée par Geant4 avec l'événement.
+// - La mémoire ne dépend donc plus du nombre d'événements.
+// - Fichier : spherehits_run<R>_<seq|tN>.bin, créé seulement si au moins un hit.
+// =====================================================
+class SphereHitSink
+{
+public:
+    // Instance propre au thread courant ; Destroy() en fin de thread (RunAction::~RunAction)
+    static SphereHitSink* Instance();
+    static void Destroy();
+
+    void BeginRun(G4int runID, G4int verbose);
+    void Consume(G4int eventID, G4HCofThisEvent* hce);
+    void EndRun();
+
+    G4long GetHitsWritten() const { return fHitsWritten; }
+
+private:
+    SphereHitSink();
+    ~SphereHitSink();
+
+    void Flush();
+    void OpenFile();
+
+    static const std::size_t kBufferSize = 8192;   // ~350 ko par thread
+
+    std::vector<SphereHitIO::Record> fBuffer;
+    std::size_t fCount = 0;
+
+    G4int  fHCID = -2;        // -2 : non résolu, -1 : collection absente (pas de SphereSD)
+    G4int  fRunID = 0;
+    G4int  fVerbose = 0;      // 1 : bilan par événement (nombre de hits, E_dep)
+    G4long fEventsWithHits = 0;
+    G4long fHitsWritten = 0;
+
+    std::ofstream fFile;
+    std::string   fFileName;
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef STEPTRACERECORD_HH
+#define STEPTRACERECORD_HH
+
+// =====================================================
+// Format binaire du fichier de trace step par step
+// (partagé entre StepTraceRecorder et l'outil tools/steptrace_decode.cc,
+//  volontairement sans dépendance Geant4)
+//
+// Fichier :
+//   FileHeader
+//   nVolumes x { uint32 volumeId ; uint16 nameLength ; char name[nameLength] }
+//   Record, Record, ... jusqu'à la fin du fichier
+// =====================================================
+
+#include <cstdint>
+
+namespace StepTrace
+{
+    constexpr char          kMagic[8] = {'S', 'T', 'P', 'T', 'R', 'A', 'C', 'E'};
+    constexpr std::uint32_t kVersion  = 1;
+
+    struct FileHeader
+    {
+        char          magic[8];
+        std::uint32_t version;
+        std::uint32_t recordSize;   // sizeof(Record), contrôle de cohérence au décodage
+        std::uint32_t nVolumes;     // entrées du dictionnaire de volumes qui suivent
+        std::int32_t  threadId;     // -1 en séquentiel
+    };
+
+    // Un step : 52 octets, positions en mm, énergie en keV
+    struct Record
+    {
+        std::int32_t  eventID;
+        std::int32_t  trackID;
+        std::int32_t  parentID;
+        std::int32_t  stepNumber;
+        std::int32_t  pdg;
+        float         ekin_keV;     // énergie cinétique au pre-step
+        std::int16_t  preVolume;    // InstanceID du volume logique, -1 hors monde
+        std::int16_t  postVolume;
+        float         prePos[3];
+        float         postPos[3];
+    };
+
+    static_assert(sizeof(Record) == 52, "StepTrace::Record doit rester compact (52 octets)");
+}
+
+#endif
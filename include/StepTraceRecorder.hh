@@ -0,0 +1,71 @@
+#ifndef STEPTRACERECORDER_HH
+#define STEPTRACERECORDER_HH
+
+#include "StepTraceRecord.hh"
+#include "globals.hh"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+class G4Step;
+
+// =====================================================
+// Enregistreur de trace step par step, un par thread
+// (remplace ShouldTrackParticle / PrintStepInfo)
+//
+// - Armé dans EventAction::BeginOfEventAction pour les événements sélectionnés
+//   (eventID < N, ou ID explicitement demandés ; aucun par défaut) ; sinon le coût dans le
+//   SteppingAction se réduit au test IsArmed().
+// - Les steps sont copiés dans un tampon binaire de taille fixe, vidé sur
+//   disque quand il est plein et en fin de run.
+// - Fichier : steptrace_run<R>_<seq|tN>.bin, à décoder avec steptrace_decode.
+// =====================================================
+class StepTraceRecorder
+{
+public:
+    // Instance propre au thread courant ; Destroy() en fin de thread (RunAction::~RunAction)
+    static StepTraceRecorder* Instance();
+    static void Destroy();
+
+    // Configuration (commandes /stepping/traceEvents et /stepping/traceEventID)
+    void SetMaxTracedEvents(G4int n) { fMaxTracedEvents = n; }
+    G4int GetMaxTracedEvents() const { return fMaxTracedEvents; }
+    void AddTracedEventID(G4int eventID);
+
+    void BeginRun(G4int runID);
+    void ArmForEvent(G4int eventID);
+    void EndRun();
+
+    inline G4bool IsArmed() const { return fArmed; }
+    void Record(const G4Step* step);
+
+    G4int  GetTracedEventsCount() const { return fTracedEvents; }
+    G4long GetRecordsWritten() const { return fRecordsWritten; }
+
+private:
+    StepTraceRecorder();
+    ~StepTraceRecorder();
+
+    void Flush();
+    void OpenFile();
+
+    static const std::size_t kBufferSize = 16384;   // ~850 ko par thread
+
+    std::vector<StepTrace::Record> fBuffer;
+    std::size_t fCount = 0;
+
+    G4int  fMaxTracedEvents = 0;    // trace sur demande uniquement (/stepping/traceEvents)
+    std::vector<G4int> fExplicitEventIDs;   // trié
+
+    G4bool fArmed = false;
+    G4int  fCurrentEventID = -1;
+    G4int  fRunID = 0;
+    G4int  fTracedEvents = 0;
+    G4long fRecordsWritten = 0;
+
+    std::ofstream fFile;
+    std::string   fFileName;
+};
+
+#endif
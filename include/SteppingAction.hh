@@ -3,12 +3,16 @@
 
 #include "G4UserSteppingAction.hh"
 #include "G4Step.hh"
-#include <set>
 
 #include "DetectorConstruction.hh"
 #include "EventAction.hh"
+#include "RunAction.hh"
 
 #include "SteppingMessenger.hh"
+#include "StepTraceRecorder.hh"
+#include "PhaseSpaceWriter.hh"
+#include "PrimaryLossTable.hh"
+#include "VirtualPlaneScorer.hh"
 #include "globals.hh"
 
 class SteppingAction : public G4UserSteppingAction
@@ -20,11 +24,12 @@ public:
     virtual void UserSteppingAction(const G4Step*);
     void SetVerbose(G4int level){fSteppingVerboseLevel = level;};
 
-    // ==================== Step Tracking (print to output) ====================
-    static void ResetTrackedParticlesCount();
-    static G4int GetTrackedParticlesCount();
-    static void SetMaxTrackedParticles(G4int n);
-    static G4int GetMaxTrackedParticles();
+    // ==================== Step Tracking (trace binaire par thread) ====================
+    StepTraceRecorder* GetTraceRecorder() const { return fTraceRecorder; }
+
+    // Estimateur de kerma par longueur de trace dans les couronnes d'eau (en plus du dépôt analogique)
+    void SetTrackLengthEstimator(G4bool on) { fTrackLengthEstimator = on; }
+    G4bool GetTrackLengthEstimator() const { return fTrackLengthEstimator; }
 
 private:
     EventAction *fEventAction;
@@ -33,14 +38,24 @@ private:
     SteppingMessenger* fSteppingMessenger;
 
     // ==================== Step Tracking ====================
-    static G4int fMaxTrackedEvents;           // Nombre max d'événements à suivre
-    static G4int fTrackedEventsCount;         // Compteur d'événements suivis
-    static std::set<G4int> fTrackedEventIDs;  // Set des eventID suivis
-    static std::set<G4int> fTrackedTrackIDs;  // Set des trackID à suivre dans l'événement courant
-    static G4int fCurrentEventID;             // EventID courant
-    
-    void PrintStepInfo(const G4Step* step, G4int eventID);
-    G4bool ShouldTrackParticle(const G4Track* track, G4int eventID);
+    StepTraceRecorder* fTraceRecorder = nullptr;   // instance du thread (armée par EventAction)
+
+    // Espace des phases (/phasespace/enable), instance du thread
+    PhaseSpaceWriter* fPhaseSpace = nullptr;
+
+    // RunAction du thread : compteurs de plans (accumulables)
+    RunAction* fRunAction = nullptr;
+
+    // [LOSS] Table de pertes du RunAction du thread
+    PrimaryLossTable* fLossTable = nullptr;
+
+    G4bool fTrackLengthEstimator = false;
+
+    // Grille de dose 3D du RunAction du thread
+    DoseMesh* fDoseMesh = nullptr;
+
+    // Plans de comptage virtuels (/detector/scoringMode virtual), inactif sinon
+    VirtualPlaneScorer fVirtualPlanes;
 
 };
 #endif
@@ -5,6 +5,7 @@
 #include "globals.hh"
 
 class G4UIcmdWithAnInteger;
+class G4UIcmdWithABool;
 class SteppingAction;
 
 class SteppingMessenger : public G4UImessenger {
@@ -17,6 +18,9 @@ public:
 private:
     SteppingAction* fStepping;
     G4UIcmdWithAnInteger* fVerboseCmd;
+    G4UIcmdWithAnInteger* fTraceEventsCmd;
+    G4UIcmdWithAnInteger* fTraceEventIDCmd;
+    G4UIcmdWithABool* fTrackLengthCmd;
 };
 
 #endif
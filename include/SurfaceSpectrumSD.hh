@@ -3,30 +3,27 @@
 
 // Geant4
 #include "G4VSensitiveDetector.hh"
+#include "G4ThreeVector.hh"
 #include "globals.hh"
 
 // STL
 #include <vector>
 #include <string>
 
-#include <set>
-
 // Fwds
 class G4Step;
 class G4HCofThisEvent;
 class G4TouchableHistory;
+class G4Track;
+class G4VPhysicalVolume;
 
 /**
  * @brief Sensitive detector pour compter les passages d’un plan mince
  *        et remplir à la fois un histogramme binned (en mémoire) et un ntuple (G4Analysis).
  *
- * [DOC] Hypothèses côté ntuple "plane_passages" (même ordre que dans le .cc) :
- *   Col 0 : double x_mm
- *   Col 1 : double y_mm
- *   Col 2 : double z_mm
- *   Col 3 : double E_keV
- *   Col 4 : int    pdg
- *   Col 5 : string name   (si tu ne crées pas cette colonne string, commente FillNtupleSColumn côté .cc)
+ * [DOC] Colonnes de l'ntuple "plane_passages" (même ordre que dans le .cc) :
+ *   pdg, is_secondary, x_mm, y_mm, z_mm, ekin_keV, trackID, parentID,
+ *   creator_process_id (id interné, noms dans l'ntuple "dictionary")
  */
 
 class SurfaceSpectrumSD : public G4VSensitiveDetector
@@ -49,6 +46,12 @@ public:
   G4bool  ProcessHits(G4Step* step, G4TouchableHistory*) override;
   void    EndOfEvent(G4HCofThisEvent* hce) override;
 
+  // [ADD] Sortie du plan validée (position / énergie au point de sortie).
+  //       Appelé par ProcessHits, ou par VirtualPlaneScorer en mode plans virtuels.
+  G4bool  ScoreLeave(const G4Track* track, const G4ThreeVector& pos,
+                     G4double ekin, const G4ThreeVector& dir);
+  inline void CountEnter() { ++fCntEnter; }
+
   // ---------------------------------------------------------------------------
   // Utilitaires
   // ---------------------------------------------------------------------------
@@ -57,7 +60,9 @@ public:
   // [ADD] Configuration runtime
   inline void SetArea_cm2(G4double a)        { fArea_cm2 = a; }
   inline void SetPassageNtupleId(G4int id)   { fPassageNtupleId = id; }
+  inline void SetSpectrumH1Ids(G4int primId, G4int secId) { fSpectrumH1Id[0] = primId; fSpectrumH1Id[1] = secId; }
   inline void SetVerbose(G4int v)            { fVerbose = v; }
+  inline void SetPlaneVolume(const G4VPhysicalVolume* pv) { fPlanePV = pv; }  // [ADD] plan mince "physScorePlane"
 
   // [ADD] Accès lecture
   inline G4double Emin_keV()     const { return fEMin_keV; }
@@ -87,6 +92,7 @@ private:
   // Politique de comptage et normalisation
   // ---------------------------------------------------------------------------
   G4bool   fOutwardOnly = true;  // [DOC] si true, n’accepte que dir.z() > 0
+  const G4VPhysicalVolume* fPlanePV = nullptr;  // [DOC] volume du plan, comparé par pointeur
   G4double fArea_cm2    = 1.0;   // [DOC] utile pour normaliser un flux, si besoin
 
   // ---------------------------------------------------------------------------
@@ -98,6 +104,9 @@ private:
   // ID de l’ntuple "plane_passages" (G4Analysis)
   G4int   fPassageNtupleId = -1;
 
+  // [ADD] IDs des H1 "Spectrum_ScorePlane_prim/_sec" (spectres pondérés, fusionnés entre threads)
+  G4int   fSpectrumH1Id[2] = {-1, -1};
+
   // ---------------------------------------------------------------------------
   // Compteurs/debug (utilisés par les logs dans le .cc)
   // ---------------------------------------------------------------------------
@@ -108,8 +117,13 @@ private:
   G4long fCntEnter = 0;   // pas entrant dans le plan (pre!=plan, post==plan)
   G4long fCntLeave = 0;   // pas sortant du plan (pre==plan, post!=plan)
   G4long fCntOut   = 0;   // sous-ensemble leave qui sont "outward" si filtre actif
+  G4double fWeightOut = 0.;  // Σ poids des sorties "outward" (transmission non biaisée)
   G4long fCntRows  = 0;   // lignes réellement écrites dans l’ntuple
-  std::set<int> fEventsPrimaryCounted; // événements primaires pour lesquels on a écrit au moins 1 ligne
+  // [FIX] Événements avec au moins une ligne "primaire" : drapeau par événement
+  //       (remis à zéro dans Initialize) + compteur incrémenté dans EndOfEvent.
+  //       Mémoire constante, quelle que soit la longueur du run.
+  G4bool fPrimaryRowThisEvent  = false;
+  G4long fEventsPrimaryCounted = 0;
 
 };
 
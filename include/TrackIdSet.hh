@@ -0,0 +1,65 @@
+#ifndef TRACKIDSET_HH
+#define TRACKIDSET_HH
+
+#include "globals.hh"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// =====================================================
+// Ensemble de TrackID d'un événement (dédoublonnage des scorers de plans)
+// Les TrackID d'un événement sont des petits entiers denses (1, 2, 3, ...) :
+// un bitset de mots 64 bits, agrandi à la demande et jamais rétréci, remplace
+// std::set<G4int> (une allocation de nœud par insertion).
+//  - Insert / Contains : O(1), sans allocation une fois la capacité atteinte
+//  - Clear : ne remet à zéro que les mots touchés pendant l'événement
+// Une instance par SD ; les SD étant propres à chaque thread, aucune synchronisation.
+// =====================================================
+class TrackIdSet
+{
+public:
+    explicit TrackIdSet(std::size_t initialTracks = 256)
+        : fWords((initialTracks + 63) / 64, 0u)
+    {}
+
+    // true si l'identifiant n'était pas encore présent
+    inline G4bool Insert(G4int trackID)
+    {
+        if (trackID < 0) return false;
+        const std::size_t w = static_cast<std::size_t>(trackID) >> 6;
+        const std::uint64_t bit = std::uint64_t(1) << (trackID & 63);
+        if (w >= fWords.size()) fWords.resize(std::max(w + 1, 2 * fWords.size()), 0u);
+        if (fWords[w] & bit) return false;
+        fWords[w] |= bit;
+        if (w >= fUsedWords) fUsedWords = w + 1;
+        ++fSize;
+        return true;
+    }
+
+    inline G4bool Contains(G4int trackID) const
+    {
+        if (trackID < 0) return false;
+        const std::size_t w = static_cast<std::size_t>(trackID) >> 6;
+        return w < fWords.size() && (fWords[w] >> (trackID & 63)) & 1u;
+    }
+
+    // Début d'événement : capacité conservée
+    inline void Clear()
+    {
+        std::fill(fWords.begin(), fWords.begin() + fUsedWords, 0u);
+        fUsedWords = 0;
+        fSize = 0;
+    }
+
+    inline std::size_t Size() const { return fSize; }
+    inline G4bool Empty() const { return fSize == 0; }
+
+private:
+    std::vector<std::uint64_t> fWords;
+    std::size_t fUsedWords = 0;   // mots [0, fUsedWords) potentiellement non nuls
+    std::size_t fSize = 0;
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef VIRTUALPLANESCORER_HH
+#define VIRTUALPLANESCORER_HH
+
+#include "G4Step.hh"
+#include "globals.hh"
+
+#include <algorithm>
+#include <vector>
+
+class RunAction;
+class SurfaceSpectrumSD;
+class PlaneCrossingSD;
+
+// =====================================================
+// Plans de comptage "virtuels" (/detector/scoringMode virtual)
+// Les boîtes d'air minces logicScorePlane / 2 / 3 / 5 et leurs G4UserLimits
+// ne sont pas construites : les passages sont détectés analytiquement dans
+// SteppingAction à partir des positions pre/post du step (trajectoire rectiligne,
+// pas de champ dans cette géométrie).
+//
+// Chaque plan garde l'épaisseur de la boîte qu'il remplace (tranche [zMin, zMax]) :
+//  - entrée dans la tranche -> PlaneCrossingSD::ScoreEntry  (ScorePlaneN_passages)
+//  - sortie de la tranche   -> SurfaceSpectrumSD::ScoreLeave (plane_passages)
+//  - primaires              -> RunAction::CountPlanePrimEnter / Leave
+// Les SD restent enregistrés (mêmes noms, mêmes ntuples, mêmes compteurs), seul
+// le déclenchement change. Les faces latérales ne sont pas testées (plans de
+// 100 × 100 mm, faisceau collimaté).
+// =====================================================
+struct VirtualPlane
+{
+    G4String sdName;          // "SpecSD", "ScorePlane2SD", ...
+    G4int    planeIndex = -1; // index VolumeRoleRegistry (0 = logicScorePlane, 1 = plan 2, ...)
+    G4double zMin = 0.;       // face amont
+    G4double zMax = 0.;       // face aval
+    G4double hx = 0.;         // demi-extensions transverses
+    G4double hy = 0.;
+};
+
+class VirtualPlaneScorer
+{
+public:
+    // Configuration partagée : écrite par DetectorConstruction::Construct() (master,
+    // avant le démarrage des workers), lue ensuite par tous les threads
+    static void ClearPlanes() { fPlanes.clear(); }
+    static void AddPlane(const VirtualPlane& plane) { fPlanes.push_back(plane); }
+    static const std::vector<VirtualPlane>& GetPlanes() { return fPlanes; }
+    static const VirtualPlane* FindPlane(const G4String& sdName);
+    static G4bool IsEnabled() { return !fPlanes.empty(); }
+
+    // Instance par thread (membre de SteppingAction)
+    inline void Process(const G4Step* step, RunAction* runAction)
+    {
+        if (fPlanes.empty()) return;
+        const G4double z0 = step->GetPreStepPoint()->GetPosition().z();
+        const G4double z1 = step->GetPostStepPoint()->GetPosition().z();
+        if (z0 == z1) return;
+
+        const G4double zLo = std::min(z0, z1);
+        const G4double zHi = std::max(z0, z1);
+        for (std::size_t i = 0; i < fPlanes.size(); ++i) {
+            // Rejet rapide : le step ne chevauche pas la tranche
+            if (zHi < fPlanes[i].zMin || zLo > fPlanes[i].zMax) continue;
+            ProcessPlane(step, i, runAction);
+        }
+    }
+
+private:
+    void Bind();
+    void ProcessPlane(const G4Step* step, std::size_t i, RunAction* runAction);
+
+    static std::vector<VirtualPlane> fPlanes;
+
+    // SD du thread, résolus par nom au premier passage (créés par ConstructSDandField)
+    G4bool fBound = false;
+    std::vector<SurfaceSpectrumSD*> fSpecSDs;
+    std::vector<PlaneCrossingSD*>   fCrossingSDs;
+};
+
+#endif
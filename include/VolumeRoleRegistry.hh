@@ -0,0 +1,65 @@
+#ifndef VOLUMEROLEREGISTRY_HH
+#define VOLUMEROLEREGISTRY_HH
+
+#include "G4LogicalVolume.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <vector>
+
+// =====================================================
+// Registre des rôles de volumes
+// Construit une seule fois à la fin de DetectorConstruction::Construct() :
+// chaque G4LogicalVolume est associé (via son InstanceID, dense) à un
+// masque de rôles + un index d'anneau / de plan.
+// Le SteppingAction classe ainsi pre/post volumes par simple indexation,
+// sans copie ni comparaison de G4String.
+// =====================================================
+namespace VolumeRole
+{
+    enum : std::uint32_t {
+        kNone        = 0,
+        kWorld       = 1u << 0,
+        kEnvelope    = 1u << 1,   // logicEnveloppeGDML
+        kBeWindow    = 1u << 2,   // MiniX-TubeXFenetreBeryllium-Beryllium
+        kScorePlane  = 1u << 3,   // logicScorePlane, logicScorePlane2/3/5
+        kWaterRing   = 1u << 4,   // logicWaterRing0..4
+        kWaterCube   = 1u << 5,   // logicWaterCube (historique)
+        kWaterSphere = 1u << 6    // logicsphereWater (historique)
+    };
+}
+
+struct VolumeRoleInfo
+{
+    std::uint32_t roles      = VolumeRole::kNone;
+    G4int    ringIndex  = -1;   // 0..4 pour les couronnes d'eau
+    G4int    planeIndex = -1;   // 0 = logicScorePlane, 1 = plan 2, 2 = plan 3, 3 = plan 5
+
+    G4bool Has(std::uint32_t role) const { return (roles & role) != 0; }
+};
+
+class VolumeRoleRegistry
+{
+public:
+    // Nombre de plans de comptage connus (logicScorePlane, 2, 3, 5)
+    static const G4int kNbScorePlanes = 4;
+
+    // (Re)construit la table à partir du G4LogicalVolumeStore
+    static void Build();
+
+    // Lookup O(1) sans allocation (LV nul ou inconnu -> rôle kNone)
+    static inline const VolumeRoleInfo& Lookup(const G4LogicalVolume* lv)
+    {
+        if (!lv) return fNone;
+        const std::size_t id = static_cast<std::size_t>(lv->GetInstanceID());
+        return (id < fByInstance.size()) ? fByInstance[id] : fNone;
+    }
+
+    static const char* GetScorePlaneName(G4int planeIndex);
+
+private:
+    static std::vector<VolumeRoleInfo> fByInstance;
+    static const VolumeRoleInfo fNone;
+};
+
+#endif
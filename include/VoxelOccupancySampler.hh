@@ -0,0 +1,51 @@
+#ifndef VOXELOCCUPANCYSAMPLER_HH
+#define VOXELOCCUPANCYSAMPLER_HH
+
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+#include <cstdint>
+#include <vector>
+
+class G4VSolid;
+
+// =====================================================
+// Tirage uniforme d'un point dans (solide ∩ boîte) par grille d'occupation (source volumique)
+//  - construite une fois : chaque voxel de la boîte est classé par les distances de sûreté
+//    du solide au centre (plein / vide / partiel) ; seuls les voxels non vides sont gardés
+//  - tirage : voxel uniforme parmi les non vides, point uniforme dans le voxel ;
+//    Inside() n'est appelé que pour les voxels partiels (rejet local, recommencé depuis
+//    le choix du voxel : la loi reste exactement uniforme dans le solide)
+// Les distances de sûreté sous-estiment la vraie distance : un voxel douteux est classé
+// partiel, jamais plein ou vide à tort.
+// =====================================================
+class VoxelOccupancySampler
+{
+public:
+    VoxelOccupancySampler() = default;
+
+    // Voxels ~cubiques, nMax le long du plus grand côté de la boîte. false si aucun voxel occupé
+    G4bool Build(const G4VSolid* solid, const G4ThreeVector& boxMin, const G4ThreeVector& boxMax, G4int nMax = 32);
+
+    G4bool IsValid() const { return !fVoxels.empty(); }
+
+    // Point uniforme dans solide ∩ boîte ; false si maxAttempts rejets successifs (grille incohérente)
+    G4bool Sample(G4ThreeVector& point, G4int maxAttempts = 1000) const;
+
+    std::size_t GetNbFull() const { return fNbFull; }
+    std::size_t GetNbPartial() const { return fVoxels.size() - fNbFull; }
+    std::size_t GetNbVoxels() const { return static_cast<std::size_t>(fN[0]) * fN[1] * fN[2]; }
+
+private:
+    static constexpr std::uint32_t kPartialFlag = 0x80000000u;
+
+    const G4VSolid* fSolid = nullptr;
+    G4ThreeVector   fMin;
+    G4ThreeVector   fStep;
+    G4int           fN[3] = {0, 0, 0};
+
+    std::vector<std::uint32_t> fVoxels;   // index linéaire des voxels non vides (+ kPartialFlag)
+    std::size_t fNbFull = 0;
+};
+
+#endif
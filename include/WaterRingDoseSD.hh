@@ -0,0 +1,36 @@
+#ifndef WaterRingDoseSD_hh
+#define WaterRingDoseSD_hh 1
+
+#include "G4VSensitiveDetector.hh"
+#include "globals.hh"
+
+class G4Step;
+class G4TouchableHistory;
+class EventAction;
+class SteppingAction;
+
+/**
+ * @brief Dépôt d'énergie par couronne d'eau, pour les couronnes fantômes du monde parallèle
+ *
+ * Le G4Step reçu est le step "fantôme" de G4ParallelWorldProcess : l'énergie déposée
+ * est celle du step réel (eau du monde de masse), le volume pre-step est la couronne
+ * fantôme dont l'index est donné par VolumeRoleRegistry. Le dépôt est transmis à
+ * EventAction::AddEdepToRing (et au profil en profondeur), et la contribution des photons
+ * à l'estimateur par longueur de trace à EventAction::AddTrackLengthToRing, comme le fait
+ * le SteppingAction en modes volume/virtual. Matériau et longueur du step fantôme sont
+ * ceux du step réel.
+ */
+class WaterRingDoseSD : public G4VSensitiveDetector
+{
+public:
+    explicit WaterRingDoseSD(const G4String& name);
+    ~WaterRingDoseSD() override = default;
+
+    G4bool ProcessHits(G4Step* step, G4TouchableHistory*) override;
+
+private:
+    EventAction*    fEventAction = nullptr;      // résolus au premier hit (thread courant)
+    SteppingAction* fSteppingAction = nullptr;   // état de /stepping/trackLengthEstimator
+};
+
+#endif // WaterRingDoseSD_hh
@@ -6,11 +6,7 @@
 
 #include "G4SDManager.hh"
 #include "SurfaceSpectrumSD.hh"
-#include "ScorePlane2SD.hh"
-#include "ScorePlane3SD.hh"
-#include "ScorePlane4SD.hh"
-#include "ScorePlane5SD.hh"
-// ScorePlane6SD supprimé
+#include "PlaneCrossingSD.hh"
 #include "G4Run.hh"
 
 // Variables globales pour stocker les IDs des ntuples
@@ -19,6 +15,13 @@ static int g_scorePlane2NtupleId = -1;
 static int g_scorePlane3NtupleId = -1;
 static int g_scorePlane4NtupleId = -1;
 static int g_scorePlane5NtupleId = -1;
+static int g_dictionaryNtupleId = -1;
+static int g_spectrumH1Id[kNbSpectrumPlanes][2] = {{-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}};
+static int g_doseMeshH3Id = -1;
+static int g_doseMeshMassH3Id = -1;
+static int g_doseStatsNtupleId = -1;
+static int g_depthEdepH2Id = -1;
+static int g_depthDoseH2Id = -1;
 // g_scorePlane6NtupleId supprimé
 
 void SetupAnalysis()
@@ -30,6 +33,9 @@ void SetupAnalysis()
     man->SetFirstNtupleId(0);
     man->SetFirstHistoId(0);
 
+    // Ntuples des workers fusionnés dans le fichier du master (sans effet en séquentiel)
+    man->SetNtupleMerging(true);
+
     // ==================== Histogrammes 1D ====================
     
     // H0: Énergie des gammas primaires à l'émission
@@ -100,53 +106,89 @@ void SetupAnalysis()
     analysisManager->CreateH1("Dose_ring4_10000evt", 
         "Dose anneau 4 (r=8-10mm) 10000evt;Dose (pGy);Counts", 200, 0., 100.);  // ID 14 (pGy)
 
+    // ============================================================================
+    // SPECTRES EN ÉNERGIE PAR PLAN (primaires / secondaires)
+    // ============================================================================
+    // Même binning que SurfaceSpectrumSD : 0 -> 60 keV, 120 bins de 0.5 keV.
+    // Remplis par les SD avec le poids de la trace : chaque bin garde la somme des
+    // poids et la somme des poids² (erreur = sqrt(Σw²)), fusionnées entre threads au Write().
+    // IDs 15..24 : plan p -> 15 + 2p (primaires), 16 + 2p (secondaires)
+    {
+        const char* const planeNames[kNbSpectrumPlanes] = {
+            "ScorePlane", "ScorePlane2", "ScorePlane3", "WaterRings", "ScorePlane5"
+        };
+        for (int p = 0; p < kNbSpectrumPlanes; ++p) {
+            const G4String base = G4String("Spectrum_") + planeNames[p];
+            g_spectrumH1Id[p][0] = analysisManager->CreateH1(base + "_prim",
+                base + " primaires;E (keV);Somme des poids", 120, 0., 60.);
+            g_spectrumH1Id[p][1] = analysisManager->CreateH1(base + "_sec",
+                base + " secondaires;E (keV);Somme des poids", 120, 0., 60.);
+        }
+    }
+
+    // ==================== Histogrammes 3D : grille de dose ====================
+    // Binning provisoire : redéfini par DoseMesh::BeginRun() (SetH3) selon /dose/mesh/...
+    // Axes : (r [mm], phi [deg], z [mm]) en cylindrique, (x, y, z) [mm] en cartésien
+    g_doseMeshH3Id = analysisManager->CreateH3("DoseMesh_pGy",
+        "Dose par voxel;axe 1;axe 2;z (mm)", 1, 0., 1., 1, 0., 1., 1, 0., 1.);      // H3 ID 0
+    g_doseMeshMassH3Id = analysisManager->CreateH3("DoseMesh_mass_g",
+        "Masse par voxel (g);axe 1;axe 2;z (mm)", 1, 0., 1., 1, 0., 1., 1, 0., 1.); // H3 ID 1
+
+    // ==================== Histogrammes 2D : profil en profondeur ====================
+    // Anneau × profondeur depuis la face d'entrée de l'eau (coordonnée z locale de la couronne)
+    // Binning en profondeur redéfini par RunAction::BeginOfRunAction() (SetH2) selon l'épaisseur d'eau
+    g_depthEdepH2Id = analysisManager->CreateH2("DepthEdep_keV",
+        "Energie deposee;Anneau;Profondeur (mm)", 5, -0.5, 4.5, 30, 0., 3.);      // H2 ID 0
+    g_depthDoseH2Id = analysisManager->CreateH2("DepthDose_pGy",
+        "Dose;Anneau;Profondeur (mm)", 5, -0.5, 4.5, 30, 0., 3.);                // H2 ID 1
+
     // ==================== Ntuple plane_passages ====================
     // Ntuple des passages plan +Z (ScorePlane à z = 18 mm)
     // Structure harmonisée avec les autres ntuples (ScorePlane2, ScorePlane3, etc.)
-    // Colonnes : pdg, name, is_secondary, x_mm, y_mm, z_mm, ekin_keV, trackID, parentID, creator_process
+    // Colonnes : pdg, is_secondary, x_mm, y_mm, z_mm, ekin_keV, trackID, parentID, creator_process_id, weight
     g_planePassageNtupleId = analysisManager->CreateNtuple("plane_passages", "Traversées +Z du plan mince");
     analysisManager->CreateNtupleIColumn(g_planePassageNtupleId, "pdg");             // 0: Code PDG
-    analysisManager->CreateNtupleSColumn(g_planePassageNtupleId, "name");            // 1: Nom particule
-    analysisManager->CreateNtupleIColumn(g_planePassageNtupleId, "is_secondary");    // 2: 0=primaire, 1=secondaire
-    analysisManager->CreateNtupleDColumn(g_planePassageNtupleId, "x_mm");            // 3: Position X (mm)
-    analysisManager->CreateNtupleDColumn(g_planePassageNtupleId, "y_mm");            // 4: Position Y (mm)
-    analysisManager->CreateNtupleDColumn(g_planePassageNtupleId, "z_mm");            // 5: Position Z (mm)
-    analysisManager->CreateNtupleDColumn(g_planePassageNtupleId, "ekin_keV");        // 6: Énergie cinétique (keV)
-    analysisManager->CreateNtupleIColumn(g_planePassageNtupleId, "trackID");         // 7: TrackID
-    analysisManager->CreateNtupleIColumn(g_planePassageNtupleId, "parentID");        // 8: ParentID
-    analysisManager->CreateNtupleSColumn(g_planePassageNtupleId, "creator_process"); // 9: Processus créateur
+    analysisManager->CreateNtupleIColumn(g_planePassageNtupleId, "is_secondary");    // 1: 0=primaire, 1=secondaire
+    analysisManager->CreateNtupleDColumn(g_planePassageNtupleId, "x_mm");            // 2: Position X (mm)
+    analysisManager->CreateNtupleDColumn(g_planePassageNtupleId, "y_mm");            // 3: Position Y (mm)
+    analysisManager->CreateNtupleDColumn(g_planePassageNtupleId, "z_mm");            // 4: Position Z (mm)
+    analysisManager->CreateNtupleDColumn(g_planePassageNtupleId, "ekin_keV");        // 5: Énergie cinétique (keV)
+    analysisManager->CreateNtupleIColumn(g_planePassageNtupleId, "trackID");         // 6: TrackID
+    analysisManager->CreateNtupleIColumn(g_planePassageNtupleId, "parentID");        // 7: ParentID
+    analysisManager->CreateNtupleIColumn(g_planePassageNtupleId, "creator_process_id"); // 8: Processus créateur (id, cf. dictionary)
+    analysisManager->CreateNtupleDColumn(g_planePassageNtupleId, "weight");             // 9: Poids statistique (biaisage source)
     analysisManager->FinishNtuple(g_planePassageNtupleId);
 
     // ==================== Ntuple ScorePlane2 ====================
     // Ntuple pour le plan de comptage ScorePlane2 (z = 28 mm)
-    // Colonnes : pdg, name, is_secondary, x_mm, y_mm, ekin_keV, trackID, parentID, creator_process
+    // Colonnes : pdg, is_secondary, x_mm, y_mm, ekin_keV, trackID, parentID, creator_process_id
     g_scorePlane2NtupleId = analysisManager->CreateNtuple("ScorePlane2_passages", 
         "Traversées +Z du plan ScorePlane2");
     analysisManager->CreateNtupleIColumn(g_scorePlane2NtupleId, "pdg");           // 0: Code PDG
-    analysisManager->CreateNtupleSColumn(g_scorePlane2NtupleId, "name");          // 1: Nom particule
-    analysisManager->CreateNtupleIColumn(g_scorePlane2NtupleId, "is_secondary");  // 2: 0=primaire, 1=secondaire
-    analysisManager->CreateNtupleDColumn(g_scorePlane2NtupleId, "x_mm");          // 3: Position X (mm)
-    analysisManager->CreateNtupleDColumn(g_scorePlane2NtupleId, "y_mm");          // 4: Position Y (mm)
-    analysisManager->CreateNtupleDColumn(g_scorePlane2NtupleId, "ekin_keV");      // 5: Énergie cinétique (keV)
-    analysisManager->CreateNtupleIColumn(g_scorePlane2NtupleId, "trackID");       // 6: TrackID
-    analysisManager->CreateNtupleIColumn(g_scorePlane2NtupleId, "parentID");      // 7: ParentID
-    analysisManager->CreateNtupleSColumn(g_scorePlane2NtupleId, "creator_process"); // 8: Processus créateur
+    analysisManager->CreateNtupleIColumn(g_scorePlane2NtupleId, "is_secondary");  // 1: 0=primaire, 1=secondaire
+    analysisManager->CreateNtupleDColumn(g_scorePlane2NtupleId, "x_mm");          // 2: Position X (mm)
+    analysisManager->CreateNtupleDColumn(g_scorePlane2NtupleId, "y_mm");          // 3: Position Y (mm)
+    analysisManager->CreateNtupleDColumn(g_scorePlane2NtupleId, "ekin_keV");      // 4: Énergie cinétique (keV)
+    analysisManager->CreateNtupleIColumn(g_scorePlane2NtupleId, "trackID");       // 5: TrackID
+    analysisManager->CreateNtupleIColumn(g_scorePlane2NtupleId, "parentID");      // 6: ParentID
+    analysisManager->CreateNtupleIColumn(g_scorePlane2NtupleId, "creator_process_id"); // 7: Processus créateur (id, cf. dictionary)
+    analysisManager->CreateNtupleDColumn(g_scorePlane2NtupleId, "weight");             // 8: Poids statistique (biaisage source)
     analysisManager->FinishNtuple(g_scorePlane2NtupleId);
 
     // ==================== Ntuple ScorePlane3 ====================
     // Ntuple pour le plan de comptage ScorePlane3 (z = 38 mm)
-    // Colonnes : pdg, name, is_secondary, x_mm, y_mm, ekin_keV, trackID, parentID, creator_process
+    // Colonnes : pdg, is_secondary, x_mm, y_mm, ekin_keV, trackID, parentID, creator_process_id
     g_scorePlane3NtupleId = analysisManager->CreateNtuple("ScorePlane3_passages", 
         "Traversées +Z du plan ScorePlane3");
     analysisManager->CreateNtupleIColumn(g_scorePlane3NtupleId, "pdg");             // 0: Code PDG
-    analysisManager->CreateNtupleSColumn(g_scorePlane3NtupleId, "name");            // 1: Nom particule
-    analysisManager->CreateNtupleIColumn(g_scorePlane3NtupleId, "is_secondary");    // 2: 0=primaire, 1=secondaire
-    analysisManager->CreateNtupleDColumn(g_scorePlane3NtupleId, "x_mm");            // 3: Position X (mm)
-    analysisManager->CreateNtupleDColumn(g_scorePlane3NtupleId, "y_mm");            // 4: Position Y (mm)
-    analysisManager->CreateNtupleDColumn(g_scorePlane3NtupleId, "ekin_keV");        // 5: Énergie cinétique (keV)
-    analysisManager->CreateNtupleIColumn(g_scorePlane3NtupleId, "trackID");         // 6: TrackID
-    analysisManager->CreateNtupleIColumn(g_scorePlane3NtupleId, "parentID");        // 7: ParentID
-    analysisManager->CreateNtupleSColumn(g_scorePlane3NtupleId, "creator_process"); // 8: Processus créateur
+    analysisManager->CreateNtupleIColumn(g_scorePlane3NtupleId, "is_secondary");    // 1: 0=primaire, 1=secondaire
+    analysisManager->CreateNtupleDColumn(g_scorePlane3NtupleId, "x_mm");            // 2: Position X (mm)
+    analysisManager->CreateNtupleDColumn(g_scorePlane3NtupleId, "y_mm");            // 3: Position Y (mm)
+    analysisManager->CreateNtupleDColumn(g_scorePlane3NtupleId, "ekin_keV");        // 4: Énergie cinétique (keV)
+    analysisManager->CreateNtupleIColumn(g_scorePlane3NtupleId, "trackID");         // 5: TrackID
+    analysisManager->CreateNtupleIColumn(g_scorePlane3NtupleId, "parentID");        // 6: ParentID
+    analysisManager->CreateNtupleIColumn(g_scorePlane3NtupleId, "creator_process_id"); // 7: Processus créateur (id, cf. dictionary)
+    analysisManager->CreateNtupleDColumn(g_scorePlane3NtupleId, "weight");             // 8: Poids statistique (biaisage source)
     analysisManager->FinishNtuple(g_scorePlane3NtupleId);
 
     // ==================== Ntuple WaterRings ====================
@@ -155,14 +197,14 @@ void SetupAnalysis()
     g_scorePlane4NtupleId = analysisManager->CreateNtuple("WaterRings_passages", 
         "Traversées dans les couronnes d'eau");
     analysisManager->CreateNtupleIColumn(g_scorePlane4NtupleId, "pdg");             // 0: Code PDG
-    analysisManager->CreateNtupleSColumn(g_scorePlane4NtupleId, "name");            // 1: Nom particule
-    analysisManager->CreateNtupleIColumn(g_scorePlane4NtupleId, "is_secondary");    // 2: 0=primaire, 1=secondaire
-    analysisManager->CreateNtupleDColumn(g_scorePlane4NtupleId, "x_mm");            // 3: Position X (mm)
-    analysisManager->CreateNtupleDColumn(g_scorePlane4NtupleId, "y_mm");            // 4: Position Y (mm)
-    analysisManager->CreateNtupleDColumn(g_scorePlane4NtupleId, "ekin_keV");        // 5: Énergie cinétique (keV)
-    analysisManager->CreateNtupleIColumn(g_scorePlane4NtupleId, "trackID");         // 6: TrackID
-    analysisManager->CreateNtupleIColumn(g_scorePlane4NtupleId, "parentID");        // 7: ParentID
-    analysisManager->CreateNtupleSColumn(g_scorePlane4NtupleId, "creator_process"); // 8: Processus créateur
+    analysisManager->CreateNtupleIColumn(g_scorePlane4NtupleId, "is_secondary");    // 1: 0=primaire, 1=secondaire
+    analysisManager->CreateNtupleDColumn(g_scorePlane4NtupleId, "x_mm");            // 2: Position X (mm)
+    analysisManager->CreateNtupleDColumn(g_scorePlane4NtupleId, "y_mm");            // 3: Position Y (mm)
+    analysisManager->CreateNtupleDColumn(g_scorePlane4NtupleId, "ekin_keV");        // 4: Énergie cinétique (keV)
+    analysisManager->CreateNtupleIColumn(g_scorePlane4NtupleId, "trackID");         // 5: TrackID
+    analysisManager->CreateNtupleIColumn(g_scorePlane4NtupleId, "parentID");        // 6: ParentID
+    analysisManager->CreateNtupleIColumn(g_scorePlane4NtupleId, "creator_process_id"); // 7: Processus créateur (id, cf. dictionary)
+    analysisManager->CreateNtupleDColumn(g_scorePlane4NtupleId, "weight");             // 8: Poids statistique (biaisage source)
     analysisManager->FinishNtuple(g_scorePlane4NtupleId);
 
     // ==================== Ntuple ScorePlane5 ====================
@@ -170,51 +212,83 @@ void SetupAnalysis()
     g_scorePlane5NtupleId = analysisManager->CreateNtuple("ScorePlane5_passages", 
         "Traversées +Z du plan ScorePlane5");
     analysisManager->CreateNtupleIColumn(g_scorePlane5NtupleId, "pdg");             // 0: Code PDG
-    analysisManager->CreateNtupleSColumn(g_scorePlane5NtupleId, "name");            // 1: Nom particule
-    analysisManager->CreateNtupleIColumn(g_scorePlane5NtupleId, "is_secondary");    // 2: 0=primaire, 1=secondaire
-    analysisManager->CreateNtupleDColumn(g_scorePlane5NtupleId, "x_mm");            // 3: Position X (mm)
-    analysisManager->CreateNtupleDColumn(g_scorePlane5NtupleId, "y_mm");            // 4: Position Y (mm)
-    analysisManager->CreateNtupleDColumn(g_scorePlane5NtupleId, "ekin_keV");        // 5: Énergie cinétique (keV)
-    analysisManager->CreateNtupleIColumn(g_scorePlane5NtupleId, "trackID");         // 6: TrackID
-    analysisManager->CreateNtupleIColumn(g_scorePlane5NtupleId, "parentID");        // 7: ParentID
-    analysisManager->CreateNtupleSColumn(g_scorePlane5NtupleId, "creator_process"); // 8: Processus créateur
+    analysisManager->CreateNtupleIColumn(g_scorePlane5NtupleId, "is_secondary");    // 1: 0=primaire, 1=secondaire
+    analysisManager->CreateNtupleDColumn(g_scorePlane5NtupleId, "x_mm");            // 2: Position X (mm)
+    analysisManager->CreateNtupleDColumn(g_scorePlane5NtupleId, "y_mm");            // 3: Position Y (mm)
+    analysisManager->CreateNtupleDColumn(g_scorePlane5NtupleId, "ekin_keV");        // 4: Énergie cinétique (keV)
+    analysisManager->CreateNtupleIColumn(g_scorePlane5NtupleId, "trackID");         // 5: TrackID
+    analysisManager->CreateNtupleIColumn(g_scorePlane5NtupleId, "parentID");        // 6: ParentID
+    analysisManager->CreateNtupleIColumn(g_scorePlane5NtupleId, "creator_process_id"); // 7: Processus créateur (id, cf. dictionary)
+    analysisManager->CreateNtupleDColumn(g_scorePlane5NtupleId, "weight");             // 8: Poids statistique (biaisage source)
     analysisManager->FinishNtuple(g_scorePlane5NtupleId);
 
     // Ntuple ScorePlane6 supprimé
 
+    // ==================== Ntuple dictionary ====================
+    // Dictionnaire des identifiants internés, rempli une fois par fichier (master)
+    // kind = 0 : processus (id = creator_process_id), kind = 1 : particule (id = pdg)
+    g_dictionaryNtupleId = analysisManager->CreateNtuple("dictionary",
+        "Identifiants -> noms (processus, particules)");
+    analysisManager->CreateNtupleIColumn(g_dictionaryNtupleId, "kind");            // 0: 0=processus, 1=particule
+    analysisManager->CreateNtupleIColumn(g_dictionaryNtupleId, "id");              // 1: identifiant
+    analysisManager->CreateNtupleSColumn(g_dictionaryNtupleId, "name");            // 2: nom
+    analysisManager->FinishNtuple(g_dictionaryNtupleId);
+
+    // ==================== Ntuple dose_stats ====================
+    // Dose par région et incertitude histoire par histoire, une ligne par région et par estimateur
+    // en fin de run (master)
+    // region = 0..4 : anneaux, 5 : eau totale
+    g_doseStatsNtupleId = analysisManager->CreateNtuple("dose_stats",
+        "Dose, erreur relative et efficacité par région");
+    analysisManager->CreateNtupleIColumn(g_doseStatsNtupleId, "region");          // 0: 0..4 anneaux, 5 eau totale
+    analysisManager->CreateNtupleDColumn(g_doseStatsNtupleId, "sum_keV");         // 1: Σ Edep_evt (keV)
+    analysisManager->CreateNtupleDColumn(g_doseStatsNtupleId, "sum2_keV2");       // 2: Σ Edep_evt² (keV²)
+    analysisManager->CreateNtupleDColumn(g_doseStatsNtupleId, "dose_pGy");        // 3: Dose totale (pGy)
+    analysisManager->CreateNtupleDColumn(g_doseStatsNtupleId, "rel_err");         // 4: Erreur relative de la moyenne
+    analysisManager->CreateNtupleDColumn(g_doseStatsNtupleId, "efficiency");      // 5: 1/(R²·T) (s^-1)
+    analysisManager->CreateNtupleIColumn(g_doseStatsNtupleId, "n_events");        // 6: Nombre d'événements
+    analysisManager->CreateNtupleDColumn(g_doseStatsNtupleId, "time_s");          // 7: Temps réel du run (s)
+    analysisManager->CreateNtupleIColumn(g_doseStatsNtupleId, "estimator");       // 8: 0=dépôt analogique, 1=longueur de trace
+    analysisManager->FinishNtuple(g_doseStatsNtupleId);
+
     //  Raccorder l'ID au SD spectral (maintenant défini)
     if (auto* sd = dynamic_cast<SurfaceSpectrumSD*>(
         G4SDManager::GetSDMpointer()->FindSensitiveDetector("SpecSD", /*warning=*/false))) {
         sd->Reset();
         sd->SetPassageNtupleId(g_planePassageNtupleId);
+        sd->SetSpectrumH1Ids(g_spectrumH1Id[kSpectrumScorePlane][0], g_spectrumH1Id[kSpectrumScorePlane][1]);
         // (L'aire [cm^2] est réglée côté DetectorConstruction via specSD->SetArea_cm2(...))
     }
 
     //  Raccorder l'ID au SD ScorePlane2 (si défini)
-    if (auto* sd2 = dynamic_cast<ScorePlane2SD*>(
+    if (auto* sd2 = dynamic_cast<PlaneCrossingSD*>(
         G4SDManager::GetSDMpointer()->FindSensitiveDetector("ScorePlane2SD", /*warning=*/false))) {
         sd2->SetNtupleId(g_scorePlane2NtupleId);
+        sd2->SetSpectrumH1Ids(g_spectrumH1Id[kSpectrumScorePlane2][0], g_spectrumH1Id[kSpectrumScorePlane2][1]);
         G4cout << "[SetupAnalysis] ScorePlane2SD connecté au ntuple id=" << g_scorePlane2NtupleId << G4endl;
     }
 
     //  Raccorder l'ID au SD ScorePlane3 (si défini)
-    if (auto* sd3 = dynamic_cast<ScorePlane3SD*>(
+    if (auto* sd3 = dynamic_cast<PlaneCrossingSD*>(
         G4SDManager::GetSDMpointer()->FindSensitiveDetector("ScorePlane3SD", /*warning=*/false))) {
         sd3->SetNtupleId(g_scorePlane3NtupleId);
+        sd3->SetSpectrumH1Ids(g_spectrumH1Id[kSpectrumScorePlane3][0], g_spectrumH1Id[kSpectrumScorePlane3][1]);
         G4cout << "[SetupAnalysis] ScorePlane3SD connecté au ntuple id=" << g_scorePlane3NtupleId << G4endl;
     }
 
     //  Raccorder l'ID au SD ScorePlane4 (WaterRings) (si défini)
-    if (auto* sd4 = dynamic_cast<ScorePlane4SD*>(
+    if (auto* sd4 = dynamic_cast<PlaneCrossingSD*>(
         G4SDManager::GetSDMpointer()->FindSensitiveDetector("ScorePlane4SD", /*warning=*/false))) {
         sd4->SetNtupleId(g_scorePlane4NtupleId);
+        sd4->SetSpectrumH1Ids(g_spectrumH1Id[kSpectrumWaterRings][0], g_spectrumH1Id[kSpectrumWaterRings][1]);
         G4cout << "[SetupAnalysis] ScorePlane4SD (WaterRings) connecté au ntuple id=" << g_scorePlane4NtupleId << G4endl;
     }
 
     //  Raccorder l'ID au SD ScorePlane5 (si défini)
-    if (auto* sd5 = dynamic_cast<ScorePlane5SD*>(
+    if (auto* sd5 = dynamic_cast<PlaneCrossingSD*>(
         G4SDManager::GetSDMpointer()->FindSensitiveDetector("ScorePlane5SD", /*warning=*/false))) {
         sd5->SetNtupleId(g_scorePlane5NtupleId);
+        sd5->SetSpectrumH1Ids(g_spectrumH1Id[kSpectrumScorePlane5][0], g_spectrumH1Id[kSpectrumScorePlane5][1]);
         G4cout << "[SetupAnalysis] ScorePlane5SD connecté au ntuple id=" << g_scorePlane5NtupleId << G4endl;
     }
 
@@ -257,4 +331,40 @@ int GetScorePlane5NtupleId()
     return g_scorePlane5NtupleId;
 }
 
+int GetDictionaryNtupleId()
+{
+    return g_dictionaryNtupleId;
+}
+
+int GetSpectrumH1Id(int plane, bool secondary)
+{
+    if (plane < 0 || plane >= kNbSpectrumPlanes) return -1;
+    return g_spectrumH1Id[plane][secondary ? 1 : 0];
+}
+
+int GetDoseMeshH3Id()
+{
+    return g_doseMeshH3Id;
+}
+
+int GetDoseMeshMassH3Id()
+{
+    return g_doseMeshMassH3Id;
+}
+
+int GetDoseStatsNtupleId()
+{
+    return g_doseStatsNtupleId;
+}
+
+int GetDepthEdepH2Id()
+{
+    return g_depthEdepH2Id;
+}
+
+int GetDepthDoseH2Id()
+{
+    return g_depthDoseH2Id;
+}
+
 // GetScorePlane6NtupleId() supprimé
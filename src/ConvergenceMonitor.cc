@@ -0,0 +1,124 @@
+#include "ConvergenceMonitor.hh"
+#include "ConvergenceMonitorMessenger.hh"
+#include "VolumeRoleRegistry.hh"
+
+#include "G4RunManager.hh"
+#include "G4Threading.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace {
+    inline const char* ThreadTag() {
+        #ifdef G4MULTITHREADED
+        return G4Threading::IsMasterThread() ? "[MT-MASTER]" : "[MT-WORKER]";
+        #else
+        return "[SEQ]";
+        #endif
+    }
+}
+
+ConvergenceMonitor::ConvergenceMonitor()
+{
+    fMessenger = new ConvergenceMonitorMessenger(this);
+}
+
+ConvergenceMonitor::~ConvergenceMonitor()
+{
+    delete fMessenger;
+}
+
+G4double ConvergenceMonitor::RelativeError(G4double sum, G4double sum2, G4long nEvents)
+{
+    if (nEvents < 2 || sum <= 0.) return -1.;
+    const G4double n = static_cast<G4double>(nEvents);
+    const G4double mean = sum / n;
+    const G4double varMean = std::max(0., sum2 / n - mean * mean) / (n - 1.);
+    return std::sqrt(varMean) / mean;
+}
+
+void ConvergenceMonitor::BeginRun()
+{
+    fEvents = 0;
+    fLastRelErr = -1.;
+    fStopReason = kNotStopped;
+    fStart = std::chrono::steady_clock::now();
+
+    if (!fSettings.enabled || !G4Threading::IsMasterThread()) return;
+
+    G4cout << "[CONV] Arrêt sur incertitude : cible R = " << 100. * fSettings.targetRelErr << " %, régions {";
+    for (G4int k = 0; k < kNbDoseRegions; ++k) {
+        if (!(fSettings.regionMask & (1u << k))) continue;
+        G4cout << ' ' << (k == kTotalWaterRegion ? std::string("total") : "ring" + std::to_string(k));
+    }
+    if (fSettings.planeIndex >= 0)
+        G4cout << " plane:" << VolumeRoleRegistry::GetScorePlaneName(fSettings.planeIndex);
+    G4cout << " }, contrôle tous les " << fSettings.checkEvery << " événements";
+    if (fSettings.maxTime_s > 0.) G4cout << ", budget " << fSettings.maxTime_s << " s";
+    G4cout << G4endl;
+}
+
+G4double ConvergenceMonitor::WorstRelativeError(const ArrayAccumulable<G4double>& doseSums,
+                                                const ArrayAccumulable<G4double>& planePrimWeights) const
+{
+    G4double worst = 0.;
+    G4bool   any = false;
+
+    for (G4int k = 0; k < kNbDoseRegions; ++k) {
+        if (!(fSettings.regionMask & (1u << k))) continue;
+        const G4double r = RelativeError(doseSums[2*k], doseSums[2*k + 1], fEvents);
+        if (r < 0.) return -1.;
+        worst = std::max(worst, r);
+        any = true;
+    }
+
+    if (fSettings.planeIndex >= 0 && fSettings.planeIndex < VolumeRoleRegistry::kNbScorePlanes) {
+        const G4double sumW  = planePrimWeights[4*fSettings.planeIndex + 2];
+        const G4double sumW2 = planePrimWeights[4*fSettings.planeIndex + 3];
+        if (sumW <= 0.) return -1.;
+        worst = std::max(worst, std::sqrt(sumW2) / sumW);
+        any = true;
+    }
+
+    return any ? worst : -1.;
+}
+
+void ConvergenceMonitor::EndOfEvent(const ArrayAccumulable<G4double>& doseSums,
+                                    const ArrayAccumulable<G4double>& planePrimWeights)
+{
+    if (!fSettings.enabled || fStopReason != kNotStopped) return;
+
+    ++fEvents;
+    if (fEvents < fSettings.minEvents || fEvents % fSettings.checkEvery != 0) return;
+
+    fLastRelErr = WorstRelativeError(doseSums, planePrimWeights);
+    const G4double elapsed = std::chrono::duration<G4double>(std::chrono::steady_clock::now() - fStart).count();
+
+    if (fLastRelErr >= 0. && fLastRelErr <= fSettings.targetRelErr) {
+        fStopReason = kConverged;
+    } else if (fSettings.maxTime_s > 0. && elapsed >= fSettings.maxTime_s) {
+        fStopReason = kTimeBudget;
+    } else {
+        return;
+    }
+
+    G4cout << ThreadTag() << " [CONV] " << (fStopReason == kConverged ? "Cible atteinte" : "Budget de temps épuisé")
+           << " après " << fEvents << " événements (" << elapsed << " s), R max = "
+           << (fLastRelErr >= 0. ? 100. * fLastRelErr : -1.) << " % -> AbortRun" << G4endl;
+
+    // Arrêt doux : l'événement courant est terminé, EndOfRunAction est appelé normalement
+    G4RunManager::GetRunManager()->AbortRun(true);
+}
+
+void ConvergenceMonitor::EndRun() const
+{
+    if (!fSettings.enabled || fEvents == 0) return;
+
+    const char* status = (fStopReason == kConverged)  ? "convergé"
+                       : (fStopReason == kTimeBudget) ? "budget de temps épuisé"
+                                                      : "plafond /run/beamOn atteint (cible non atteinte)";
+    G4cout << ThreadTag() << " [CONV] " << fEvents << " événements, " << status
+           << ", dernier R max = " << (fLastRelErr >= 0. ? 100. * fLastRelErr : -1.) << " %" << G4endl;
+}
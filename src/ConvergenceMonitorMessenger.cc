@@ -0,0 +1,116 @@
+#include "ConvergenceMonitorMessenger.hh"
+#include "ConvergenceMonitor.hh"
+#include "VolumeRoleRegistry.hh"
+
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIdirectory.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+
+#include <sstream>
+
+ConvergenceMonitorMessenger::ConvergenceMonitorMessenger(ConvergenceMonitor* monitor)
+: fMonitor(monitor)
+{
+    fDir = new G4UIdirectory("/convergence/");
+    fDir->SetGuidance("Arrêt automatique du run sur incertitude cible (/run/beamOn N = plafond).");
+
+    fEnableCmd = new G4UIcmdWithABool("/convergence/enable", this);
+    fEnableCmd->SetGuidance("Active / désactive l'arrêt sur incertitude (défaut : false)");
+    fEnableCmd->SetParameterName("enable", false);
+    fEnableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fTargetCmd = new G4UIcmdWithADouble("/convergence/targetRelErr", this);
+    fTargetCmd->SetGuidance("Erreur relative cible (ex. 0.01 = 1 %) pour toutes les régions suivies");
+    fTargetCmd->SetParameterName("relErr", false);
+    fTargetCmd->SetRange("relErr > 0 && relErr < 1");
+    fTargetCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fRegionsCmd = new G4UIcmdWithAString("/convergence/regions", this);
+    fRegionsCmd->SetGuidance("Doses suivies : liste d'anneaux (0..4) et/ou 'total' ; 'none' : aucune");
+    fRegionsCmd->SetGuidance("ex. /convergence/regions 0 1 total");
+    fRegionsCmd->SetParameterName("regions", false);
+    fRegionsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fPlaneCmd = new G4UIcmdWithAString("/convergence/plane", this);
+    fPlaneCmd->SetGuidance("Plan de comptage suivi (primaires transmises, R = 1/sqrt(N)) ; 'none' : aucun");
+    fPlaneCmd->SetGuidance("ScorePlane, ScorePlane2, ScorePlane3 ou ScorePlane5 (préfixe 'logic' accepté)");
+    fPlaneCmd->SetParameterName("plane", false);
+    fPlaneCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fCheckEveryCmd = new G4UIcmdWithAnInteger("/convergence/checkEvery", this);
+    fCheckEveryCmd->SetGuidance("Taille des lots : critère évalué tous les N événements (par thread)");
+    fCheckEveryCmd->SetParameterName("nEvents", false);
+    fCheckEveryCmd->SetRange("nEvents >= 1");
+    fCheckEveryCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fMinEventsCmd = new G4UIcmdWithAnInteger("/convergence/minEvents", this);
+    fMinEventsCmd->SetGuidance("Nombre minimal d'événements avant tout arrêt (estimateur de variance fiable)");
+    fMinEventsCmd->SetParameterName("nEvents", false);
+    fMinEventsCmd->SetRange("nEvents >= 2");
+    fMinEventsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fMaxTimeCmd = new G4UIcmdWithADoubleAndUnit("/convergence/maxTime", this);
+    fMaxTimeCmd->SetGuidance("Budget de temps réel du run (0 : illimité)");
+    fMaxTimeCmd->SetParameterName("time", false);
+    fMaxTimeCmd->SetRange("time >= 0");
+    fMaxTimeCmd->SetDefaultUnit("s");
+    fMaxTimeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+ConvergenceMonitorMessenger::~ConvergenceMonitorMessenger()
+{
+    delete fEnableCmd;
+    delete fTargetCmd;
+    delete fRegionsCmd;
+    delete fPlaneCmd;
+    delete fCheckEveryCmd;
+    delete fMinEventsCmd;
+    delete fMaxTimeCmd;
+    delete fDir;
+}
+
+void ConvergenceMonitorMessenger::SetNewValue(G4UIcommand* command, G4String value)
+{
+    auto& settings = fMonitor->GetSettings();
+
+    if (command == fEnableCmd) {
+        settings.enabled = fEnableCmd->GetNewBoolValue(value);
+    } else if (command == fTargetCmd) {
+        settings.targetRelErr = fTargetCmd->GetNewDoubleValue(value);
+    } else if (command == fCheckEveryCmd) {
+        settings.checkEvery = fCheckEveryCmd->GetNewIntValue(value);
+    } else if (command == fMinEventsCmd) {
+        settings.minEvents = fMinEventsCmd->GetNewIntValue(value);
+    } else if (command == fMaxTimeCmd) {
+        settings.maxTime_s = fMaxTimeCmd->GetNewDoubleValue(value) / s;
+    } else if (command == fRegionsCmd) {
+        unsigned mask = 0;
+        std::istringstream is(value);
+        std::string token;
+        while (is >> token) {
+            if (token == "none") { mask = 0; continue; }
+            if (token == "total") { mask |= 1u << ConvergenceMonitor::kTotalWaterRegion; continue; }
+            const G4int ring = (token.size() == 1) ? token[0] - '0' : -1;
+            if (ring >= 0 && ring < ConvergenceMonitor::kTotalWaterRegion) {
+                mask |= 1u << ring;
+            } else {
+                G4cerr << "[CONV][WARN] Région inconnue '" << token << "' ignorée (0..4 ou total)" << G4endl;
+            }
+        }
+        settings.regionMask = mask;
+    } else if (command == fPlaneCmd) {
+        settings.planeIndex = -1;
+        if (value == "none") return;
+        for (G4int p = 0; p < VolumeRoleRegistry::kNbScorePlanes; ++p) {
+            const G4String lvName = VolumeRoleRegistry::GetScorePlaneName(p);
+            if (value == lvName || "logic" + value == lvName) settings.planeIndex = p;
+        }
+        if (settings.planeIndex < 0)
+            G4cerr << "[CONV][WARN] Plan inconnu '" << value << "' : aucun plan suivi" << G4endl;
+    }
+}
@@ -21,19 +21,27 @@
 
 // SphereSurfaceSD.hh supprimé (sphère supprimée)
 #include "SurfaceSpectrumSD.hh"
-#include "ScorePlane2SD.hh"
-#include "ScorePlane3SD.hh"
-#include "ScorePlane4SD.hh"
-#include "ScorePlane5SD.hh"
-// ScorePlane6SD supprimé
+#include "PlaneCrossingSD.hh"
 
 #include "G4AnalysisManager.hh"
 #include "G4UserLimits.hh"
 
 #include "G4LogicalVolumeStore.hh"
+#include "G4PhysicalVolumeStore.hh"
 #include "G4Material.hh"
+#include "VolumeRoleRegistry.hh"
+#include "VirtualPlaneScorer.hh"
+#include "AnalysisManagerSetup.hh"
+#include "ScoringParallelWorld.hh"
+#include "G4ParallelWorldPhysics.hh"
+#include "ImportanceParallelWorld.hh"
+#include "ImportanceMessenger.hh"
+#include "G4GeometrySampler.hh"
+#include "G4ImportanceBiasing.hh"
+#include "G4VModularPhysicsList.hh"
 #include <set>
 #include <string>
+#include <vector>
 
 // NOUVEAU : Pour accéder au solide et calculer la bounding box
 #include "G4VSolid.hh"
@@ -48,6 +56,7 @@ DetectorConstruction::DetectorConstruction()
         fisGDML         = true;
 
         fMessenger = new DetectorMessenger(this);
+        fImportanceMessenger = new ImportanceMessenger(this);
 
         DefineMaterial();
 
@@ -66,6 +75,8 @@ DetectorConstruction::DetectorConstruction()
 DetectorConstruction::~DetectorConstruction()
 {
        delete fMessenger ;
+       delete fImportanceMessenger;
+       delete fImportanceSampler;
 }
 
 void DetectorConstruction::SetGDML(const G4bool isGDML ){
@@ -73,6 +84,83 @@ void DetectorConstruction::SetGDML(const G4bool isGDML ){
         G4RunManager::GetRunManager()->ReinitializeGeometry();
 }
 
+void DetectorConstruction::SetScoringMode(ScoringMode mode)
+{
+        // Pris en compte à la construction (commande /detector/scoringMode en PreInit)
+        fScoringMode = mode;
+        G4cout << "[GEOM] Scoring mode = "
+               << (mode == kScoringVirtual ? "virtual" : mode == kScoringParallel ? "parallel" : "volume") << G4endl;
+
+        // Monde parallèle de scoring : enregistré une seule fois, avec son G4ParallelWorldPhysics
+        // (non "layered" : les matériaux restent ceux du monde de masse)
+        if (mode == kScoringParallel && !fScoringWorld) {
+                fScoringWorld = new ScoringParallelWorld(ScoringParallelWorld::kWorldName, this);
+                RegisterParallelWorld(fScoringWorld);
+
+                auto* physics = dynamic_cast<G4VModularPhysicsList*>(
+                        const_cast<G4VUserPhysicsList*>(G4RunManager::GetRunManager()->GetUserPhysicsList()));
+                if (physics) {
+                        physics->RegisterPhysics(new G4ParallelWorldPhysics(ScoringParallelWorld::kWorldName, false));
+                } else {
+                        G4Exception("DetectorConstruction::SetScoringMode", "SCORE01", FatalException,
+                                    "Liste de physique modulaire absente : impossible d'enregistrer G4ParallelWorldPhysics.");
+                }
+        }
+}
+
+void DetectorConstruction::AddImportanceRegion(const G4String& name, G4double zMin, G4double zMax, G4double importance)
+{
+        // Monde parallèle d'importance : enregistré une seule fois, avec G4ImportanceBiasing pour
+        // les photons. Pas de G4ParallelWorldPhysics : G4ImportanceProcess navigue lui-même
+        // dans le monde parallèle. Le monde fantôme n'existe pas encore en PreInit : le G4GeometrySampler
+        // est créé sans volume et G4ImportanceBiasing le rattache au G4IStore du monde à l'initialisation.
+        if (!fImportanceWorld) {
+                auto* physics = dynamic_cast<G4VModularPhysicsList*>(
+                        const_cast<G4VUserPhysicsList*>(G4RunManager::GetRunManager()->GetUserPhysicsList()));
+                if (!physics) {
+                        G4Exception("DetectorConstruction::AddImportanceRegion", "IMP02", FatalException,
+                                    "Liste de physique modulaire absente : impossible d'enregistrer G4ImportanceBiasing.");
+                        return;
+                }
+
+                fImportanceWorld = new ImportanceParallelWorld(ImportanceParallelWorld::kWorldName);
+                RegisterParallelWorld(fImportanceWorld);
+
+                fImportanceSampler = new G4GeometrySampler(static_cast<G4VPhysicalVolume*>(nullptr), "gamma");
+                fImportanceSampler->SetParallel(true);
+                physics->RegisterPhysics(new G4ImportanceBiasing(fImportanceSampler, ImportanceParallelWorld::kWorldName));
+
+                G4cout << "[GEOM] Importance géométrique des photons activée (monde parallèle "
+                       << ImportanceParallelWorld::kWorldName << ")" << G4endl;
+        }
+
+        fImportanceWorld->AddRegion(name, zMin, zMax, importance);
+}
+
+void DetectorConstruction::SetRegionImportance(const G4String& name, G4double importance)
+{
+        if (!fImportanceWorld) {
+                G4cerr << "[GEOM][IMP][WARN] Aucune région d'importance déclarée (/importance/region)" << G4endl;
+                return;
+        }
+        fImportanceWorld->SetImportance(name, importance);
+}
+
+void DetectorConstruction::SetOutsideImportance(G4double importance)
+{
+        if (!fImportanceWorld) {
+                G4cerr << "[GEOM][IMP][WARN] Aucune région d'importance déclarée (/importance/region)" << G4endl;
+                return;
+        }
+        fImportanceWorld->SetOutsideImportance(importance);
+}
+
+void DetectorConstruction::PrintImportanceRegions() const
+{
+        if (fImportanceWorld) fImportanceWorld->Print();
+        else G4cout << "[GEOM][IMP] Biaisage d'importance inactif" << G4endl;
+}
+
 void DetectorConstruction::DefineMaterial()
 {
         G4NistManager *nist = G4NistManager::Instance();
@@ -244,68 +332,102 @@ void DetectorConstruction::ConstructGDML()
         logicEnveloppe->SetVisAttributes(visAttrEnveloppe);
 
 
-        // Plan de scoring à z = +2 mm (juste après le porte collimateur)
+        // -------------------------------------------------------------------
+        // Plans de comptage : boîtes d'air minces (mode "volume", historique)
+        // ou plans virtuels détectés dans le SteppingAction (mode "virtual",
+        // ni volume ni G4UserLimits, cf. VirtualPlaneScorer)
+        // -------------------------------------------------------------------
+        const G4bool buildPlaneVolumes = (fScoringMode == kScoringVolume);
+        VirtualPlaneScorer::ClearPlanes();
+        fScoringPlanes.clear();
 
         // épaisseur ultra-fine du plan (à ajuster si nécessaire)
         const G4double tPlane = 1.0*um;
 
-        // Solide/logique du plan
-        solidScorePlane = new G4Box("solidScorePlane", hx, hy, tPlane/2.0);
-        logicScorePlane = new G4LogicalVolume(solidScorePlane, MyAir, "logicScorePlane");
-
-        // Placement à z = +18 mm
-        physScorePlane = new G4PVPlacement(0,
-                        G4ThreeVector(0., 0., +18.0*mm), // centre du plan
-                        logicScorePlane,
-                        "physScorePlane",
-                        logicEnveloppe,   // parent = enveloppe
-                        false,
-                        0,
-                        true);
-
-        auto vis = new G4VisAttributes(G4Colour(1.,0.,0.,1.0)); // rouge opaque
-        vis->SetForceSolid(true);
-        logicScorePlane->SetVisAttributes(vis);
-
-        // -------------------------------------------------------------------
-        // Plan de comptage supplémentaire à z = +10 mm apres le premier plan
-        // Parallélépipède : demi-dimensions x=5cm, y=5cm, z=1mm
-        // -------------------------------------------------------------------
+        // Demi-dimensions communes des plans 2, 3 et 5
         const G4double hxPlane2 = 5.0*cm;   // demi-dimension X = 50 mm
         const G4double hyPlane2 = 5.0*cm;   // demi-dimension Y = 50 mm
         const G4double hzPlane2 = 0.5*mm;   // demi-dimension Z = 0.5 mm
 
-        G4Box* solidScorePlane2 = new G4Box("solidScorePlane2", hxPlane2, hyPlane2, hzPlane2);
-        G4LogicalVolume* logicScorePlane2 = new G4LogicalVolume(solidScorePlane2, MyAir, "logicScorePlane2");
-
-        new G4PVPlacement(0,
-                        G4ThreeVector(0., 0., +28.0*mm), // centre à z = 28 mm
-                        logicScorePlane2,
-                        "physScorePlane2",
-                        logicEnveloppe,   // parent = enveloppe
-                        false,
-                        0,
-                        true);
-
-        // Même couleur rouge opaque que le plan de scoring
-        auto vis2 = new G4VisAttributes(G4Colour(1.,0.,0.,1.0)); // rouge opaque
-        vis2->SetForceSolid(true);
-        logicScorePlane2->SetVisAttributes(vis2);
-
-
-        // -------------------------------------------------------------------
-        // Plans de comptage supplémentaires à z = 2cm, 4cm, 6cm, 8cm, 10cm apres le premier plan
-        // Mêmes dimensions : demi-x=5cm, demi-y=5cm, demi-z=0.5mm
-        // Note : les plans à cm, cm et 1cm dépassent l'enveloppe (±60mm)
-        //        donc ils sont placés dans logicWorld
-        // -------------------------------------------------------------------
+        // Hors mode "volume" : description du plan, utilisée par VirtualPlaneScorer (virtual)
+        // ou par ScoringParallelWorld pour placer les volumes fantômes (parallel)
+        auto addVirtualPlane = [this](const G4String& sdName, G4int planeIndex,
+                                      G4double zCenter, G4double halfZ, G4double halfX, G4double halfY) {
+                VirtualPlane plane;
+                plane.sdName     = sdName;
+                plane.planeIndex = planeIndex;
+                plane.zMin       = zCenter - halfZ;
+                plane.zMax       = zCenter + halfZ;
+                plane.hx         = halfX;
+                plane.hy         = halfY;
+                fScoringPlanes.push_back(plane);
+                if (fScoringMode == kScoringVirtual) VirtualPlaneScorer::AddPlane(plane);
+                G4cout << "[GEOM][" << (fScoringMode == kScoringVirtual ? "VIRTUAL" : "PARALLEL") << "] "
+                       << sdName << " : z ∈ [" << plane.zMin/mm << ", " << plane.zMax/mm << "] mm" << G4endl;
+        };
+
+        if (buildPlaneVolumes) {
+                // Plan de scoring à z = +2 mm (juste après le porte collimateur)
+
+                // Solide/logique du plan
+                solidScorePlane = new G4Box("solidScorePlane", hx, hy, tPlane/2.0);
+                logicScorePlane = new G4LogicalVolume(solidScorePlane, MyAir, "logicScorePlane");
+
+                // Placement à z = +18 mm
+                physScorePlane = new G4PVPlacement(0,
+                                G4ThreeVector(0., 0., +18.0*mm), // centre du plan
+                                logicScorePlane,
+                                "physScorePlane",
+                                logicEnveloppe,   // parent = enveloppe
+                                false,
+                                0,
+                                true);
+
+                auto vis = new G4VisAttributes(G4Colour(1.,0.,0.,1.0)); // rouge opaque
+                vis->SetForceSolid(true);
+                logicScorePlane->SetVisAttributes(vis);
+
+                // -------------------------------------------------------------------
+                // Plan de comptage supplémentaire à z = +10 mm apres le premier plan
+                // Parallélépipède : demi-dimensions x=5cm, y=5cm, z=1mm
+                // -------------------------------------------------------------------
+
+                G4Box* solidScorePlane2 = new G4Box("solidScorePlane2", hxPlane2, hyPlane2, hzPlane2);
+                G4LogicalVolume* logicScorePlane2 = new G4LogicalVolume(solidScorePlane2, MyAir, "logicScorePlane2");
+
+                new G4PVPlacement(0,
+                                G4ThreeVector(0., 0., +28.0*mm), // centre à z = 28 mm
+                                logicScorePlane2,
+                                "physScorePlane2",
+                                logicEnveloppe,   // parent = enveloppe
+                                false,
+                                0,
+                                true);
+
+                // Même couleur rouge opaque que le plan de scoring
+                auto vis2 = new G4VisAttributes(G4Colour(1.,0.,0.,1.0)); // rouge opaque
+                vis2->SetForceSolid(true);
+                logicScorePlane2->SetVisAttributes(vis2);
+
+
+                // -------------------------------------------------------------------
+                // Plans de comptage supplémentaires à z = 2cm, 4cm, 6cm, 8cm, 10cm apres le premier plan
+                // Mêmes dimensions : demi-x=5cm, demi-y=5cm, demi-z=0.5mm
+                // Note : les plans à cm, cm et 1cm dépassent l'enveloppe (±60mm)
+                //        donc ils sont placés dans logicWorld
+                // -------------------------------------------------------------------
         
-        // Plan à z = 2 cm apres le premier plan de scoring (dans enveloppe)
-        G4Box* solidScorePlane3 = new G4Box("solidScorePlane3", hxPlane2, hyPlane2, hzPlane2);
-        G4LogicalVolume* logicScorePlane3 = new G4LogicalVolume(solidScorePlane3, MyAir, "logicScorePlane3");
-        new G4PVPlacement(0, G4ThreeVector(0., 0., +38.0*mm), logicScorePlane3,
-                          "physScorePlane3", logicEnveloppe, false, 0, true);
-        logicScorePlane3->SetVisAttributes(vis2);
+                // Plan à z = 2 cm apres le premier plan de scoring (dans enveloppe)
+                G4Box* solidScorePlane3 = new G4Box("solidScorePlane3", hxPlane2, hyPlane2, hzPlane2);
+                G4LogicalVolume* logicScorePlane3 = new G4LogicalVolume(solidScorePlane3, MyAir, "logicScorePlane3");
+                new G4PVPlacement(0, G4ThreeVector(0., 0., +38.0*mm), logicScorePlane3,
+                                  "physScorePlane3", logicEnveloppe, false, 0, true);
+                logicScorePlane3->SetVisAttributes(vis2);
+        } else {
+                addVirtualPlane("SpecSD",        0, +18.0*mm, tPlane/2.0, hx, hy);
+                addVirtualPlane("ScorePlane2SD", 1, +28.0*mm, hzPlane2, hxPlane2, hyPlane2);
+                addVirtualPlane("ScorePlane3SD", 2, +38.0*mm, hzPlane2, hxPlane2, hyPlane2);
+        }
 
         // ==========================================================================
         // NOUVEAU : Système de couronnes d'eau concentriques + conteneur PVC
@@ -373,38 +495,57 @@ void DetectorConstruction::ConstructGDML()
         logicPVCBottom->SetVisAttributes(visPVC);
         logicPVCWall->SetVisAttributes(visPVC);
         
-        // --- Couronnes d'eau concentriques ---
-        // Palette de couleurs : dégradé de bleu (clair au centre, foncé à l'extérieur)
-        const G4double blueShades[kNbWaterRings] = {0.5, 0.625, 0.75, 0.875, 1.0};
+        // Géométrie des couronnes (reprise par ScoringParallelWorld en mode "parallel")
+        fWaterRingRadialStep = ringRadialThick;
+        fWaterRingHalfZ      = waterThickness/2.0;
+        fWaterRingCenterZ    = zWaterCenter;
+
+        if (fScoringMode == kScoringParallel) {
+                // --- Mode "parallel" : un seul disque d'eau dans le monde de masse,
+                //     les couronnes de scoring sont des volumes fantômes du monde parallèle ---
+                auto* solidWaterDisk = new G4Tubs("solidWaterDisk", 0., waterRadius,
+                                                  waterThickness/2.0, 0, 360*deg);
+                auto* logicWaterDisk = new G4LogicalVolume(solidWaterDisk, MyWater, "logicWaterDisk");
+                new G4PVPlacement(0, G4ThreeVector(0., 0., zWaterCenter), logicWaterDisk,
+                                  "physWaterDisk", logicWorld, false, 0, true);
+                auto visDisk = new G4VisAttributes(G4Colour(0.0, 0.3, 0.75, 0.6));
+                visDisk->SetForceSolid(true);
+                logicWaterDisk->SetVisAttributes(visDisk);
+                G4cout << "[GEOM] Water disk (mass world): r = [0, " << waterRadius/mm << "] mm" << G4endl;
+        } else {
+                // --- Couronnes d'eau concentriques ---
+                // Palette de couleurs : dégradé de bleu (clair au centre, foncé à l'extérieur)
+                const G4double blueShades[kNbWaterRings] = {0.5, 0.625, 0.75, 0.875, 1.0};
         
-        for (G4int i = 0; i < kNbWaterRings; i++) {
-            G4double rMin = i * ringRadialThick;
-            G4double rMax = (i + 1) * ringRadialThick;
+                for (G4int i = 0; i < kNbWaterRings; i++) {
+                    G4double rMin = i * ringRadialThick;
+                    G4double rMax = (i + 1) * ringRadialThick;
             
-            G4String solidName = "solidWaterRing" + std::to_string(i);
-            G4String logicName = "logicWaterRing" + std::to_string(i);
-            G4String physName = "physWaterRing" + std::to_string(i);
+                    G4String solidName = "solidWaterRing" + std::to_string(i);
+                    G4String logicName = "logicWaterRing" + std::to_string(i);
+                    G4String physName = "physWaterRing" + std::to_string(i);
             
-            solidWaterRing[i] = new G4Tubs(solidName,
-                                            rMin,                    // rayon interne
-                                            rMax,                    // rayon externe
-                                            waterThickness/2.0,      // demi-épaisseur Z = 1.5 mm
-                                            0, 360*deg);
+                    solidWaterRing[i] = new G4Tubs(solidName,
+                                                    rMin,                    // rayon interne
+                                                    rMax,                    // rayon externe
+                                                    waterThickness/2.0,      // demi-épaisseur Z = 1.5 mm
+                                                    0, 360*deg);
             
-            logicWaterRing[i] = new G4LogicalVolume(solidWaterRing[i], MyWater, logicName);
+                    logicWaterRing[i] = new G4LogicalVolume(solidWaterRing[i], MyWater, logicName);
             
-            physWaterRing[i] = new G4PVPlacement(0,
-                                                  G4ThreeVector(0., 0., zWaterCenter),
-                                                  logicWaterRing[i],
-                                                  physName,
-                                                  logicWorld, false, 0, true);
+                    physWaterRing[i] = new G4PVPlacement(0,
+                                                          G4ThreeVector(0., 0., zWaterCenter),
+                                                          logicWaterRing[i],
+                                                          physName,
+                                                          logicWorld, false, 0, true);
             
-            // Attributs visuels : dégradé de bleu
-            auto visRing = new G4VisAttributes(G4Colour(0.0, 0.3, blueShades[i], 0.6));
-            visRing->SetForceSolid(true);
-            logicWaterRing[i]->SetVisAttributes(visRing);
+                    // Attributs visuels : dégradé de bleu
+                    auto visRing = new G4VisAttributes(G4Colour(0.0, 0.3, blueShades[i], 0.6));
+                    visRing->SetForceSolid(true);
+                    logicWaterRing[i]->SetVisAttributes(visRing);
             
-            G4cout << "[GEOM] Water Ring " << i << ": r = [" << rMin/mm << ", " << rMax/mm << "] mm" << G4endl;
+                    G4cout << "[GEOM] Water Ring " << i << ": r = [" << rMin/mm << ", " << rMax/mm << "] mm" << G4endl;
+                }
         }
         
         G4cout << "[GEOM] === End Water Rings System ===" << G4endl;
@@ -413,11 +554,17 @@ void DetectorConstruction::ConstructGDML()
         // ==========================================================================
 
         // Plan de comptage ScorePlane5 à z = 70 mm (juste après le conteneur PVC)
-        G4Box* solidScorePlane5 = new G4Box("solidScorePlane5", hxPlane2, hyPlane2, hzPlane2);
-        G4LogicalVolume* logicScorePlane5 = new G4LogicalVolume(solidScorePlane5, MyAir, "logicScorePlane5");
-        new G4PVPlacement(0, G4ThreeVector(0., 0., +70*mm), logicScorePlane5,
-                          "physScorePlane5", logicWorld, false, 0, true);
-        logicScorePlane5->SetVisAttributes(vis2);
+        if (buildPlaneVolumes) {
+                G4Box* solidScorePlane5 = new G4Box("solidScorePlane5", hxPlane2, hyPlane2, hzPlane2);
+                G4LogicalVolume* logicScorePlane5 = new G4LogicalVolume(solidScorePlane5, MyAir, "logicScorePlane5");
+                new G4PVPlacement(0, G4ThreeVector(0., 0., +70*mm), logicScorePlane5,
+                                  "physScorePlane5", logicWorld, false, 0, true);
+                auto vis5 = new G4VisAttributes(G4Colour(1.,0.,0.,1.0)); // rouge opaque
+                vis5->SetForceSolid(true);
+                logicScorePlane5->SetVisAttributes(vis5);
+        } else {
+                addVirtualPlane("ScorePlane5SD", 3, +70.0*mm, hzPlane2, hxPlane2, hyPlane2);
+        }
 
         // ScorePlane6 supprimé (était à z = +168 mm)
         // Cube de conversion et sphère de comptage supprimés définitivement
@@ -894,6 +1041,9 @@ G4VPhysicalVolume *DetectorConstruction::Construct()
                         G4cout << "[GEOM] Envelope: z ∈ [-60, +60] mm" << G4endl;
         }
 
+        // Registre des rôles de volumes (lookup par pointeur dans le SteppingAction)
+        VolumeRoleRegistry::Build();
+
         return physWorld;
 }
 
@@ -920,9 +1070,23 @@ void DetectorConstruction::ConstructSDandField()
         auto* specSD = new SurfaceSpectrumSD("SpecSD", Emin_keV, Emax_keV, nBins, onlyOutward);
         sdManager->AddNewDetector(specSD);
 
+        // Mode "volume" : boîtes minces + SD + limites de pas ; mode "virtual" : les SD sont
+        // créés sans volume et alimentés par VirtualPlaneScorer depuis le SteppingAction ;
+        // mode "parallel" : SD créés ici, attachés aux volumes fantômes par ScoringParallelWorld
+        const G4bool planeVolumes = (fScoringMode == kScoringVolume);
+
+        // Volume physique du plan (comparaison de pointeurs dans ProcessHits)
+        if (planeVolumes) {
+                specSD->SetPlaneVolume(physScorePlane ? physScorePlane
+                                       : G4PhysicalVolumeStore::GetInstance()->GetVolume("physScorePlane", /*verbose=*/false));
+        }
+
         // Brancher le ntuple "plane_passages" créé dans SetupAnalysis
         extern int GetPlanePassageNtupleId();
 
+        specSD->SetSpectrumH1Ids(GetSpectrumH1Id(kSpectrumScorePlane, false),
+                                 GetSpectrumH1Id(kSpectrumScorePlane, true));
+
         const int pid = GetPlanePassageNtupleId();
         if (pid >= 0) {
                 specSD->SetPassageNtupleId(pid);
@@ -949,6 +1113,11 @@ void DetectorConstruction::ConstructSDandField()
                         G4cout << "[FIX][ERROR] LV 'logicScorePlane' not found in LogicalVolumeStore!" << G4endl;
                 }
         }
+        } else {
+                // Modes "virtual" / "parallel" : dimensions du plan décrit dans ConstructGDML
+                for (const auto& plane : fScoringPlanes) {
+                        if (plane.sdName == "SpecSD") specSD->SetArea_cm2(4.0 * (plane.hx/cm) * (plane.hy/cm));
+                }
         }
 
 
@@ -967,143 +1136,96 @@ void DetectorConstruction::ConstructSDandField()
         auto* sd = logicScorePlane->GetSensitiveDetector();
         if (sd) G4cout << "[DEBUG] logicScorePlane SD = " << sd->GetName() << G4endl;
         else G4cout << "[WARN] logicScorePlane nul : SpecSD non attaché." << G4endl;
-        } else {
+        } else if (planeVolumes) {
                 G4cout << "[ERROR] logicScorePlane nul : SD plan non attaché." << G4endl;
         }
 
         // =====================================================
-        // SD pour le plan de comptage ScorePlane2 (z = 8 mm)
+        // SD de passage de plan (PlaneCrossingSD générique)
+        // Un plan = (nom du SD, ntuple, volumes logiques à rendre sensibles,
+        // volumes physiques cibles). Ajouter un plan = ajouter une entrée ici ;
+        // la règle d'acceptation se règle ensuite via /scoring/<nomSD>/...
         // =====================================================
         extern int GetScorePlane2NtupleId();
-        
-        auto* scorePlane2SD = new ScorePlane2SD("ScorePlane2SD");
-        sdManager->AddNewDetector(scorePlane2SD);
-        
-        // Connecter au ntuple
-        const int sp2id = GetScorePlane2NtupleId();
-        if (sp2id >= 0) {
-                scorePlane2SD->SetNtupleId(sp2id);
-                G4cout << "[ANALYSIS] ScorePlane2SD ntupleId preset at construction: " << sp2id << G4endl;
-        } else {
-                G4cout << "[ANALYSIS] ScorePlane2_passages ntupleId not ready at construction (id=" << sp2id
-                       << ") — will be set at BeginOfRunAction." << G4endl;
-        }
-        
-        // Attacher au volume logique ScorePlane2
-        auto* lvScorePlane2 = G4LogicalVolumeStore::GetInstance()->GetVolume("logicScorePlane2", /*verbose=*/false);
-        if (lvScorePlane2) {
-                lvScorePlane2->SetSensitiveDetector(scorePlane2SD);
-                G4cout << "[SD] Attached ScorePlane2SD to " << lvScorePlane2->GetName() << G4endl;
-                
-                // Limite de pas pour ne pas "sauter" le volume
-                if (!lvScorePlane2->GetUserLimits()) {
-                        lvScorePlane2->SetUserLimits(new G4UserLimits(0.1*mm));
-                }
-        } else {
-                G4cout << "[ERROR] LV 'logicScorePlane2' not found in LogicalVolumeStore!" << G4endl;
-        }
-
-        // =====================================================
-        // SD pour le plan de comptage ScorePlane3 (z = 10 mm)
-        // =====================================================
         extern int GetScorePlane3NtupleId();
-        
-        auto* scorePlane3SD = new ScorePlane3SD("ScorePlane3SD");
-        sdManager->AddNewDetector(scorePlane3SD);
-        
-        // Connecter au ntuple
-        const int sp3id = GetScorePlane3NtupleId();
-        if (sp3id >= 0) {
-                scorePlane3SD->SetNtupleId(sp3id);
-                G4cout << "[ANALYSIS] ScorePlane3SD ntupleId preset at construction: " << sp3id << G4endl;
-        } else {
-                G4cout << "[ANALYSIS] ScorePlane3_passages ntupleId not ready at construction (id=" << sp3id
-                       << ") — will be set at BeginOfRunAction." << G4endl;
-        }
-        
-        // Attacher au volume logique ScorePlane3
-        auto* lvScorePlane3 = G4LogicalVolumeStore::GetInstance()->GetVolume("logicScorePlane3", /*verbose=*/false);
-        if (lvScorePlane3) {
-                lvScorePlane3->SetSensitiveDetector(scorePlane3SD);
-                G4cout << "[SD] Attached ScorePlane3SD to " << lvScorePlane3->GetName() << G4endl;
-                
-                // Limite de pas pour ne pas "sauter" le volume
-                if (!lvScorePlane3->GetUserLimits()) {
-                        lvScorePlane3->SetUserLimits(new G4UserLimits(0.1*mm));
+        extern int GetScorePlane4NtupleId();
+        extern int GetScorePlane5NtupleId();
+
+        auto* lvStoreSD = G4LogicalVolumeStore::GetInstance();
+        auto* pvStoreSD = G4PhysicalVolumeStore::GetInstance();
+
+        auto attachPlaneSD = [&](const G4String& sdName, G4int ntupleId, G4int spectrumPlane,
+                                 const std::vector<G4String>& lvNames,
+                                 const std::vector<const G4VPhysicalVolume*>& targets)
+        {
+                auto* planeSD = new PlaneCrossingSD(sdName);
+                sdManager->AddNewDetector(planeSD);
+                planeSD->SetSpectrumH1Ids(GetSpectrumH1Id(spectrumPlane, false), GetSpectrumH1Id(spectrumPlane, true));
+
+                if (ntupleId >= 0) {
+                        planeSD->SetNtupleId(ntupleId);
+                        G4cout << "[ANALYSIS] " << sdName << " ntupleId preset at construction: " << ntupleId << G4endl;
+                } else {
+                        G4cout << "[ANALYSIS] " << sdName << " ntupleId not ready at construction (id=" << ntupleId
+                               << ") — will be set at BeginOfRunAction." << G4endl;
                 }
-        } else {
-                G4cout << "[ERROR] LV 'logicScorePlane3' not found in LogicalVolumeStore!" << G4endl;
-        }
 
-        // =====================================================
-        // SD pour les couronnes d'eau (remplace ScorePlane4 à z = 68 mm)
-        // Le même SD est attaché à toutes les couronnes d'eau
-        // =====================================================
-        extern int GetScorePlane4NtupleId();
-        
-        auto* scorePlane4SD = new ScorePlane4SD("ScorePlane4SD");
-        sdManager->AddNewDetector(scorePlane4SD);
-        
-        // Connecter au ntuple (réutilise le ntuple ScorePlane4 pour les couronnes d'eau)
-        const int sp4id = GetScorePlane4NtupleId();
-        if (sp4id >= 0) {
-                scorePlane4SD->SetNtupleId(sp4id);
-                G4cout << "[ANALYSIS] ScorePlane4SD (WaterRings) ntupleId preset at construction: " << sp4id << G4endl;
-        } else {
-                G4cout << "[ANALYSIS] WaterRings ntupleId not ready at construction (id=" << sp4id
-                       << ") — will be set at BeginOfRunAction." << G4endl;
-        }
-        
-        // Attacher aux volumes logiques des couronnes d'eau
-        G4int nRingsAttached = 0;
-        for (G4int i = 0; i < kNbWaterRings; i++) {
-                G4String lvName = "logicWaterRing" + std::to_string(i);
-                auto* lvRing = G4LogicalVolumeStore::GetInstance()->GetVolume(lvName, /*verbose=*/false);
-                if (lvRing) {
-                        lvRing->SetSensitiveDetector(scorePlane4SD);
-                        G4cout << "[SD] Attached ScorePlane4SD to " << lvRing->GetName() << G4endl;
-                        
-                        if (!lvRing->GetUserLimits()) {
-                                lvRing->SetUserLimits(new G4UserLimits(0.1*mm));
+                for (const auto* pv : targets) planeSD->AddTargetVolume(pv);
+
+                G4int nAttached = 0;
+                for (const auto& lvName : lvNames) {
+                        auto* lv = lvStoreSD->GetVolume(lvName, /*verbose=*/false);
+                        if (!lv) {
+                                G4cout << "[ERROR] LV '" << lvName << "' not found in LogicalVolumeStore!" << G4endl;
+                                continue;
                         }
-                        nRingsAttached++;
+                        lv->SetSensitiveDetector(planeSD);
+                        // Limite de pas pour ne pas "sauter" le volume
+                        if (!lv->GetUserLimits()) {
+                                lv->SetUserLimits(new G4UserLimits(0.1*mm));
+                        }
+                        ++nAttached;
+                }
+                G4cout << "[SD] " << sdName << " attached to " << nAttached << "/" << lvNames.size()
+                       << " LV, " << planeSD->GetTargetVolumes().size() << " target PV" << G4endl;
+        };
+
+        auto planePV = [pvStoreSD](const G4String& pvName) -> const G4VPhysicalVolume* {
+                const G4VPhysicalVolume* pv = pvStoreSD->GetVolume(pvName, /*verbose=*/false);
+                if (!pv) G4cout << "[ERROR] PV '" << pvName << "' not found in PhysicalVolumeStore!" << G4endl;
+                return pv;
+        };
+
+        // Plan simple "ScorePlaneN" : volumes logicScorePlaneN / physScorePlaneN en mode "volume",
+        // aucun volume en mode "virtual"
+        auto attachScorePlaneSD = [&](const G4String& sdName, G4int ntupleId, G4int spectrumPlane,
+                                      const G4String& baseName) {
+                if (planeVolumes) {
+                        attachPlaneSD(sdName, ntupleId, spectrumPlane, {"logic" + baseName}, {planePV("phys" + baseName)});
                 } else {
-                        G4cout << "[WARN] LV '" << lvName << "' not found in LogicalVolumeStore!" << G4endl;
+                        attachPlaneSD(sdName, ntupleId, spectrumPlane, {}, {});
                 }
-        }
-        G4cout << "[SD] Total water rings with ScorePlane4SD attached: " << nRingsAttached << "/" << kNbWaterRings << G4endl;
+        };
 
-        // =====================================================
-        // SD pour le plan de comptage ScorePlane5 (z = 118 mm)
-        // =====================================================
-        extern int GetScorePlane5NtupleId();
-        
-        auto* scorePlane5SD = new ScorePlane5SD("ScorePlane5SD");
-        sdManager->AddNewDetector(scorePlane5SD);
-        
-        // Connecter au ntuple
-        const int sp5id = GetScorePlane5NtupleId();
-        if (sp5id >= 0) {
-                scorePlane5SD->SetNtupleId(sp5id);
-                G4cout << "[ANALYSIS] ScorePlane5SD ntupleId preset at construction: " << sp5id << G4endl;
-        } else {
-                G4cout << "[ANALYSIS] ScorePlane5_passages ntupleId not ready at construction (id=" << sp5id
-                       << ") — will be set at BeginOfRunAction." << G4endl;
-        }
-        
-        // Attacher au volume logique ScorePlane5
-        auto* lvScorePlane5 = G4LogicalVolumeStore::GetInstance()->GetVolume("logicScorePlane5", /*verbose=*/false);
-        if (lvScorePlane5) {
-                lvScorePlane5->SetSensitiveDetector(scorePlane5SD);
-                G4cout << "[SD] Attached ScorePlane5SD to " << lvScorePlane5->GetName() << G4endl;
-                
-                if (!lvScorePlane5->GetUserLimits()) {
-                        lvScorePlane5->SetUserLimits(new G4UserLimits(0.1*mm));
+        // ScorePlane2 (z = 8 mm) et ScorePlane3 (z = 10 mm)
+        attachScorePlaneSD("ScorePlane2SD", GetScorePlane2NtupleId(), kSpectrumScorePlane2, "ScorePlane2");
+        attachScorePlaneSD("ScorePlane3SD", GetScorePlane3NtupleId(), kSpectrumScorePlane3, "ScorePlane3");
+
+        // Couronnes d'eau (remplace ScorePlane4 à z = 68 mm) : un seul SD, entrée dans n'importe quel anneau
+        {
+                std::vector<G4String> ringLVs;
+                std::vector<const G4VPhysicalVolume*> ringPVs;
+                // Mode "parallel" : couronnes fantômes, SD attaché par ScoringParallelWorld::ConstructSD
+                for (G4int i = 0; fScoringMode != kScoringParallel && i < kNbWaterRings; i++) {
+                        ringLVs.push_back("logicWaterRing" + std::to_string(i));
+                        if (physWaterRing[i]) ringPVs.push_back(physWaterRing[i]);
                 }
-        } else {
-                G4cout << "[ERROR] LV 'logicScorePlane5' not found in LogicalVolumeStore!" << G4endl;
+                attachPlaneSD("ScorePlane4SD", GetScorePlane4NtupleId(), kSpectrumWaterRings, ringLVs, ringPVs);
         }
 
+        // ScorePlane5 (z = 118 mm)
+        attachScorePlaneSD("ScorePlane5SD", GetScorePlane5NtupleId(), kSpectrumScorePlane5, "ScorePlane5");
+
         // ScorePlane6 supprimé
 
         // =====================================================
@@ -1113,7 +1235,7 @@ void DetectorConstruction::ConstructSDandField()
         
         auto* lvStore = G4LogicalVolumeStore::GetInstance();
         
-        for (int i = 4; i <= 5; ++i) {
+        for (int i = 4; planeVolumes && i <= 5; ++i) {
                 G4String lvName = "logicScorePlane" + std::to_string(i);
                 auto* lv = lvStore->GetVolume(lvName, false);
                 if (lv) {
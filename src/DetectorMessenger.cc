@@ -2,6 +2,7 @@
 #include "G4UIcmdWithADoubleAndUnit.hh"
 #include "G4UIcmdWithAnInteger.hh"
 #include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
 #include "G4UIdirectory.hh"
 
 #include "DetectorConstruction.hh"
@@ -25,6 +26,14 @@ fDetector(det) {
     fPosSourcecmd = new G4UIcmdWithADoubleAndUnit("/detector/SetPosSource",this);
     fPosSourcecmd ->SetGuidance("Set The Source Position");
     fPosSourcecmd ->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+    fScoringModecmd = new G4UIcmdWithAString("/detector/scoringMode",this);
+    fScoringModecmd->SetGuidance("Plans de comptage : volume (boites minces + limites de pas)");
+    fScoringModecmd->SetGuidance("ou virtual (passages detectes dans le SteppingAction, sans volume)");
+    fScoringModecmd->SetGuidance("ou parallel (plans et couronnes dans un monde parallele de scoring)");
+    fScoringModecmd->SetParameterName("mode",false);
+    fScoringModecmd->SetCandidates("volume virtual parallel");
+    fScoringModecmd->AvailableForStates(G4State_PreInit);
 }
 
 DetectorMessenger::~DetectorMessenger(){
@@ -32,6 +41,7 @@ DetectorMessenger::~DetectorMessenger(){
     delete fPosSourcecmd;
     delete fisPetriBoxcmd;
     delete fisGDMLcmd;
+    delete fScoringModecmd;
 }
 
 void DetectorMessenger::SetNewValue(G4UIcommand* command,G4String newValue) {
@@ -41,6 +51,11 @@ void DetectorMessenger::SetNewValue(G4UIcommand* command,G4String newValue) {
         G4bool isGDML = fisGDMLcmd->GetNewBoolValue(newValue);
         fDetector->SetGDML(isGDML);
     }
+    if( command == fScoringModecmd ) {
+        if (newValue == "virtual")       fDetector->SetScoringMode(DetectorConstruction::kScoringVirtual);
+        else if (newValue == "parallel") fDetector->SetScoringMode(DetectorConstruction::kScoringParallel);
+        else                             fDetector->SetScoringMode(DetectorConstruction::kScoringVolume);
+    }
 
 
 }
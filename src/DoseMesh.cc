@@ -0,0 +1,191 @@
+#include "DoseMesh.hh"
+#include "DoseMeshMessenger.hh"
+
+#include "AnalysisManagerSetup.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4AccumulableManager.hh"
+#include "G4AnalysisManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4Navigator.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TransportationManager.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+
+namespace {
+    // Même conversion que RunAction : Dose [pGy] = Edep [keV] * 0.1602 / masse [g]
+    constexpr G4double kKeVToPGyPerGram = 0.1602;
+
+    // Sous-échantillonnage par axe pour la masse des voxels (matériaux de la géométrie)
+    constexpr G4int kMassSubSamples = 4;
+}
+
+DoseMesh::DoseMesh()
+: fEdep("DoseMeshEdep")
+{
+    fMessenger = new DoseMeshMessenger(this);
+}
+
+DoseMesh::~DoseMesh()
+{
+    delete fMessenger;
+}
+
+void DoseMesh::Register(G4AccumulableManager* accMgr)
+{
+    accMgr->Register(&fEdep);
+}
+
+void DoseMesh::BeginRun(G4bool isMaster)
+{
+    if (!fSpec.enabled) {
+        fEdep.Resize(0);
+        return;
+    }
+
+    // Bornes par défaut : disque d'eau (rayon = 5 couronnes, épaisseur d'eau en z)
+    if (fSpec.fromGeometry) {
+        const auto* detector = dynamic_cast<const DetectorConstruction*>(
+            G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+        if (detector) {
+            G4double radialStep = 0., halfZ = 0., zCenter = 0.;
+            detector->GetWaterRingGeometry(radialStep, halfZ, zCenter);
+            const G4double rMax = DetectorConstruction::kNbWaterRings * radialStep;
+            if (fSpec.type == kCylindrical) {
+                fSpec.min[0] = 0.;
+                fSpec.max[0] = rMax;
+                fSpec.min[1] = -pi;
+                fSpec.max[1] = pi;
+            } else {
+                fSpec.min[0] = fSpec.min[1] = -rMax;
+                fSpec.max[0] = fSpec.max[1] = rMax;
+            }
+            fSpec.min[2] = zCenter - halfZ;
+            fSpec.max[2] = zCenter + halfZ;
+        }
+    }
+
+    std::size_t nVoxels = 1;
+    for (G4int a = 0; a < 3; ++a) {
+        fSpec.n[a] = std::max(1, fSpec.n[a]);
+        const G4double width = (fSpec.max[a] - fSpec.min[a]) / fSpec.n[a];
+        fInvWidth[a] = (width > 0.) ? 1. / width : 0.;
+        nVoxels *= static_cast<std::size_t>(fSpec.n[a]);
+    }
+    fEdep.Resize(nVoxels);
+
+    // Binning des H3 identique sur tous les threads (fusion au Write())
+    auto* am = G4AnalysisManager::Instance();
+    const G4double unit1 = (fSpec.type == kCylindrical) ? deg : mm;
+    for (const G4int id : {GetDoseMeshH3Id(), GetDoseMeshMassH3Id()}) {
+        if (id < 0) continue;
+        am->SetH3(id,
+                  fSpec.n[0], fSpec.min[0]/mm,    fSpec.max[0]/mm,
+                  fSpec.n[1], fSpec.min[1]/unit1, fSpec.max[1]/unit1,
+                  fSpec.n[2], fSpec.min[2]/mm,    fSpec.max[2]/mm);
+    }
+
+    if (isMaster) {
+        ComputeVoxelMasses();
+        G4cout << "[DOSE][MESH] " << (fSpec.type == kCylindrical ? "cylindrique (r, phi, z)" : "cartésienne (x, y, z)")
+               << " : " << fSpec.n[0] << " x " << fSpec.n[1] << " x " << fSpec.n[2] << " voxels, z = ["
+               << fSpec.min[2]/mm << ", " << fSpec.max[2]/mm << "] mm" << G4endl;
+    }
+}
+
+// Masse de chaque voxel : somme ρ·dV sur une sous-grille, matériau localisé par un
+// navigateur dédié (le navigateur de tracking n'est pas touché)
+void DoseMesh::ComputeVoxelMasses()
+{
+    fMass_g.assign(fEdep.Size(), 0.);
+
+    auto* world = G4TransportationManager::GetTransportationManager()
+                      ->GetNavigatorForTracking()->GetWorldVolume();
+    if (!world) return;
+
+    G4Navigator navigator;
+    navigator.SetWorldVolume(world);
+
+    const G4double width[3] = {
+        (fSpec.max[0] - fSpec.min[0]) / fSpec.n[0],
+        (fSpec.max[1] - fSpec.min[1]) / fSpec.n[1],
+        (fSpec.max[2] - fSpec.min[2]) / fSpec.n[2]
+    };
+    const G4double sub[3] = {width[0] / kMassSubSamples, width[1] / kMassSubSamples, width[2] / kMassSubSamples};
+
+    for (G4int i0 = 0; i0 < fSpec.n[0]; ++i0)
+    for (G4int i1 = 0; i1 < fSpec.n[1]; ++i1)
+    for (G4int i2 = 0; i2 < fSpec.n[2]; ++i2) {
+        G4double mass = 0.;
+        for (G4int s0 = 0; s0 < kMassSubSamples; ++s0)
+        for (G4int s1 = 0; s1 < kMassSubSamples; ++s1)
+        for (G4int s2 = 0; s2 < kMassSubSamples; ++s2) {
+            const G4double a0 = fSpec.min[0] + i0 * width[0] + s0 * sub[0];
+            const G4double a1 = fSpec.min[1] + i1 * width[1] + (s1 + 0.5) * sub[1];
+            const G4double z  = fSpec.min[2] + i2 * width[2] + (s2 + 0.5) * sub[2];
+
+            G4ThreeVector pos;
+            G4double dV = 0.;
+            if (fSpec.type == kCylindrical) {
+                const G4double r1 = a0, r2 = a0 + sub[0];
+                const G4double rc = 0.5 * (r1 + r2);
+                pos.set(rc * std::cos(a1), rc * std::sin(a1), z);
+                dV = 0.5 * (r2*r2 - r1*r1) * sub[1] * sub[2];
+            } else {
+                pos.set(a0 + 0.5 * sub[0], a1, z);
+                dV = sub[0] * sub[1] * sub[2];
+            }
+
+            const G4VPhysicalVolume* pv = navigator.LocateGlobalPointAndSetup(pos, nullptr, false, true);
+            const G4Material* mat = pv ? pv->GetLogicalVolume()->GetMaterial() : nullptr;
+            if (mat) mass += mat->GetDensity() * dV;
+        }
+        fMass_g[static_cast<std::size_t>((i0 * fSpec.n[1] + i1) * fSpec.n[2] + i2)] = mass / g;
+    }
+}
+
+void DoseMesh::Write(G4int doseH3Id, G4int massH3Id) const
+{
+    if (!fSpec.enabled || fEdep.Size() == 0 || fMass_g.size() != fEdep.Size()) return;
+
+    auto* am = G4AnalysisManager::Instance();
+    const G4double unit1 = (fSpec.type == kCylindrical) ? deg : mm;
+
+    const G4double width[3] = {
+        (fSpec.max[0] - fSpec.min[0]) / fSpec.n[0],
+        (fSpec.max[1] - fSpec.min[1]) / fSpec.n[1],
+        (fSpec.max[2] - fSpec.min[2]) / fSpec.n[2]
+    };
+
+    G4double totalEdep_keV = 0.;
+    G4double maxDose_pGy = 0.;
+    G4int    maxVoxel = -1;
+
+    for (G4int i0 = 0; i0 < fSpec.n[0]; ++i0)
+    for (G4int i1 = 0; i1 < fSpec.n[1]; ++i1)
+    for (G4int i2 = 0; i2 < fSpec.n[2]; ++i2) {
+        const G4int idx = (i0 * fSpec.n[1] + i1) * fSpec.n[2] + i2;
+        const G4double edep = fEdep[static_cast<std::size_t>(idx)];
+        const G4double mass = fMass_g[static_cast<std::size_t>(idx)];
+        const G4double dose = (mass > 0.) ? edep * kKeVToPGyPerGram / mass : 0.;
+
+        // Centre du voxel en unités d'affichage (mm, deg)
+        const G4double c0 = (fSpec.min[0] + (i0 + 0.5) * width[0]) / mm;
+        const G4double c1 = (fSpec.min[1] + (i1 + 0.5) * width[1]) / unit1;
+        const G4double c2 = (fSpec.min[2] + (i2 + 0.5) * width[2]) / mm;
+
+        if (doseH3Id >= 0 && dose > 0.) am->FillH3(doseH3Id, c0, c1, c2, dose);
+        if (massH3Id >= 0) am->FillH3(massH3Id, c0, c1, c2, mass);
+
+        totalEdep_keV += edep;
+        if (dose > maxDose_pGy) { maxDose_pGy = dose; maxVoxel = idx; }
+    }
+
+    G4cout << "[DOSE][MESH] Edep totale dans la grille : " << totalEdep_keV << " keV, dose max = "
+           << maxDose_pGy << " pGy (voxel " << maxVoxel << ")" << G4endl;
+}
@@ -0,0 +1,101 @@
+#include "DoseMeshMessenger.hh"
+#include "DoseMesh.hh"
+
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <sstream>
+
+DoseMeshMessenger::DoseMeshMessenger(DoseMesh* mesh)
+: fMesh(mesh)
+{
+    fDoseDir = new G4UIdirectory("/dose/");
+    fDoseDir->SetGuidance("Scoring de dose.");
+
+    fDir = new G4UIdirectory("/dose/mesh/");
+    fDir->SetGuidance("Grille de dose 3D sur le fantôme d'eau (H3 DoseMesh_pGy / DoseMesh_mass_g).");
+
+    fEnableCmd = new G4UIcmdWithABool("/dose/mesh/enable", this);
+    fEnableCmd->SetGuidance("Active / désactive la grille de dose (défaut : false ; cylinder / box l'activent)");
+    fEnableCmd->SetParameterName("enable", false);
+    fEnableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fCylinderCmd = MakeGridCommand("/dose/mesh/cylinder", "nR", "nPhi", "rMax");
+    fCylinderCmd->SetGuidance("Grille cylindrique (r, phi, z) autour de l'axe z.");
+    fCylinderCmd->SetGuidance("rMax <= 0 : rayon et tranche z du disque d'eau (géométrie).");
+
+    fBoxCmd = MakeGridCommand("/dose/mesh/box", "nX", "nY", "halfXY");
+    fBoxCmd->SetGuidance("Grille cartésienne (x, y, z), x et y dans [-halfXY, halfXY].");
+    fBoxCmd->SetGuidance("halfXY <= 0 : rayon et tranche z du disque d'eau (géométrie).");
+}
+
+// Paramètres communs : n0 n1 nZ extent zMin zMax unit
+G4UIcommand* DoseMeshMessenger::MakeGridCommand(const char* path, const char* n0, const char* n1, const char* extent)
+{
+    auto* cmd = new G4UIcommand(path, this);
+
+    for (const char* name : {n0, n1, "nZ"}) {
+        auto* p = new G4UIparameter(name, 'i', false);
+        p->SetParameterRange(G4String(name) + ">=1");
+        cmd->SetParameter(p);
+    }
+    for (const char* name : {extent, "zMin", "zMax"}) {
+        auto* p = new G4UIparameter(name, 'd', true);
+        p->SetDefaultValue(0.);
+        cmd->SetParameter(p);
+    }
+    auto* unit = new G4UIparameter("unit", 's', true);
+    unit->SetDefaultValue("mm");
+    cmd->SetParameter(unit);
+
+    cmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    return cmd;
+}
+
+DoseMeshMessenger::~DoseMeshMessenger()
+{
+    delete fEnableCmd;
+    delete fCylinderCmd;
+    delete fBoxCmd;
+    delete fDir;
+    delete fDoseDir;
+}
+
+void DoseMeshMessenger::SetNewValue(G4UIcommand* command, G4String value)
+{
+    auto& spec = fMesh->GetSpec();
+
+    if (command == fEnableCmd) {
+        spec.enabled = fEnableCmd->GetNewBoolValue(value);
+        return;
+    }
+    if (command != fCylinderCmd && command != fBoxCmd) return;
+
+    G4int n0 = 1, n1 = 1, n2 = 1;
+    G4double extent = 0., zMin = 0., zMax = 0.;
+    G4String unitName = "mm";
+    std::istringstream is(value);
+    is >> n0 >> n1 >> n2 >> extent >> zMin >> zMax >> unitName;
+    const G4double unit = G4UIcommand::ValueOf(unitName);
+
+    spec.enabled = true;
+    spec.type = (command == fCylinderCmd) ? DoseMesh::kCylindrical : DoseMesh::kCartesian;
+    spec.n[0] = n0;
+    spec.n[1] = n1;
+    spec.n[2] = n2;
+    spec.fromGeometry = (extent <= 0. || zMax <= zMin);
+    if (!spec.fromGeometry) {
+        if (spec.type == DoseMesh::kCylindrical) {
+            spec.min[0] = 0.;        spec.max[0] = extent * unit;
+            spec.min[1] = -pi;       spec.max[1] = pi;
+        } else {
+            spec.min[0] = spec.min[1] = -extent * unit;
+            spec.max[0] = spec.max[1] =  extent * unit;
+        }
+        spec.min[2] = zMin * unit;
+        spec.max[2] = zMax * unit;
+    }
+}
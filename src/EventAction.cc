@@ -15,8 +15,10 @@
 #include "G4SystemOfUnits.hh"
 #include "G4AnalysisManager.hh"
 
-#include "SphereHit.hh"
+#include "SphereHitSink.hh"
 #include "RunAction.hh"
+#include "StepTraceRecorder.hh"
+#include "SimTrace.hh"
 
 
 //******************************************************************************************
@@ -41,10 +43,13 @@ EventAction::~EventAction(){}
 //  Cela prépare la collecte d'informations pendant le reste de l'événement, via SteppingAction.
 void EventAction::BeginOfEventAction(const G4Event*  event)
 {
+    // Trace step par step : armée uniquement pour les événements sélectionnés
+    StepTraceRecorder::Instance()->ArmForEvent(event->GetEventID());
+
     // Réinitialisation pour chaque événement
     enteredCube = false;
     enteredSphere = false;
-    creatorProcess = "unknown";
+    fCreatorProcessId = MyTrackInfo::kUnknownProcessId;
 
     fNbEntrantInBe = 0;
     fNbInteractedInBe = 0;
@@ -54,10 +59,14 @@ void EventAction::BeginOfEventAction(const G4Event*  event)
     // Réinitialisation des énergies déposées dans les anneaux d'eau
     for (G4int i = 0; i < kNbWaterRings; i++) {
         fEdepRing[i] = 0.0;
+        fTleRing[i] = 0.0;
     }
     fEdepTotalWater = 0.0;
+    fTleTotalWater = 0.0;
+
+    // 🔍 Récupérer la particule primaire (diagnostic uniquement)
+    if (!SIM_TRACE(fEventVerboseLevel, 1)) return;
 
-    // 🔍 Récupérer la particule primaire
     G4PrimaryVertex* primaryVertex = event->GetPrimaryVertex();
     if (primaryVertex) {
         G4PrimaryParticle* primary = primaryVertex->GetPrimary();
@@ -68,18 +77,18 @@ void EventAction::BeginOfEventAction(const G4Event*  event)
             G4ThreeVector mom = primary->GetMomentumDirection();
             G4double energy = primary->GetTotalEnergy();
 
-            if (fEventVerboseLevel == 1) {
+            if (SIM_TRACE(fEventVerboseLevel, 1)) {
             G4cout << "[DEBUG BeginOfEventAction] Particule primaire = " << name << G4endl;
             G4cout << "[DEBUG BeginOfEventAction] Direction         = " << mom << G4endl;
             G4cout << "[DEBUG BeginOfEventAction] Énergie totale    = " << energy / keV << " keV" << G4endl;
             }
         } else {
-            if (fEventVerboseLevel == 1) {
+            if (SIM_TRACE(fEventVerboseLevel, 1)) {
             G4cout << "[DEBUG BeginOfEventAction] Pas de particule primaire." << G4endl;
             }
         }
     } else {
-        if (fEventVerboseLevel == 1) {
+        if (SIM_TRACE(fEventVerboseLevel, 1)) {
         G4cout << "[DEBUG BeginOfEventAction] Pas de vertex primaire." << G4endl;
         }
     }
@@ -90,7 +99,7 @@ void EventAction::BeginOfEventAction(const G4Event*  event)
 
 void EventAction::EndOfEventAction(const G4Event* event)
 {
-    if (fEventVerboseLevel == 1) {
+    if (SIM_TRACE(fEventVerboseLevel, 1)) {
         G4cout << "[DEBUG EndOfEventAction] EndOfEventAction appelé pour EventID = "<<event->GetEventID()<<G4endl;
         G4cout << "[DEBUG EndOfEventAction] NbEntrantInBe = "<<fNbEntrantInBe<<G4endl;
         G4cout << "[DEBUG EndOfEventAction] NbInteractedInBe = "<<fNbInteractedInBe<<G4endl;}
@@ -103,14 +112,18 @@ void EventAction::EndOfEventAction(const G4Event* event)
         
         // Transmettre l'énergie déposée dans les anneaux d'eau
         fRunAction->AddEdepFromEvent(fEdepRing, fEdepTotalWater);
+        fRunAction->AddTrackLengthFromEvent(fTleRing, fTleTotalWater);
         
         // Vérifier si on doit remplir les histogrammes de dose (tous les 1000 événements)
         fRunAction->CheckAndFillDoseHistograms(event->GetEventID());
+
+        // Arrêt du run si l'incertitude cible est atteinte (/convergence/...)
+        fRunAction->CheckConvergence();
     }
 
     auto runAction = static_cast<const RunAction*>(G4RunManager::GetRunManager()->GetUserRunAction());
     if (runAction) {
-        if (fEventVerboseLevel == 1) {
+        if (SIM_TRACE(fEventVerboseLevel, 1)) {
             G4cout << "\n[DEBUG EndOfEventAction] [EndOfEventAction DEBUG] Compteurs globaux (fin event #" << G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID() << ") :" << G4endl;
             G4cout<<" [DEBUG EndOfEventAction ↪ fTotalEntrantInBe          = "<<runAction->GetTotalEntrantInBe()<<G4endl;
             G4cout<<" [DEBUG EndOfEventAction ↪ fTotalInteractedInBe       = "<<runAction->GetTotalInteractedInBe()<<G4endl;
@@ -118,7 +131,8 @@ void EventAction::EndOfEventAction(const G4Event* event)
             G4cout<<" [DEBUG EndOfEventAction ↪ fTotalInteractedInWaterSphere = "<<runAction->GetTotalInteractedInWaterSphere()<< G4endl;}
     }
 
-    // SphereSD supprimé - plus d'accès à SphereHitsCollection
+    // Hits SphereSD (si le SD est présent) : transmis en flux, rien n'est gardé après l'événement
+    SphereHitSink::Instance()->Consume(event->GetEventID(), event->GetHCofThisEvent());
 }
 
 //  Méthode appelée par SteppingAction pour transmettre à EventAction
@@ -131,10 +145,9 @@ void EventAction::SetTrackInfo(MyTrackInfo* info)
     enteredCube = info->HasEnteredCube();
     enteredSphere = info->HasEnteredSphere();
 
-    G4String p = info->GetCreatorProcess();
-    creatorProcess = (p.empty() ? "unknown" : p);
+    fCreatorProcessId = info->GetCreatorProcessId();
 
-    if (fEventVerboseLevel == 1) {
-        G4cout<<"[DEBUG SetTrackInfo] ✅ Infos copiées : process="<<creatorProcess<<", cube="<<enteredCube<<", sphère="<<enteredSphere<<G4endl;}
+    if (SIM_TRACE(fEventVerboseLevel, 1)) {
+        G4cout<<"[DEBUG SetTrackInfo] ✅ Infos copiées : process="<<ProcessIdTable::GetName(fCreatorProcessId)<<", cube="<<enteredCube<<", sphère="<<enteredSphere<<G4endl;}
 }
 
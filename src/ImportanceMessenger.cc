@@ -0,0 +1,82 @@
+#include "ImportanceMessenger.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+
+#include <sstream>
+
+ImportanceMessenger::ImportanceMessenger(DetectorConstruction* detector)
+: fDetector(detector)
+{
+    fDir = new G4UIdirectory("/importance/");
+    fDir->SetGuidance("Splitting / roulette russe géométriques des photons (tranches en z, monde parallèle).");
+
+    // /importance/region name zMin zMax importance unit
+    fRegionCmd = new G4UIcommand("/importance/region", this);
+    fRegionCmd->SetGuidance("Déclare une tranche en z et son importance (active le biaisage, avant /run/initialize)");
+    fRegionCmd->SetGuidance("ex. /importance/region collimateur 16 20 4 mm");
+    auto* name = new G4UIparameter("name", 's', false);
+    fRegionCmd->SetParameter(name);
+    for (const char* p : {"zMin", "zMax"}) fRegionCmd->SetParameter(new G4UIparameter(p, 'd', false));
+    auto* imp = new G4UIparameter("importance", 'd', false);
+    imp->SetParameterRange("importance > 0");
+    fRegionCmd->SetParameter(imp);
+    auto* unit = new G4UIparameter("unit", 's', true);
+    unit->SetDefaultValue("mm");
+    fRegionCmd->SetParameter(unit);
+    fRegionCmd->AvailableForStates(G4State_PreInit);
+
+    // /importance/set name importance
+    fSetCmd = new G4UIcommand("/importance/set", this);
+    fSetCmd->SetGuidance("Change l'importance d'une tranche déjà déclarée (aussi entre deux runs)");
+    fSetCmd->SetParameter(new G4UIparameter("name", 's', false));
+    auto* value = new G4UIparameter("importance", 'd', false);
+    value->SetParameterRange("importance > 0");
+    fSetCmd->SetParameter(value);
+    fSetCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fOutsideCmd = new G4UIcmdWithADouble("/importance/outside", this);
+    fOutsideCmd->SetGuidance("Importance hors des tranches déclarées (défaut : 1)");
+    fOutsideCmd->SetParameterName("importance", false);
+    fOutsideCmd->SetRange("importance > 0");
+    fOutsideCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fListCmd = new G4UIcmdWithoutParameter("/importance/list", this);
+    fListCmd->SetGuidance("Affiche les tranches et leurs importances");
+    fListCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+ImportanceMessenger::~ImportanceMessenger()
+{
+    delete fRegionCmd;
+    delete fSetCmd;
+    delete fOutsideCmd;
+    delete fListCmd;
+    delete fDir;
+}
+
+void ImportanceMessenger::SetNewValue(G4UIcommand* command, G4String value)
+{
+    std::istringstream is(value);
+
+    if (command == fRegionCmd) {
+        G4String name, unitName = "mm";
+        G4double zMin = 0., zMax = 0., importance = 1.;
+        is >> name >> zMin >> zMax >> importance >> unitName;
+        const G4double unit = G4UIcommand::ValueOf(unitName);
+        fDetector->AddImportanceRegion(name, zMin * unit, zMax * unit, importance);
+    } else if (command == fSetCmd) {
+        G4String name;
+        G4double importance = 1.;
+        is >> name >> importance;
+        fDetector->SetRegionImportance(name, importance);
+    } else if (command == fOutsideCmd) {
+        fDetector->SetOutsideImportance(fOutsideCmd->GetNewDoubleValue(value));
+    } else if (command == fListCmd) {
+        fDetector->PrintImportanceRegions();
+    }
+}
@@ -0,0 +1,116 @@
+#include "ImportanceParallelWorld.hh"
+
+#include "G4Box.hh"
+#include "G4IStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+
+ImportanceParallelWorld::ImportanceParallelWorld(const G4String& worldName)
+    : G4VUserParallelWorld(worldName)
+{}
+
+G4bool ImportanceParallelWorld::AddRegion(const G4String& name, G4double zMin, G4double zMax, G4double importance)
+{
+    if (zMax <= zMin || importance <= 0.) {
+        G4cerr << "[GEOM][IMP][WARN] Région " << name << " ignorée : il faut zMin < zMax et importance > 0" << G4endl;
+        return false;
+    }
+    for (const auto& r : fRegions) {
+        if (r.name == name) {
+            G4cerr << "[GEOM][IMP][WARN] Région " << name << " déjà déclarée" << G4endl;
+            return false;
+        }
+        if (zMin < r.zMax && r.zMin < zMax) {
+            G4cerr << "[GEOM][IMP][WARN] Région " << name << " ignorée : recouvre " << r.name
+                   << " [" << r.zMin/mm << ", " << r.zMax/mm << "] mm" << G4endl;
+            return false;
+        }
+    }
+
+    Region region;
+    region.name = name;
+    region.zMin = zMin;
+    region.zMax = zMax;
+    region.importance = importance;
+    fRegions.push_back(region);
+    std::sort(fRegions.begin(), fRegions.end(),
+              [](const Region& a, const Region& b) { return a.zMin < b.zMin; });
+    return true;
+}
+
+G4bool ImportanceParallelWorld::SetImportance(const G4String& name, G4double importance)
+{
+    auto it = std::find_if(fRegions.begin(), fRegions.end(),
+                           [&name](const Region& r) { return r.name == name; });
+    if (it == fRegions.end() || importance <= 0.) {
+        G4cerr << "[GEOM][IMP][WARN] Importance de " << name << " inchangée (région inconnue ou valeur <= 0)" << G4endl;
+        return false;
+    }
+    it->importance = importance;
+    if (it->physical) G4IStore::GetInstance(GetName())->ChangeImportance(importance, *it->physical, 0);
+    return true;
+}
+
+void ImportanceParallelWorld::SetOutsideImportance(G4double importance)
+{
+    if (importance <= 0.) return;
+    fOutsideImportance = importance;
+    if (fGhostWorld) G4IStore::GetInstance(GetName())->ChangeImportance(importance, *fGhostWorld, 0);
+}
+
+void ImportanceParallelWorld::Construct()
+{
+    fGhostWorld = GetWorld();
+    G4LogicalVolume* ghostWorld = fGhostWorld->GetLogicalVolume();
+
+    // Tranches pleine section : demi-dimensions x/y du monde (clone du monde de masse)
+    auto* worldBox = dynamic_cast<G4Box*>(ghostWorld->GetSolid());
+    if (!worldBox) {
+        G4Exception("ImportanceParallelWorld::Construct", "IMP01", FatalException,
+                    "Le monde de masse n'est pas un G4Box : tranches d'importance impossibles.");
+        return;
+    }
+    const G4double hx = worldBox->GetXHalfLength();
+    const G4double hy = worldBox->GetYHalfLength();
+    const G4double hz = worldBox->GetZHalfLength();
+
+    for (auto& r : fRegions) {
+        const G4double zMin = std::max(r.zMin, -hz);
+        const G4double zMax = std::min(r.zMax,  hz);
+        if (zMax <= zMin) {
+            G4cout << "[GEOM][IMP][WARN] Région " << r.name << " hors du monde : ignorée" << G4endl;
+            continue;
+        }
+        auto* solid = new G4Box("solidImp_" + r.name, hx, hy, 0.5*(zMax - zMin));
+        auto* lv = new G4LogicalVolume(solid, nullptr, "logicImp_" + r.name);
+        r.physical = new G4PVPlacement(nullptr, G4ThreeVector(0., 0., 0.5*(zMin + zMax)), lv,
+                                       "physImp_" + r.name, ghostWorld, false, 0, true);
+    }
+
+    FillImportanceStore();
+    Print();
+}
+
+void ImportanceParallelWorld::FillImportanceStore()
+{
+    // Une cellule par tranche + le monde fantôme (tout ce qui est hors tranches)
+    G4IStore* istore = G4IStore::GetInstance(GetName());
+    istore->Clear();
+    istore->AddImportanceGeometryCell(fOutsideImportance, *fGhostWorld, 0);
+    for (const auto& r : fRegions) {
+        if (r.physical) istore->AddImportanceGeometryCell(r.importance, *r.physical, 0);
+    }
+}
+
+void ImportanceParallelWorld::Print() const
+{
+    G4cout << "[GEOM][IMP] Importances (photons), hors tranches = " << fOutsideImportance << G4endl;
+    for (const auto& r : fRegions) {
+        G4cout << "[GEOM][IMP]   " << r.name << " : z ∈ [" << r.zMin/mm << ", " << r.zMax/mm
+               << "] mm, importance = " << r.importance << G4endl;
+    }
+}
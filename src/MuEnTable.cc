@@ -0,0 +1,118 @@
+#include "MuEnTable.hh"
+
+#include "G4AutoLock.hh"
+#include "G4Element.hh"
+#include "G4Material.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+
+namespace {
+    // NIST, Water (liquid) : E (MeV), μen/ρ (cm²/g) — Hubbell & Seltzer, NISTIR 5632
+    constexpr G4double kWaterE_MeV[] = {
+        1.0e-03, 1.5e-03, 2.0e-03, 3.0e-03, 4.0e-03, 5.0e-03, 6.0e-03, 8.0e-03,
+        1.0e-02, 1.5e-02, 2.0e-02, 3.0e-02, 4.0e-02, 5.0e-02, 6.0e-02, 8.0e-02,
+        1.0e-01, 1.5e-01, 2.0e-01
+    };
+    constexpr G4double kWaterMuEnRho[] = {
+        4.065e+03, 1.372e+03, 6.152e+02, 1.917e+02, 8.191e+01, 4.188e+01, 2.405e+01, 9.915e+00,
+        4.944e+00, 1.374e+00, 5.503e-01, 1.557e-01, 6.947e-02, 4.223e-02, 3.190e-02, 2.597e-02,
+        2.546e-02, 2.764e-02, 2.967e-02
+    };
+    constexpr std::size_t kNbWaterPoints = sizeof(kWaterE_MeV) / sizeof(kWaterE_MeV[0]);
+    static_assert(kNbWaterPoints == sizeof(kWaterMuEnRho) / sizeof(kWaterMuEnRho[0]), "table NIST incohérente");
+
+    // Eau : H et O uniquement, fractions massiques de H2O (NIST G4_WATER : H 0.111894, O 0.888106)
+    G4bool IsWater(const G4Material* mat)
+    {
+        if (mat->GetName() == "G4_WATER") return true;
+        if (mat->GetNumberOfElements() != 2) return false;
+
+        constexpr G4double kTolerance = 1e-3;
+        const G4double* fractions = mat->GetFractionVector();
+        for (std::size_t i = 0; i < 2; ++i) {
+            const G4int Z = mat->GetElement(static_cast<G4int>(i))->GetZasInt();
+            const G4double expected = (Z == 1) ? 0.111894 : (Z == 8) ? 0.888106 : -1.;
+            if (std::abs(fractions[i] - expected) > kTolerance) return false;
+        }
+        return true;
+    }
+
+    G4Mutex gMuEnMutex = G4MUTEX_INITIALIZER;
+
+    // Tables partagées (une par matériau tabulé), construites sous verrou, jamais détruites avant la fin
+    std::map<const G4Material*, std::unique_ptr<const MuEnTable>>& SharedTables()
+    {
+        static std::map<const G4Material*, std::unique_ptr<const MuEnTable>> tables;
+        return tables;
+    }
+
+    // Cache par thread, indexé par G4Material::GetIndex() (table nulle : non tabulé)
+    struct ThreadCache {
+        std::vector<const MuEnTable*> table;
+        std::vector<G4bool> resolved;
+    };
+    G4ThreadLocal ThreadCache* gCache = nullptr;
+}
+
+MuEnTable::MuEnTable(const G4double* energy_MeV, const G4double* muEnRho_cm2g, std::size_t n, G4double density)
+{
+    const G4double logEmin = std::log(energy_MeV[0] * MeV);
+    const G4double logEmax = std::log(energy_MeV[n - 1] * MeV);
+    const G4double delta = (logEmax - logEmin) / kNbBins;
+
+    fLogEmin = logEmin;
+    fInvDeltaLog = 1. / delta;
+    fMuEn.resize(kNbBins + 1);
+
+    // Interpolation log-log des points NIST, une fois pour toutes
+    std::size_t k = 0;
+    for (std::size_t i = 0; i <= kNbBins; ++i) {
+        const G4double logE = logEmin + i * delta;
+        while (k + 2 < n && logE > std::log(energy_MeV[k + 1] * MeV)) ++k;
+        const G4double x0 = std::log(energy_MeV[k] * MeV), x1 = std::log(energy_MeV[k + 1] * MeV);
+        const G4double y0 = std::log(muEnRho_cm2g[k]),     y1 = std::log(muEnRho_cm2g[k + 1]);
+        const G4double t = std::min(1., std::max(0., (logE - x0) / (x1 - x0)));
+        fMuEn[i] = std::exp(y0 + t * (y1 - y0)) * (cm2 / g) * density;
+    }
+}
+
+const MuEnTable* MuEnTable::ForMaterial(const G4Material* mat)
+{
+    if (!mat) return nullptr;
+
+    if (!gCache) gCache = new ThreadCache();
+    const std::size_t idx = mat->GetIndex();
+    if (idx >= gCache->table.size()) {
+        gCache->table.resize(idx + 1, nullptr);
+        gCache->resolved.resize(idx + 1, false);
+    }
+    if (gCache->resolved[idx]) return gCache->table[idx];
+
+    const MuEnTable* table = nullptr;
+    {
+        G4AutoLock lock(&gMuEnMutex);
+        auto& tables = SharedTables();
+        auto it = tables.find(mat);
+        if (it != tables.end()) {
+            table = it->second.get();
+        } else if (IsWater(mat)) {
+            table = new MuEnTable(kWaterE_MeV, kWaterMuEnRho, kNbWaterPoints, mat->GetDensity());
+            tables.emplace(mat, std::unique_ptr<const MuEnTable>(table));
+            G4cout << "[DOSE][TLE] μen/ρ de l'eau (NIST) pour " << mat->GetName() << ", ρ = "
+                   << mat->GetDensity()/(g/cm3) << " g/cm3" << G4endl;
+        } else {
+            tables.emplace(mat, nullptr);
+            G4cout << "[DOSE][TLE][WARN] μen/ρ non tabulé pour " << mat->GetName()
+                   << " : pas d'estimateur par longueur de trace dans ce matériau" << G4endl;
+        }
+    }
+
+    gCache->table[idx] = table;
+    gCache->resolved[idx] = true;
+    return table;
+}
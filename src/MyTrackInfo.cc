@@ -1,8 +1,24 @@
 #include "MyTrackInfo.hh"
 
-MyTrackInfo::MyTrackInfo()
-: G4VUserTrackInformation(), enteredCube(false), enteredSphere(false), creatorProcess("unknown")
+#include "G4Track.hh"
+
+G4ThreadLocal G4Allocator<MyTrackInfo>* MyTrackInfoAllocator = nullptr;
+
+MyTrackInfo::MyTrackInfo(G4int creatorProcessId)
+: G4VUserTrackInformation(), fCreatorProcessId(creatorProcessId)
 {}
 
-MyTrackInfo::~MyTrackInfo() {}
+G4int MyTrackInfo::CreatorProcessIdOf(const G4Track* track)
+{
+    return ProcessIdTable::GetId(track->GetCreatorProcess());
+}
 
+MyTrackInfo* MyTrackInfo::Attach(const G4Track* track)
+{
+    auto* info = static_cast<MyTrackInfo*>(track->GetUserInformation());
+    if (!info) {
+        info = new MyTrackInfo(CreatorProcessIdOf(track));
+        track->SetUserInformation(info);
+    }
+    return info;
+}
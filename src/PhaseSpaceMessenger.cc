@@ -0,0 +1,57 @@
+#include "PhaseSpaceMessenger.hh"
+#include "PhaseSpaceWriter.hh"
+
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIdirectory.hh"
+
+PhaseSpaceMessenger::PhaseSpaceMessenger(PhaseSpaceWriter* writer)
+: fWriter(writer)
+{
+    fDir = new G4UIdirectory("/phasespace/");
+    fDir->SetGuidance("Écriture de l'espace des phases à un plan z (rejoué par /primariesgenerator/selectsource 4).");
+
+    fEnableCmd = new G4UIcmdWithABool("/phasespace/enable", this);
+    fEnableCmd->SetGuidance("Active / désactive l'écriture (défaut : false)");
+    fEnableCmd->SetParameterName("enable", false);
+    fEnableCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fPlaneCmd = new G4UIcmdWithADoubleAndUnit("/phasespace/planeZ", this);
+    fPlaneCmd->SetGuidance("Plan enregistré : passages vers +z à cette cote (défaut : 18 mm, logicScorePlane)");
+    fPlaneCmd->SetParameterName("z", false);
+    fPlaneCmd->SetDefaultUnit("mm");
+    fPlaneCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fKillCmd = new G4UIcmdWithABool("/phasespace/kill", this);
+    fKillCmd->SetGuidance("Tue la particule après enregistrement (défaut : true, pas de simulation du fantôme)");
+    fKillCmd->SetParameterName("kill", false);
+    fKillCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+    fFileCmd = new G4UIcmdWithAString("/phasespace/file", this);
+    fFileCmd->SetGuidance("Préfixe des fichiers : <prefixe>_run<R>_<seq|tN>.psf (défaut : phasespace)");
+    fFileCmd->SetParameterName("prefix", false);
+    fFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+PhaseSpaceMessenger::~PhaseSpaceMessenger()
+{
+    delete fEnableCmd;
+    delete fPlaneCmd;
+    delete fKillCmd;
+    delete fFileCmd;
+    delete fDir;
+}
+
+void PhaseSpaceMessenger::SetNewValue(G4UIcommand* command, G4String value)
+{
+    if (command == fEnableCmd) {
+        fWriter->SetEnabled(fEnableCmd->GetNewBoolValue(value));
+    } else if (command == fPlaneCmd) {
+        fWriter->SetPlaneZ(fPlaneCmd->GetNewDoubleValue(value));
+    } else if (command == fKillCmd) {
+        fWriter->SetKillAtPlane(fKillCmd->GetNewBoolValue(value));
+    } else if (command == fFileCmd) {
+        fWriter->SetBaseName(value);
+    }
+}
@@ -0,0 +1,139 @@
+#include "PhaseSpaceWriter.hh"
+#include "PhaseSpaceMessenger.hh"
+
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+#include "G4ios.hh"
+
+#include <cstddef>
+#include <cstring>
+
+namespace {
+    G4ThreadLocal PhaseSpaceWriter* gWriter = nullptr;
+}
+
+PhaseSpaceWriter* PhaseSpaceWriter::Instance()
+{
+    if (!gWriter) gWriter = new PhaseSpaceWriter();
+    return gWriter;
+}
+
+void PhaseSpaceWriter::Destroy()
+{
+    delete gWriter;
+    gWriter = nullptr;
+}
+
+PhaseSpaceWriter::PhaseSpaceWriter()
+: fPlaneZ(18.*mm)   // logicScorePlane, sortie du collimateur
+{
+    fBuffer.resize(kBufferSize);
+    fMessenger = new PhaseSpaceMessenger(this);
+}
+
+// Fichier encore ouvert (run interrompu, EndRun non appelé) : les particules tamponnées sont
+// écrites mais l'en-tête garde ses compteurs à zéro (relecture sur la taille, histoires inconnues)
+// plutôt qu'un nHistories = 0 qui fausserait la normalisation
+PhaseSpaceWriter::~PhaseSpaceWriter()
+{
+    Flush();
+    if (fFile.is_open()) fFile.close();
+    delete fMessenger;
+}
+
+void PhaseSpaceWriter::BeginRun(G4int runID)
+{
+    fRunID = runID;
+    fCount = 0;
+    fRecordsWritten = 0;
+    if (fFile.is_open()) fFile.close();
+    fFileName.clear();
+
+    // En MT, seuls les workers simulent : pas de fichier pour le master
+    if (!fEnabled || (G4Threading::IsMultithreadedApplication() && G4Threading::IsMasterThread())) return;
+
+    // Fichier ouvert même sans passage : nHistories compte pour la normalisation
+    OpenFile();
+}
+
+G4bool PhaseSpaceWriter::Record(const G4Step* step)
+{
+    const G4StepPoint* pre  = step->GetPreStepPoint();
+    const G4StepPoint* post = step->GetPostStepPoint();
+    const G4ThreeVector& p0 = pre->GetPosition();
+    const G4ThreeVector& p1 = post->GetPosition();
+    if (!(p0.z() < fPlaneZ && p1.z() >= fPlaneZ)) return false;
+
+    // Point de passage sur le plan (segment rectiligne du step)
+    const G4double t = (fPlaneZ - p0.z()) / (p1.z() - p0.z());
+    const G4ThreeVector pos = p0 + t * (p1 - p0);
+    const G4ThreeVector& dir = pre->GetMomentumDirection();
+    const G4Track* track = step->GetTrack();
+
+    if (fCount == fBuffer.size()) Flush();
+
+    PhaseSpaceIO::Record& r = fBuffer[fCount++];
+    r.pdg       = track->GetDefinition()->GetPDGEncoding();
+    r.pos_mm[0] = static_cast<float>(pos.x()/mm);
+    r.pos_mm[1] = static_cast<float>(pos.y()/mm);
+    r.pos_mm[2] = static_cast<float>(fPlaneZ/mm);
+    r.dir[0]    = static_cast<float>(dir.x());
+    r.dir[1]    = static_cast<float>(dir.y());
+    r.dir[2]    = static_cast<float>(dir.z());
+    r.ekin_keV  = static_cast<float>(pre->GetKineticEnergy()/keV);
+    r.weight    = static_cast<float>(pre->GetWeight());
+    return true;
+}
+
+// En-tête provisoire (compteurs à zéro), complété par EndRun()
+void PhaseSpaceWriter::OpenFile()
+{
+    const G4int tid = G4Threading::G4GetThreadId();
+    fFileName = fBaseName + "_run" + std::to_string(fRunID) + "_"
+              + (tid < 0 ? std::string("seq") : "t" + std::to_string(tid)) + ".psf";
+
+    fFile.open(fFileName, std::ios::binary | std::ios::trunc);
+    if (!fFile) {
+        G4cerr << "[PSF][ERROR] Impossible d'ouvrir " << fFileName << G4endl;
+        return;
+    }
+
+    PhaseSpaceIO::FileHeader header{};
+    std::memcpy(header.magic, PhaseSpaceIO::kMagic, sizeof(header.magic));
+    header.version    = PhaseSpaceIO::kVersion;
+    header.recordSize = sizeof(PhaseSpaceIO::Record);
+    header.threadId   = tid;
+    header.zPlane_mm  = static_cast<float>(fPlaneZ/mm);
+    fFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void PhaseSpaceWriter::Flush()
+{
+    if (fCount == 0) return;
+    if (fFile.is_open() && fFile) {
+        fFile.write(reinterpret_cast<const char*>(fBuffer.data()),
+                    static_cast<std::streamsize>(fCount * sizeof(PhaseSpaceIO::Record)));
+        fRecordsWritten += static_cast<G4long>(fCount);
+    }
+    fCount = 0;
+}
+
+void PhaseSpaceWriter::EndRun(G4long nHistories)
+{
+    Flush();
+    if (!fFile.is_open()) return;
+
+    // Compteurs définitifs dans l'en-tête
+    const std::uint64_t counts[2] = {static_cast<std::uint64_t>(nHistories),
+                                     static_cast<std::uint64_t>(fRecordsWritten)};
+    fFile.seekp(offsetof(PhaseSpaceIO::FileHeader, nHistories));
+    fFile.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+    fFile.close();
+
+    G4cout << "[PSF] " << fRecordsWritten << " particules à z = " << fPlaneZ/mm << " mm pour "
+           << nHistories << " histoires écrites dans " << fFileName << G4endl;
+}
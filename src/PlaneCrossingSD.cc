@@ -0,0 +1,193 @@
+#include "PlaneCrossingSD.hh"
+#include "PlaneCrossingSDMessenger.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4StepPoint.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4VProcess.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4AnalysisManager.hh"
+#include "G4RunManager.hh"
+#include "G4Event.hh"
+#include "G4Threading.hh"
+#include "SimTrace.hh"
+#include "ProcessIdTable.hh"
+
+namespace {
+    inline const char* ThreadTag() {
+#ifdef G4MULTITHREADED
+        return G4Threading::IsMasterThread() ? "[MT-MASTER]" : "[MT-WORKER]";
+#else
+        return "[SEQ]";
+#endif
+    }
+}
+
+PlaneCrossingSD::PlaneCrossingSD(const G4String& name, const PlaneCrossingPolicy& policy)
+    : G4VSensitiveDetector(name), fPolicy(policy)
+{
+    fMessenger = new PlaneCrossingSDMessenger(this);
+    G4cout << ThreadTag() << " [PlaneCrossingSD] Constructeur: " << name
+           << " plusZOnly=" << fPolicy.plusZOnly
+           << " firstEntryOnly=" << fPolicy.firstEntryOnly << G4endl;
+}
+
+PlaneCrossingSD::~PlaneCrossingSD()
+{
+    delete fMessenger;
+}
+
+void PlaneCrossingSD::AddTargetVolume(const G4VPhysicalVolume* pv)
+{
+    if (!pv || IsTarget(pv)) return;
+    fTargets.push_back(pv);
+}
+
+void PlaneCrossingSD::Initialize(G4HCofThisEvent*)
+{
+    // Clear() garde la capacité : pas de réallocation d'un événement à l'autre
+    fTracksThisEvent.Clear();
+    fPrimaryThisEvent = false;
+    fTransferTrackID = -1;
+
+    static G4ThreadLocal int dbg = 0;
+    if (SIM_TRACE_SAMPLED() && dbg < 5) {
+        auto ev = G4RunManager::GetRunManager()->GetCurrentEvent();
+        G4cout << ThreadTag() << " [" << GetName() << "] Initialize event "
+               << (ev ? ev->GetEventID() : -1) << G4endl;
+        ++dbg;
+    }
+}
+
+G4bool PlaneCrossingSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+    if (!step) return false;
+
+    const G4Track* track = step->GetTrack();
+    if (!track) return false;
+
+    const G4StepPoint* preStep = step->GetPreStepPoint();
+    const G4StepPoint* postStep = step->GetPostStepPoint();
+    if (!preStep || !postStep) return false;
+
+    ++fCntTotal;
+
+    // Détection de l'entrée par comparaison de pointeurs de volumes physiques
+    const G4bool preIn  = IsTarget(preStep->GetPhysicalVolume());
+    const G4bool postIn = IsTarget(postStep->GetPhysicalVolume());
+
+    const G4bool enteringVolume    = !preIn && postIn;
+    const G4bool firstStepInVolume = preIn && (preStep->GetStepStatus() == fGeomBoundary);
+
+    // Passage direct d'une cible à une autre (anneau -> anneau) : le premier step dans
+    // la cible suivante n'est pas une entrée. Les steps d'une trace se suivent, il suffit
+    // de retenir la trace qui vient de franchir une frontière cible/cible.
+    const G4int trackID = track->GetTrackID();
+    const G4bool fromOtherTarget = firstStepInVolume && trackID == fTransferTrackID;
+    fTransferTrackID = (preIn && postIn && postStep->GetPhysicalVolume() != preStep->GetPhysicalVolume())
+                     ? trackID : -1;
+
+    if (!enteringVolume && (!firstStepInVolume || fromOtherTarget)) {
+        return false;
+    }
+
+    // Position à l'entrée : juste après la frontière, ou premier step dans le volume
+    const G4ThreeVector& pos = enteringVolume ? postStep->GetPosition() : preStep->GetPosition();
+
+    return ScoreEntry(track, pos, preStep->GetKineticEnergy(), preStep->GetMomentumDirection());
+}
+
+G4bool PlaneCrossingSD::ScoreEntry(const G4Track* track, const G4ThreeVector& pos,
+                                   G4double ekin, const G4ThreeVector& dir)
+{
+    if (fPolicy.plusZOnly && dir.z() <= 0.) {
+        ++fCntRejected;
+        return false;
+    }
+
+    const G4int trackID = track->GetTrackID();
+    if (fPolicy.firstEntryOnly) {
+        if (!fTracksThisEvent.Insert(trackID)) return false;
+    }
+
+    ++fCntAccepted;
+    fWeightAccepted += track->GetWeight();
+    if (track->GetParentID() == 0) fPrimaryThisEvent = true;
+
+    auto* man = G4AnalysisManager::Instance();
+    if (!man || !man->IsActive()) return true;
+
+    // Spectre pondéré (le H1 garde Σw et Σw² par bin)
+    const G4int hid = fSpectrumH1Id[track->GetParentID() == 0 ? 0 : 1];
+    if (hid >= 0) man->FillH1(hid, ekin / keV, track->GetWeight());
+
+    if (fNtupleId < 0) return true;
+
+    const G4ParticleDefinition* def = track->GetDefinition();
+    const G4int pdg = def ? def->GetPDGEncoding() : 0;
+
+    const G4int parentID = track->GetParentID();
+    const G4int is_secondary = (parentID == 0) ? 0 : 1;
+
+    // Processus créateur : identifiant interné (cf. ntuple "dictionary")
+    const G4int creator_process_id = ProcessIdTable::GetId(track->GetCreatorProcess());
+
+    const G4double x_mm = pos.x() / mm;
+    const G4double y_mm = pos.y() / mm;
+    const G4double ekin_keV = ekin / keV;
+
+    man->FillNtupleIColumn(fNtupleId, 0, pdg);
+    man->FillNtupleIColumn(fNtupleId, 1, is_secondary);
+    man->FillNtupleDColumn(fNtupleId, 2, x_mm);
+    man->FillNtupleDColumn(fNtupleId, 3, y_mm);
+    man->FillNtupleDColumn(fNtupleId, 4, ekin_keV);
+    man->FillNtupleIColumn(fNtupleId, 5, trackID);
+    man->FillNtupleIColumn(fNtupleId, 6, parentID);
+    man->FillNtupleIColumn(fNtupleId, 7, creator_process_id);
+    man->FillNtupleDColumn(fNtupleId, 8, track->GetWeight());
+    man->AddNtupleRow(fNtupleId);
+
+    static G4ThreadLocal int dbg_write = 0;
+    if (SIM_TRACE_SAMPLED() && dbg_write < 20) {
+        G4cout << "[" << GetName() << "] WROTE row: pdg=" << pdg
+               << " is_secondary=" << is_secondary
+               << " x=" << x_mm << " mm"
+               << " y=" << y_mm << " mm"
+               << " Ekin=" << ekin_keV << " keV"
+               << " trackID=" << trackID
+               << " parentID=" << parentID
+               << " creator=" << ProcessIdTable::GetName(creator_process_id)
+               << G4endl;
+        ++dbg_write;
+    }
+
+    return true;
+}
+
+void PlaneCrossingSD::EndOfEvent(G4HCofThisEvent*)
+{
+    if (fPrimaryThisEvent) ++fEventsWithPrimary;
+
+    static G4ThreadLocal int dbg = 0;
+    if (SIM_TRACE_SAMPLED() && dbg < 20 && !fTracksThisEvent.Empty()) {
+        auto ev = G4RunManager::GetRunManager()->GetCurrentEvent();
+        G4cout << ThreadTag() << " [" << GetName() << "] EndOfEvent "
+               << (ev ? ev->GetEventID() : -1)
+               << ": " << fTracksThisEvent.Size() << " particules enregistrées"
+               << G4endl;
+        ++dbg;
+    }
+}
+
+void PlaneCrossingSD::PrintSummary() const
+{
+    G4cout << "[" << GetName() << "][SUMMARY]"
+           << " total=" << fCntTotal
+           << " accepted=" << fCntAccepted
+           << " accepted_w=" << fWeightAccepted
+           << " rejected=" << fCntRejected
+           << " primary_events=" << fEventsWithPrimary
+           << G4endl;
+}
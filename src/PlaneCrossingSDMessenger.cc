@@ -0,0 +1,35 @@
+#include "PlaneCrossingSDMessenger.hh"
+#include "PlaneCrossingSD.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIdirectory.hh"
+
+PlaneCrossingSDMessenger::PlaneCrossingSDMessenger(PlaneCrossingSD* sd)
+: fDetector(sd)
+{
+    const G4String base = "/scoring/" + sd->GetName() + "/";
+
+    fDir = new G4UIdirectory(base);
+    fDir->SetGuidance("Règle d'acceptation du SD de passage de plan " + sd->GetName());
+
+    fPlusZOnlyCmd = new G4UIcmdWithABool((base + "plusZOnly").c_str(), this);
+    fPlusZOnlyCmd->SetGuidance("N'accepter que les passages dans le sens +Z (défaut : true)");
+    fPlusZOnlyCmd->SetParameterName("plusZOnly", false);
+
+    fFirstEntryOnlyCmd = new G4UIcmdWithABool((base + "firstEntryOnly").c_str(), this);
+    fFirstEntryOnlyCmd->SetGuidance("Une seule entrée comptée par trace et par événement (défaut : true)");
+    fFirstEntryOnlyCmd->SetParameterName("firstEntryOnly", false);
+}
+
+PlaneCrossingSDMessenger::~PlaneCrossingSDMessenger() {
+    delete fPlusZOnlyCmd;
+    delete fFirstEntryOnlyCmd;
+    delete fDir;
+}
+
+void PlaneCrossingSDMessenger::SetNewValue(G4UIcommand* command, G4String value) {
+    if (command == fPlusZOnlyCmd) {
+        fDetector->SetPlusZOnly(fPlusZOnlyCmd->GetNewBoolValue(value));
+    } else if (command == fFirstEntryOnlyCmd) {
+        fDetector->SetFirstEntryOnly(fFirstEntryOnlyCmd->GetNewBoolValue(value));
+    }
+}
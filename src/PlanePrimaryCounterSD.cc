@@ -0,0 +1,42 @@
+#include "PlanePrimaryCounterSD.hh"
+
+#include "EventAction.hh"
+#include "RunAction.hh"
+#include "VolumeRoleRegistry.hh"
+
+#include "G4EventManager.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+
+PlanePrimaryCounterSD::PlanePrimaryCounterSD(const G4String& name)
+    : G4VSensitiveDetector(name)
+{}
+
+G4bool PlanePrimaryCounterSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+    if (!step || step->GetTrack()->GetParentID() != 0) return false;
+
+    const G4StepPoint* pre  = step->GetPreStepPoint();
+    const G4StepPoint* post = step->GetPostStepPoint();
+    const G4VPhysicalVolume* prePV = pre->GetPhysicalVolume();
+    const G4int plane = prePV ? VolumeRoleRegistry::Lookup(prePV->GetLogicalVolume()).planeIndex : -1;
+    if (plane < 0) return false;
+
+    if (!fRunAction) {
+        const auto* eventAction = dynamic_cast<const EventAction*>(G4EventManager::GetEventManager()->GetUserEventAction());
+        fRunAction = eventAction ? eventAction->GetRunAction() : nullptr;
+        if (!fRunAction) return false;
+    }
+
+    const G4double weight = step->GetTrack()->GetWeight();
+
+    // Step fantôme : statut fGeomBoundary uniquement sur les frontières du monde parallèle
+    if (pre->GetStepStatus() == fGeomBoundary) fRunAction->CountPlanePrimEnter(plane, weight);
+
+    const G4StepStatus postStatus = post->GetStepStatus();
+    if ((postStatus == fGeomBoundary || postStatus == fWorldBoundary) && post->GetPhysicalVolume() != prePV) {
+        fRunAction->CountPlanePrimLeave(plane, weight);
+    }
+    return true;
+}
@@ -4,6 +4,7 @@
 #include "PrimaryGeneratorAction1.hh"
 #include "PrimaryGeneratorAction2.hh"
 #include "PrimaryGeneratorAction3.hh"
+#include "PrimaryGeneratorAction4.hh"
 
 #include "PrimaryGeneratorMessenger.hh"
 
@@ -32,6 +33,7 @@ PrimaryGeneratorAction::PrimaryGeneratorAction()
     fAction1 = new PrimaryGeneratorAction1(fParticleGun);
     fAction2 = new PrimaryGeneratorAction2(fParticleGun);
     fAction3 = new PrimaryGeneratorAction3(fParticleGun);
+    fAction4 = new PrimaryGeneratorAction4(fParticleGun);
 
     //create a messenger for this class
     fGunMessenger = new PrimaryGeneratorMessenger(this);
@@ -45,6 +47,7 @@ PrimaryGeneratorAction::~PrimaryGeneratorAction()
     delete fAction1;
     delete fAction2;
     delete fAction3;
+    delete fAction4;
 
     delete fGunMessenger;
 }
@@ -66,6 +69,9 @@ void PrimaryGeneratorAction::GeneratePrimaries(G4Event *anEvent)
         case 3:
             fAction3->GeneratePrimaries(anEvent);
             break;
+        case 4:
+            fAction4->GeneratePrimaries(anEvent);
+            break;
         default:
             G4cerr << "Invalid generator fAction" << G4endl;
     }
@@ -1,6 +1,7 @@
 #include "PrimaryGeneratorAction2.hh"
 #include "PrimaryGeneratorAction.hh"
 #include "DetectorConstruction.hh"
+#include "MiniXSpectrum.hh"
 
 #include "G4Event.hh"
 #include "G4Track.hh"
@@ -20,7 +21,17 @@
 #include "G4LogicalVolume.hh"
 #include "G4LogicalVolumeStore.hh"
 #include "G4ThreeVector.hh"
+#include "G4PrimaryVertex.hh"
 
+#include <algorithm>
+
+namespace {
+  // Coupure basse du spectre : les photons sous 3.5 keV ne sont pas émis
+  constexpr G4double kEcut = MiniXSpectrum::kCut_keV*keV;
+
+  // Clé du spectre Mini-X intégré dans le registre des tables (SpectrumSampler)
+  const char* const kBuiltinSpectrum = "builtin (Mini-X)";
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -37,6 +48,9 @@ PrimaryGeneratorAction2::PrimaryGeneratorAction2(G4ParticleGun* gun)
   fPsiMin = 0*deg;       //psi in [0, 2*pi]
   fPsiMax = 360*deg;
 
+  // cône biaisé par défaut : axe +z, ~ouverture du collimateur vue de la source (fBiasHalfAngle)
+  UpdateBiasCone();
+
   // energy distribution
   //
   InitFunction();
@@ -93,6 +107,14 @@ void PrimaryGeneratorAction2::InitializeAnodeVolume()
     G4cout << "  X : [" << fAnodeXmin/mm << ", " << fAnodeXmax/mm << "] mm" << G4endl;
     G4cout << "  Y : [" << fAnodeYmin/mm << ", " << fAnodeYmax/mm << "] mm" << G4endl;
     G4cout << "  Z : [" << fAnodeZmin/mm << ", " << fAnodeZmax/mm << "] mm" << G4endl;
+    // Grille d'occupation (une fois) : remplace le rejet dans toute la boîte à chaque événement
+    if (fAnodeVoxels.Build(fAnodeSolid, G4ThreeVector(fAnodeXmin, fAnodeYmin, fAnodeZmin),
+                           G4ThreeVector(fAnodeXmax, fAnodeYmax, fAnodeZmax))) {
+        G4cout << "Grille d'occupation : " << fAnodeVoxels.GetNbFull() << " voxels pleins, "
+               << fAnodeVoxels.GetNbPartial() << " partiels sur " << fAnodeVoxels.GetNbVoxels() << G4endl;
+    } else {
+        G4cout << "Grille d'occupation vide : tirage par rejet dans la boîte" << G4endl;
+    }
     G4cout << "Mode source volumique : ACTIVÉ" << G4endl;
     G4cout << "====================================================\n" << G4endl;
     
@@ -103,7 +125,7 @@ void PrimaryGeneratorAction2::InitializeAnodeVolume()
 
 // =====================================================
 // NOUVEAU : Génération d'une position aléatoire dans l'anode
-//           utilisant le rejection sampling
+//           par la grille d'occupation (rejection sampling en secours)
 // =====================================================
 G4ThreeVector PrimaryGeneratorAction2::GeneratePositionInAnode()
 {
@@ -118,6 +140,12 @@ G4ThreeVector PrimaryGeneratorAction2::GeneratePositionInAnode()
     }
     
     G4ThreeVector position;
+
+    // Grille d'occupation : voxel non vide puis point dans le voxel (même loi uniforme)
+    if (fAnodeVoxels.IsValid() && fAnodeVoxels.Sample(position)) {
+        return position;
+    }
+
     G4int maxAttempts = 100000;  // Limite pour éviter boucle infinie
     G4int attempts = 0;
     
@@ -193,17 +221,20 @@ void PrimaryGeneratorAction2::GeneratePrimaries(G4Event* anEvent)
  //G4cout << "positions sources x : " << x0 << " y : " << y0 << " z : " << z0 << G4endl;
   // uniform solid angle
 
-  //direction uniform in solid angle
-  G4double cosAlpha = fCosAlphaMin-G4UniformRand()*(fCosAlphaMin-fCosAlphaMax);
-  G4double sinAlpha = std::sqrt(1. - cosAlpha*cosAlpha);
-  G4double psi = fPsiMin + G4UniformRand()*(fPsiMax - fPsiMin);
+  //direction uniform in solid angle (ou biaisée, cf. SampleDirection : poids statistique)
+  G4double weight = 1.;
+  const G4ThreeVector dir = SampleDirection(weight);
+
+  G4double cosAlpha = dir.z();
+  G4double psi = std::atan2(dir.y(), dir.x());
+  if (psi < 0.) psi += twopi;
 
   G4double alpha = std::acos(cosAlpha);
   G4double alphaDeg = alpha / deg;
 
-  G4double ux = sinAlpha*std::cos(psi),
-  uy = sinAlpha*std::sin(psi),
-  uz = cosAlpha;
+  G4double ux = dir.x(),
+  uy = dir.y(),
+  uz = dir.z();
 
   // Direction fixée : +Z
   //G4double ux = 0.0;
@@ -219,20 +250,9 @@ void PrimaryGeneratorAction2::GeneratePrimaries(G4Event* anEvent)
   //G4cout << "angles alpha : " << alphaDeg << " phi : " << phiDeg << G4endl;
 
   fParticleGun->SetParticleMomentumDirection(G4ThreeVector(ux,uy,uz));
-  //set energy from a tabulated distribution
-  //G4double energy = RejectAccept();
-
-  // On SKIPPE l'événement si E <= 3.5 keV : pas de vertex, pas de comptage primaire.
-  static constexpr G4double kEcut = 3.5*keV;
-
+  // Spectre tronqué à kEcut, tiré en O(1) (table d'alias construite dans InitFunction)
+  const G4double energy = fSpectrum->Sample();
 
-  // Tirage énergie avec rejet sous le cut
-  G4double energy = 0.;
-  do {
-    energy = InverseCumul();   // ta loi tabulée existante
-  } while (energy <= kEcut);
-
-  // Si on passe le cut, on fixe l'énergie
   fParticleGun->SetParticleEnergy(energy);
 
   // LOG avant création du vertex (contrôle des valeurs réellement utilisées)
@@ -259,6 +279,12 @@ void PrimaryGeneratorAction2::GeneratePrimaries(G4Event* anEvent)
   // --- Création effective du vertex ---
   fParticleGun->GeneratePrimaryVertex(anEvent);
 
+  // Poids du biaisage porté par le vertex : G4PrimaryTransformer le donne à la trace primaire,
+  // les secondaires en héritent
+  if (fBiasMode != kBiasNone && anEvent->GetNumberOfPrimaryVertex() > 0) {
+    anEvent->GetPrimaryVertex(anEvent->GetNumberOfPrimaryVertex() - 1)->SetWeight(weight);
+  }
+
   // --- Compteurs RunAction : UNIQUEMENT APRES la création du vertex ---
   if (const auto* ra = static_cast<const RunAction*>(
     G4RunManager::GetRunManager()->GetUserRunAction())) {
@@ -271,114 +297,195 @@ void PrimaryGeneratorAction2::GeneratePrimaries(G4Event* anEvent)
     if (auto* man = G4AnalysisManager::Instance()) {
       G4double psiDeg = psi / deg;  // conversion en degrés
       
-      man->FillH1(0, energy);      // H0: Énergie à l'émission
-      man->FillH1(1, alphaDeg);    // H1: Theta à l'émission
-      man->FillH1(2, psiDeg);      // H2: Phi à l'émission
+      man->FillH1(0, energy, weight);      // H0: Énergie à l'émission
+      man->FillH1(1, alphaDeg, weight);    // H1: Theta à l'émission (pondéré : distribution source)
+      man->FillH1(2, psiDeg, weight);      // H2: Phi à l'émission
     }
 
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void PrimaryGeneratorAction2::InitFunction()
+// =====================================================
+// Biaisage de la direction d'émission
+//   p(u) = 1/ΔΩ_source sur le cône source (uniforme en cos(alpha) et psi)
+//   cône       : q(u) = (1-ε)·1[u·axe >= cos β]/ΔΩ_β + ε/ΔΩ_source
+//   cos(alpha) : q(u) = I_k / (Σ I_j · Δcos) / Δpsi, bin k de cos(alpha)
+//   poids = p(u) / q(u)
+// =====================================================
+G4ThreeVector PrimaryGeneratorAction2::SampleDirection(G4double& weight)
 {
+  weight = 1.;
+  const G4double dCosSource = fCosAlphaMin - fCosAlphaMax;
+  const G4double dPsiSource = fPsiMax - fPsiMin;
 
-  // tabulated function: Y>0, linear per segment, continuous
-  fNPoints = 50;
-  const G4double xx[] =
-  { 1*keV,  2*keV,  3*keV,  4*keV,  5*keV,
-    6*keV,  7*keV,  8*keV,  9*keV, 10*keV,
-    11*keV, 12*keV, 13*keV, 14*keV, 15*keV,
-    16*keV, 17*keV, 18*keV, 19*keV, 20*keV,
-    21*keV, 22*keV, 23*keV, 24*keV, 25*keV,
-    26*keV, 27*keV, 28*keV, 29*keV, 30*keV,
-    31*keV, 32*keV, 33*keV, 34*keV, 35*keV,
-    36*keV, 37*keV, 38*keV, 39*keV, 40*keV,
-    41*keV, 42*keV, 43*keV, 44*keV, 45*keV,
-    46*keV, 47*keV, 48*keV, 49*keV, 50*keV };
-
-  const G4double yy[] =
-    { 0.0205648, 63.56, 100.0, 90.93, 76.80, 64.72, 55.15, 47.59, 41.54, 36.61,
-      32.53, 29.10, 26.19, 23.68, 21.51, 19.60, 17.91, 16.41, 15.06, 13.85,
-      12.75, 11.75, 10.84, 10.00,  9.24,  8.53,  7.87,  7.26,  7.26,  6.16,
-      5.66,  5.20,  4.76,  4.35,  3.96,  3.59,  3.25,  2.92,  2.61,  2.31,
-      2.03,  1.76,  1.50,  1.26,  1.03,  0.80,  0.59,  0.39,  0.19,  0.00 };
-
-  // copy arrays in std::vector and compute fMax
-
-  fX.resize(fNPoints);
-  fY.resize(fNPoints);
-  fYmax = 0.;
-  for (G4int j = 0; j < fNPoints; j++) {
-    fX[j] = xx[j];
-    fY[j] = yy[j];
-    if (fYmax < fY[j]) fYmax = fY[j];
+  auto direction = [](G4double cosA, G4double psi) {
+    const G4double sinA = std::sqrt(std::max(0., 1. - cosA*cosA));
+    return G4ThreeVector(sinA*std::cos(psi), sinA*std::sin(psi), cosA);
   };
 
-  // pentes
-  fSlp.resize(fNPoints);
-  for (G4int j = 0; j < fNPoints - 1; j++) {
-      fSlp[j] = (fY[j + 1] - fY[j]) / (fX[j + 1] - fX[j]);
-  };
+  switch (fBiasMode) {
+    case kBiasCone: {
+      G4ThreeVector u;
+      if (G4UniformRand() < fBiasDefensive) {
+        u = direction(fCosAlphaMin - G4UniformRand()*dCosSource, fPsiMin + G4UniformRand()*dPsiSource);
+      } else {
+        u = direction(1. - G4UniformRand()*(1. - fBiasCosHalfAngle), twopi*G4UniformRand());
+        u.rotateUz(fBiasAxis);
+      }
+      const G4double solidSource = dCosSource * dPsiSource;
+      const G4double solidCone   = twopi * (1. - fBiasCosHalfAngle);
+      const G4bool   inCone      = u.dot(fBiasAxis) >= fBiasCosHalfAngle;
+      const G4double q = (inCone ? (1. - fBiasDefensive) / solidCone : 0.) + fBiasDefensive / solidSource;
+      weight = (1. / solidSource) / q;
+      return u;
+    }
+    case kBiasCosTheta: {
+      const std::size_t n = fCosImportance.size();
+      const G4double total = fCosImportanceCumul.back();
+      const G4double r = G4UniformRand() * total;
+      std::size_t k = std::upper_bound(fCosImportanceCumul.begin(), fCosImportanceCumul.end(), r)
+                      - fCosImportanceCumul.begin();
+      if (k >= n) {                                    // r == Σ I (arrondi) : dernier bin non nul
+        k = n - 1;
+        while (fCosImportance[k] <= 0.) --k;
+      }
+
+      const G4double binWidth = dCosSource / n;
+      const G4double cosA = fCosAlphaMax + (k + G4UniformRand()) * binWidth;
+      weight = total / (n * fCosImportance[k]);
+      return direction(cosA, fPsiMin + G4UniformRand()*dPsiSource);
+    }
+    case kBiasNone:
+    default:
+      return direction(fCosAlphaMin - G4UniformRand()*dCosSource, fPsiMin + G4UniformRand()*dPsiSource);
+  }
+}
 
-  // cumulée
-  fYC.resize(fNPoints);
-  fYC[0] = 0.;
-  for (G4int j = 1; j < fNPoints; j++) {
-          fYC[j] = fYC[j - 1] + 0.5 * (fY[j] + fY[j - 1]) * (fX[j] - fX[j - 1]);
-  };
+void PrimaryGeneratorAction2::SetBiasMode(BiasMode mode)
+{
+  if (mode == kBiasCosTheta && fCosImportance.empty()) {
+    G4cerr << "[GEN][BIAS][WARN] Carte d'importance en cos(alpha) vide "
+           << "(/primariesgenerator/bias/cosThetaImportance) : mode inchangé" << G4endl;
+    return;
+  }
+  fBiasMode = mode;
+  PrintBiasSettings();
 }
 
+void PrimaryGeneratorAction2::SetBiasConeAxis(const G4ThreeVector& axis)
+{
+  if (axis.mag2() <= 0. || axis.unit().z() < fCosAlphaMax) {
+    G4cerr << "[GEN][BIAS][WARN] Axe " << axis << " hors du cône source : axe inchangé" << G4endl;
+    return;
+  }
+  fBiasAxis = axis.unit();
+  UpdateBiasCone();
+}
+
+void PrimaryGeneratorAction2::SetBiasConeHalfAngle(G4double halfAngle)
+{
+  fBiasHalfAngle = halfAngle;
+  UpdateBiasCone();
+}
+
+// Le cône biaisé doit rester dans le cône source (sinon q > 0 là où p = 0) : demi-angle borné
+void PrimaryGeneratorAction2::UpdateBiasCone()
+{
+  const G4double alphaMax  = std::acos(fCosAlphaMax);
+  const G4double axisAngle = std::acos(std::min(1., std::max(-1., fBiasAxis.z())));
+  G4double beta = fBiasHalfAngle;
+  if (axisAngle + beta > alphaMax) {
+    beta = std::max(0.01*deg, alphaMax - axisAngle);
+    G4cerr << "[GEN][BIAS][WARN] Cône biaisé hors du cône source : demi-angle ramené à "
+           << beta/deg << " deg" << G4endl;
+  }
+  fBiasCosHalfAngle = std::cos(beta);
+  if (fBiasMode == kBiasCone) PrintBiasSettings();
+}
+
+void PrimaryGeneratorAction2::SetBiasDefensiveFraction(G4double fraction)
+{
+  fBiasDefensive = std::min(1., std::max(0., fraction));
+  if (fBiasMode == kBiasCone) PrintBiasSettings();
+}
+
+void PrimaryGeneratorAction2::SetCosThetaImportance(const std::vector<G4double>& importance)
+{
+  fCosImportance.clear();
+  fCosImportanceCumul.clear();
+  G4double sum = 0.;
+  for (G4double w : importance) {
+    fCosImportance.push_back(std::max(0., w));
+    sum += fCosImportance.back();
+    fCosImportanceCumul.push_back(sum);
+  }
+  if (sum <= 0.) {
+    G4cerr << "[GEN][BIAS][WARN] Carte d'importance nulle ignorée" << G4endl;
+    fCosImportance.clear();
+    fCosImportanceCumul.clear();
+    if (fBiasMode == kBiasCosTheta) fBiasMode = kBiasNone;
+    return;
+  }
+  if (fBiasMode == kBiasCosTheta) PrintBiasSettings();
+}
+
+void PrimaryGeneratorAction2::PrintBiasSettings() const
+{
+  const G4double solidSource = (fCosAlphaMin - fCosAlphaMax) * (fPsiMax - fPsiMin);
+
+  switch (fBiasMode) {
+    case kBiasCone: {
+      const G4double solidCone = twopi * (1. - fBiasCosHalfAngle);
+      G4cout << "[GEN][BIAS] Cône : axe " << fBiasAxis << ", demi-angle "
+             << std::acos(fBiasCosHalfAngle)/deg << " deg, fraction défensive " << fBiasDefensive
+             << " ; poids dans le cône = "
+             << 1. / ((1. - fBiasDefensive) * solidSource / solidCone + fBiasDefensive) << G4endl;
+      if (fBiasDefensive <= 0.) {
+        G4cout << "[GEN][BIAS] Fraction défensive nulle : les directions hors du cône ne sont jamais"
+               << " tirées (contributions correspondantes absentes, ex. diffusé de l'enveloppe)" << G4endl;
+      }
+      break;
+    }
+    case kBiasCosTheta:
+      G4cout << "[GEN][BIAS] Carte d'importance en cos(alpha) : " << fCosImportance.size()
+             << " bins sur [" << fCosAlphaMax << ", " << fCosAlphaMin << "]" << G4endl;
+      break;
+    case kBiasNone:
+    default:
+      G4cout << "[GEN][BIAS] Émission analogique (pas de biaisage)" << G4endl;
+  }
+}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-G4double PrimaryGeneratorAction2::RejectAccept()
+void PrimaryGeneratorAction2::InitFunction()
 {
-  // tabulated function
-  // Y is assumed positive, linear per segment, continuous
-  // (see Particle Data Group: pdg.lbl.gov --> Monte Carlo techniques)
-  //
-  G4double Xrndm = 0., Yrndm = 0., Yinter = -1.;
-
-  while (Yrndm > Yinter) {
-    //choose a point randomly
-    Xrndm = fX[0] + G4UniformRand()*(fX[fNPoints-1] - fX[0]);
-    Yrndm = G4UniformRand()*fYmax;
-    //find bin
-    G4int j = fNPoints-2;
-    while ((fX[j] > Xrndm) && (j > 0)) j--;
-    //compute Y(x_rndm) by linear interpolation
-    Yinter = fY[j] + fSlp[j]*(Xrndm - fX[j]);
-  };
-  return Xrndm;
+  // tabulated function: Y>0, linear per segment, continuous (MiniXSpectrum.hh)
+  fX.resize(MiniXSpectrum::kNbPoints);
+  fY.resize(MiniXSpectrum::kNbPoints);
+  for (G4int j = 0; j < MiniXSpectrum::kNbPoints; j++) {
+    fX[j] = MiniXSpectrum::kEnergy_keV[j]*keV;
+    fY[j] = MiniXSpectrum::kIntensity[j];
+  }
+
+  // table d'alias du spectre tronqué à kEcut, construite une fois et partagée par les threads
+  fSpectrum = SpectrumSampler::FromTable(kBuiltinSpectrum, fX, fY, kEcut);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-G4double PrimaryGeneratorAction2::InverseCumul()
+void PrimaryGeneratorAction2::SetSpectrumFile(const G4String& path)
 {
-  // tabulated function
-  // Y is assumed positive, linear per segment, continuous
-  // --> cumulative function is second order polynomial
-  // (see Particle Data Group: pdg.lbl.gov --> Monte Carlo techniques)
-
-  //choose y randomly
-  G4double Yrndm = G4UniformRand()*fYC[fNPoints-1];
-  //find bin
-  G4int j = fNPoints-2;
-  while ((fYC[j] > Yrndm) && (j > 0)) j--;
-  //y_rndm --> x_rndm :  fYC(x) is second order polynomial
-  G4double Xrndm = fX[j];
-  G4double a = fSlp[j];
-  if (a != 0.) {
-    G4double b = fY[j]/a, c = 2*(Yrndm - fYC[j])/a;
-    G4double delta = b*b + c;
-    G4int sign = 1; if (a < 0.) sign = -1;
-    Xrndm += sign*std::sqrt(delta) - b;
-  } else if (fY[j] > 0.) {
-    Xrndm += (Yrndm - fYC[j])/fY[j];
-  };
-  return Xrndm;
+  const SpectrumSampler* table = (path == "builtin")
+    ? SpectrumSampler::FromTable(kBuiltinSpectrum, fX, fY, kEcut)
+    : SpectrumSampler::FromFile(path, kEcut);
+
+  if (!table) {
+    G4cerr << "[GEN][WARN] Spectre " << path << " inutilisable : spectre courant conservé" << G4endl;
+    return;
+  }
+  fSpectrum = table;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
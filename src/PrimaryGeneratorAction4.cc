@@ -0,0 +1,209 @@
+#include "PrimaryGeneratorAction4.hh"
+
+#include "G4Event.hh"
+#include "G4ParticleGun.hh"
+#include "G4ParticleTable.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4Threading.hh"
+#include "Randomize.hh"
+#include "globals.hh"
+
+#include <cstring>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimaryGeneratorAction4::PrimaryGeneratorAction4(G4ParticleGun* gun)
+: fParticleGun(gun)
+{}
+
+PrimaryGeneratorAction4::~PrimaryGeneratorAction4()
+{
+  CloseFiles();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction4::SetFiles(const G4String& fileList)
+{
+  CloseFiles();
+  fFileNames.clear();
+  std::istringstream is(fileList);
+  std::string name;
+  while (is >> name) fFileNames.push_back(name);
+}
+
+void PrimaryGeneratorAction4::CloseFiles()
+{
+  for (auto& f : fFiles) {
+    if (f.base) munmap(f.base, f.size);
+  }
+  fFiles.clear();
+  fOpened = false;
+  fTotalRecords = 0;
+}
+
+// Projection des fichiers et contrôle des en-têtes ; fichiers invalides ignorés
+G4bool PrimaryGeneratorAction4::OpenFiles()
+{
+  CloseFiles();
+  std::uint64_t nHistories = 0;
+
+  for (const auto& name : fFileNames) {
+    const int fd = open(name.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(PhaseSpaceIO::FileHeader)) {
+      G4cerr << "[PSF][WARN] " << name << " illisible : ignoré" << G4endl;
+      if (fd >= 0) close(fd);
+      continue;
+    }
+
+    MappedFile f;
+    f.size = static_cast<std::size_t>(st.st_size);
+    f.base = mmap(nullptr, f.size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (f.base == MAP_FAILED) {
+      G4cerr << "[PSF][WARN] mmap impossible pour " << name << " : ignoré" << G4endl;
+      continue;
+    }
+    madvise(f.base, f.size, MADV_SEQUENTIAL);
+
+    PhaseSpaceIO::FileHeader header;
+    std::memcpy(&header, f.base, sizeof(header));
+    if (std::memcmp(header.magic, PhaseSpaceIO::kMagic, sizeof(header.magic)) != 0 ||
+        header.version != PhaseSpaceIO::kVersion || header.recordSize != sizeof(PhaseSpaceIO::Record)) {
+      G4cerr << "[PSF][WARN] " << name << " : en-tête incompatible, ignoré" << G4endl;
+      munmap(f.base, f.size);
+      continue;
+    }
+
+    // nRecords nul : fichier non refermé (run interrompu), on se fie à la taille
+    const std::uint64_t onDisk = (f.size - sizeof(header)) / sizeof(PhaseSpaceIO::Record);
+    f.nRecords   = (header.nRecords > 0 && header.nRecords <= onDisk) ? header.nRecords : onDisk;
+    f.nHistories = header.nHistories;
+    f.records    = reinterpret_cast<const PhaseSpaceIO::Record*>(static_cast<const char*>(f.base) + sizeof(header));
+    if (f.nRecords == 0) {
+      munmap(f.base, f.size);
+      continue;
+    }
+
+    G4cout << "[PSF] " << name << " : " << f.nRecords << " particules à z = " << header.zPlane_mm
+           << " mm, " << f.nHistories << " histoires" << G4endl;
+    fTotalRecords += f.nRecords;
+    nHistories += f.nHistories;
+    fFiles.push_back(f);
+  }
+
+  if (fFiles.empty()) return false;
+
+  // Plage [begin, end) propre au thread : les workers ne rejouent jamais les mêmes particules
+  fBegin = 0;
+  fEnd = fTotalRecords;
+  fWrapped = false;
+  const G4int tid = G4Threading::G4GetThreadId();
+  const G4int nThreads = G4Threading::GetNumberOfRunningWorkerThreads();
+  if (tid >= 0 && nThreads > 1) {
+    fBegin = fTotalRecords * static_cast<std::uint64_t>(tid) / static_cast<std::uint64_t>(nThreads);
+    fEnd   = fTotalRecords * static_cast<std::uint64_t>(tid + 1) / static_cast<std::uint64_t>(nThreads);
+    if (fBegin == fEnd) {
+      // Moins de particules que de threads : recouvrement inévitable
+      fBegin = static_cast<std::uint64_t>(tid) % fTotalRecords;
+      fEnd = fBegin + 1;
+      G4cout << "[PSF][WARN] " << fTotalRecords << " particules pour " << nThreads
+             << " threads : plages partagées (particules corrélées)" << G4endl;
+    }
+    G4cout << "[PSF] Thread " << tid << " : particules [" << fBegin << ", " << fEnd << ")" << G4endl;
+  }
+  Seek(fBegin);
+
+  G4cout << "[PSF] Relecture : " << fTotalRecords << " particules, recyclage x" << fRecycle
+         << (fRandomRotation ? ", rotation aléatoire autour de z" : "") << G4endl;
+  if (nHistories > 0) {
+    G4cout << "[PSF] 1 événement (" << fRecycle << " copie(s) d'une particule) = "
+           << static_cast<G4double>(nHistories) / fTotalRecords << " histoire(s) source" << G4endl;
+  }
+
+  fOpened = true;
+  return true;
+}
+
+void PrimaryGeneratorAction4::Seek(std::uint64_t index)
+{
+  fCursor = index;
+  fFileIdx = 0;
+  while (index >= fFiles[fFileIdx].nRecords) index -= fFiles[fFileIdx++].nRecords;
+  fRecordIdx = index;
+}
+
+void PrimaryGeneratorAction4::Advance()
+{
+  if (++fCursor >= fEnd) {
+    if (!fWrapped) {
+      G4cout << "[PSF][WARN] Fin de la plage [" << fBegin << ", " << fEnd
+             << ") du thread : reprise au début (particules corrélées)" << G4endl;
+      fWrapped = true;
+    }
+    Seek(fBegin);
+    return;
+  }
+  if (++fRecordIdx < fFiles[fFileIdx].nRecords) return;
+  fRecordIdx = 0;
+  ++fFileIdx;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction4::GeneratePrimaries(G4Event* anEvent)
+{
+  if (!fOpened && !OpenFiles()) {
+    G4Exception("PrimaryGeneratorAction4", "PSF01", FatalException,
+                "Aucun espace des phases lisible (/primariesgenerator/phasespace/file).");
+    return;
+  }
+
+  // Particule courante ; PDG inconnu de la table : particule sautée
+  const PhaseSpaceIO::Record* r = &fFiles[fFileIdx].records[fRecordIdx];
+  if (r->pdg != fLastPdg || !fLastParticle) {
+    for (std::uint64_t tries = 0; tries < fEnd - fBegin; ++tries) {
+      fLastPdg = r->pdg;
+      fLastParticle = G4ParticleTable::GetParticleTable()->FindParticle(r->pdg);
+      if (fLastParticle) break;
+      Advance();
+      r = &fFiles[fFileIdx].records[fRecordIdx];
+    }
+    if (!fLastParticle) {
+      G4Exception("PrimaryGeneratorAction4", "PSF02", FatalException, "Aucun PDG connu dans l'espace des phases.");
+      return;
+    }
+  }
+  fParticleGun->SetParticleDefinition(fLastParticle);
+  fParticleGun->SetParticleEnergy(r->ekin_keV * keV);
+
+  // Les N recyclages d'une particule sont corrélés : ils forment UN événement (N vertex),
+  // pour que l'incertitude histoire par histoire (Σx, Σx² par événement) reste valide.
+  // Poids du fichier (biaisage de l'étape 1) partagé entre les N copies.
+  const G4ThreeVector pos0(r->pos_mm[0]*mm, r->pos_mm[1]*mm, r->pos_mm[2]*mm);
+  const G4ThreeVector dir0 = G4ThreeVector(r->dir[0], r->dir[1], r->dir[2]).unit();
+  for (G4int copy = 0; copy < fRecycle; ++copy) {
+    G4ThreeVector pos = pos0, dir = dir0;
+    if (fRandomRotation) {
+      const G4double phi = twopi * G4UniformRand();
+      pos.rotateZ(phi);
+      dir.rotateZ(phi);
+    }
+    fParticleGun->SetParticlePosition(pos);
+    fParticleGun->SetParticleMomentumDirection(dir);
+    fParticleGun->GeneratePrimaryVertex(anEvent);
+    anEvent->GetPrimaryVertex(anEvent->GetNumberOfPrimaryVertex() - 1)->SetWeight(r->weight / fRecycle);
+  }
+
+  Advance();
+}
@@ -2,6 +2,16 @@
 #include "PrimaryGeneratorAction.hh"
 #include "G4UIdirectory.hh"
 #include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWith3Vector.hh"
+#include "G4UIcmdWithABool.hh"
+#include "PrimaryGeneratorAction2.hh"
+#include "PrimaryGeneratorAction4.hh"
+
+#include <sstream>
+#include <vector>
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -17,9 +27,72 @@ PrimaryGeneratorMessenger::PrimaryGeneratorMessenger(PrimaryGeneratorAction* Gun
   fSelectActionCmd->SetGuidance("1 Gamma 100keV");
   fSelectActionCmd->SetGuidance("2 Gamma Spectra");
   fSelectActionCmd->SetGuidance("3 Electron 200keV");
+  fSelectActionCmd->SetGuidance("4 Phase space replay (/primariesgenerator/phasespace/)");
   fSelectActionCmd->SetParameterName("id",false);
   fSelectActionCmd->SetRange("id>=0 && id<5");
   fSelectActionCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fSpectrumFileCmd = new G4UIcmdWithAString("/primariesgenerator/spectrumFile",this);
+  fSpectrumFileCmd->SetGuidance("Spectre en énergie de la source 2 : fichier texte / CSV (E_keV intensité)");
+  fSpectrumFileCmd->SetGuidance("builtin : spectre Mini-X intégré. Table mise en cache dans <fichier>.<hash>.spt");
+  fSpectrumFileCmd->SetParameterName("file",false);
+  fSpectrumFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fDirBias = new G4UIdirectory("/primariesgenerator/bias/");
+  fDirBias->SetGuidance("Biaisage de la direction d'émission de la source 2 (poids sur le primaire)");
+
+  fBiasModeCmd = new G4UIcmdWithAString("/primariesgenerator/bias/mode",this);
+  fBiasModeCmd->SetGuidance("none : émission analogique dans le cône de 60 deg");
+  fBiasModeCmd->SetGuidance("cone : directions dans le cône coneAxis / coneHalfAngle (+ fraction défensive)");
+  fBiasModeCmd->SetGuidance("cosTheta : carte d'importance en cos(alpha) (cosThetaImportance)");
+  fBiasModeCmd->SetParameterName("mode",false);
+  fBiasModeCmd->SetCandidates("none cone cosTheta");
+  fBiasModeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fBiasAxisCmd = new G4UIcmdWith3Vector("/primariesgenerator/bias/coneAxis",this);
+  fBiasAxisCmd->SetGuidance("Axe du cône biaisé (vers la sortie du collimateur), normalisé");
+  fBiasAxisCmd->SetParameterName("ux","uy","uz",false);
+  fBiasAxisCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fBiasHalfAngleCmd = new G4UIcmdWithADoubleAndUnit("/primariesgenerator/bias/coneHalfAngle",this);
+  fBiasHalfAngleCmd->SetGuidance("Demi-angle du cône biaisé (ouverture du collimateur vue de la source)");
+  fBiasHalfAngleCmd->SetParameterName("halfAngle",false);
+  fBiasHalfAngleCmd->SetRange("halfAngle>0");
+  fBiasHalfAngleCmd->SetDefaultUnit("deg");
+  fBiasHalfAngleCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fBiasDefensiveCmd = new G4UIcmdWithADouble("/primariesgenerator/bias/defensiveFraction",this);
+  fBiasDefensiveCmd->SetGuidance("Fraction de tirages analogues dans tout le cône source (0 : cône seul)");
+  fBiasDefensiveCmd->SetGuidance("> 0 garde les contributions hors cône (diffusé de l'enveloppe) avec un poids borné");
+  fBiasDefensiveCmd->SetParameterName("fraction",false);
+  fBiasDefensiveCmd->SetRange("fraction>=0 && fraction<=1");
+  fBiasDefensiveCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fBiasCosImportanceCmd = new G4UIcmdWithAString("/primariesgenerator/bias/cosThetaImportance",this);
+  fBiasCosImportanceCmd->SetGuidance("Importances de N bins égaux en cos(alpha), de cos(60 deg) à 1");
+  fBiasCosImportanceCmd->SetGuidance("ex. : 0.1 0.1 0.1 1 10 100");
+  fBiasCosImportanceCmd->SetParameterName("importances",false);
+  fBiasCosImportanceCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fDirPhaseSpace = new G4UIdirectory("/primariesgenerator/phasespace/");
+  fDirPhaseSpace->SetGuidance("Source 4 : relecture d'un espace des phases écrit par /phasespace/...");
+
+  fPhaseSpaceFileCmd = new G4UIcmdWithAString("/primariesgenerator/phasespace/file",this);
+  fPhaseSpaceFileCmd->SetGuidance("Fichier(s) .psf à rejouer, séparés par des espaces");
+  fPhaseSpaceFileCmd->SetGuidance("ex. : phasespace_run0_t0.psf phasespace_run0_t1.psf");
+  fPhaseSpaceFileCmd->SetParameterName("files",false);
+  fPhaseSpaceFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPhaseSpaceRecycleCmd = new G4UIcmdWithAnInteger("/primariesgenerator/phasespace/recycle",this);
+  fPhaseSpaceRecycleCmd->SetGuidance("Nombre d'utilisations de chaque particule (poids / N, N vertex dans un même événement), défaut 1");
+  fPhaseSpaceRecycleCmd->SetParameterName("n",false);
+  fPhaseSpaceRecycleCmd->SetRange("n>=1");
+  fPhaseSpaceRecycleCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPhaseSpaceRotationCmd = new G4UIcmdWithABool("/primariesgenerator/phasespace/randomRotation",this);
+  fPhaseSpaceRotationCmd->SetGuidance("Rotation aléatoire autour de z de chaque particule rejouée (défaut : true)");
+  fPhaseSpaceRotationCmd->SetParameterName("rotate",false);
+  fPhaseSpaceRotationCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -27,6 +100,17 @@ PrimaryGeneratorMessenger::PrimaryGeneratorMessenger(PrimaryGeneratorAction* Gun
 PrimaryGeneratorMessenger::~PrimaryGeneratorMessenger()
 {
   delete fSelectActionCmd;
+  delete fSpectrumFileCmd;
+  delete fBiasModeCmd;
+  delete fBiasAxisCmd;
+  delete fBiasHalfAngleCmd;
+  delete fBiasDefensiveCmd;
+  delete fBiasCosImportanceCmd;
+  delete fDirBias;
+  delete fPhaseSpaceFileCmd;
+  delete fPhaseSpaceRecycleCmd;
+  delete fPhaseSpaceRotationCmd;
+  delete fDirPhaseSpace;
   delete fDirGenerator;
 }
 
@@ -40,5 +124,39 @@ void PrimaryGeneratorMessenger::SetNewValue(G4UIcommand* command, G4String newVa
     fAction->SelectAction(SelectedAction);
     //G4cout<<"    Commande "<<SelectedAction<<G4endl;
     }
+
+  if (PrimaryGeneratorAction4* source4 = fAction->GetAction4()) {
+    if (command == fPhaseSpaceFileCmd)     { source4->SetFiles(newValue); return; }
+    if (command == fPhaseSpaceRecycleCmd)  { source4->SetRecycling(fPhaseSpaceRecycleCmd->GetNewIntValue(newValue)); return; }
+    if (command == fPhaseSpaceRotationCmd) { source4->SetRandomRotation(fPhaseSpaceRotationCmd->GetNewBoolValue(newValue)); return; }
+  }
+
+  PrimaryGeneratorAction2* source2 = fAction->GetAction2();
+  if (!source2) return;
+
+  if (command == fSpectrumFileCmd) {
+    source2->SetSpectrumFile(newValue);
+  }
+  else if (command == fBiasModeCmd) {
+    if (newValue == "cone")          source2->SetBiasMode(PrimaryGeneratorAction2::kBiasCone);
+    else if (newValue == "cosTheta") source2->SetBiasMode(PrimaryGeneratorAction2::kBiasCosTheta);
+    else                             source2->SetBiasMode(PrimaryGeneratorAction2::kBiasNone);
+  }
+  else if (command == fBiasAxisCmd) {
+    source2->SetBiasConeAxis(fBiasAxisCmd->GetNew3VectorValue(newValue));
+  }
+  else if (command == fBiasHalfAngleCmd) {
+    source2->SetBiasConeHalfAngle(fBiasHalfAngleCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fBiasDefensiveCmd) {
+    source2->SetBiasDefensiveFraction(fBiasDefensiveCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fBiasCosImportanceCmd) {
+    std::vector<G4double> importance;
+    std::istringstream is(newValue);
+    G4double w = 0.;
+    while (is >> w) importance.push_back(w);
+    source2->SetCosThetaImportance(importance);
+  }
   }
 
@@ -0,0 +1,122 @@
+#include "PrimaryLossTable.hh"
+
+#include "G4AccumulableManager.hh"
+#include "G4ProcessTable.hh"
+#include "G4ProcessVector.hh"
+#include "G4ios.hh"
+
+#include <iomanip>
+#include <map>
+
+PrimaryLossTable::PrimaryLossTable()
+: fCounts("PrimaryLossCounts",
+          static_cast<std::size_t>(kNbProcSlots) * kNbMatSlots * kNbEBins),
+  fSlotBySubType(kMaxSubType, 0),
+  fSlotNames(kNbProcSlots, "Other")
+{
+    fSlotNames[0] = "Unknown";
+}
+
+void PrimaryLossTable::Register(G4AccumulableManager* accMgr)
+{
+    accMgr->Register(&fCounts);
+}
+
+// Sous-types triés -> slots 1..kNbProcSlots-1 ; même physique sur tous les threads
+// donc même table partout (le master s'en sert pour nommer les slots au Print()).
+void PrimaryLossTable::BuildProcessSlots()
+{
+    std::fill(fSlotBySubType.begin(), fSlotBySubType.end(), 0);
+    std::fill(fSlotNames.begin(), fSlotNames.end(), G4String("Other"));
+    fSlotNames[0] = "Unknown";
+
+    auto* procTable = G4ProcessTable::GetProcessTable();
+    const auto* names = procTable ? procTable->GetNameList() : nullptr;
+    if (!names) return;
+
+    std::map<G4int, G4String> bySubType;   // sous-type -> premier nom rencontré
+    for (const auto& name : *names) {
+        G4ProcessVector* procs = procTable->FindProcesses(name);
+        if (!procs) continue;
+        for (std::size_t i = 0; i < procs->size(); ++i) {
+            const G4VProcess* proc = (*procs)[i];
+            if (!proc) continue;
+            const G4int sub = proc->GetProcessSubType();
+            if (sub < 0 || sub >= kMaxSubType) continue;
+            bySubType.emplace(sub, proc->GetProcessName());
+        }
+        delete procs;
+    }
+
+    G4int slot = 1;
+    for (const auto& kv : bySubType) {
+        if (slot >= kNbProcSlots) {
+            G4cout << "[LOSS][WARN] plus de " << kNbProcSlots - 1
+                   << " sous-types de processus, les suivants sont comptés dans 'Other'" << G4endl;
+            break;
+        }
+        fSlotBySubType[kv.first] = slot;
+        fSlotNames[slot] = kv.second;
+        ++slot;
+    }
+}
+
+void PrimaryLossTable::Print() const
+{
+    std::vector<G4long> byProc(kNbProcSlots, 0);
+    std::vector<G4long> byMat(kNbMatSlots, 0);
+    std::vector<G4long> byE(kNbEBins, 0);
+    G4long total = 0;
+
+    for (G4int p = 0; p < kNbProcSlots; ++p)
+        for (G4int m = 0; m < kNbMatSlots; ++m)
+            for (G4int e = 0; e < kNbEBins; ++e) {
+                const G4long n = fCounts[Index(p, m, e)];
+                byProc[p] += n;
+                byMat[m]  += n;
+                byE[e]    += n;
+                total     += n;
+            }
+
+    if (total == 0) {
+        G4cout << "[LOSS] no primary lost before z=60 mm" << G4endl;
+        return;
+    }
+
+    const auto* matTable = G4Material::GetMaterialTable();
+    auto matName = [matTable](G4int m) -> G4String {
+        if (m < kNbMatSlots - 1 && matTable && m < static_cast<G4int>(matTable->size()))
+            return (*matTable)[m]->GetName();
+        return "Other";
+    };
+
+    G4cout << "[LOSS][BY-PROC]" << G4endl;
+    for (G4int p = 0; p < kNbProcSlots; ++p)
+        if (byProc[p] > 0) G4cout << "  " << fSlotNames[p] << " : " << byProc[p] << G4endl;
+
+    G4cout << "[LOSS][BY-MAT]" << G4endl;
+    for (G4int m = 0; m < kNbMatSlots; ++m)
+        if (byMat[m] > 0) G4cout << "  " << matName(m) << " : " << byMat[m] << G4endl;
+
+    G4cout << "[LOSS][BY-E] (bins de " << kEBinWidth/keV << " keV, dernier = débordement)" << G4endl;
+    for (G4int e = 0; e < kNbEBins; ++e)
+        if (byE[e] > 0)
+            G4cout << "  [" << std::setw(3) << e*kEBinWidth/keV << ", "
+                   << std::setw(3) << (e+1)*kEBinWidth/keV << ") keV : " << byE[e] << G4endl;
+
+    // Détail (processus, matériau) résolu en énergie, uniquement pour les couples non vides
+    G4cout << "[LOSS][DETAIL] processus / matériau : comptes par bin de "
+           << kEBinWidth/keV << " keV" << G4endl;
+    for (G4int p = 0; p < kNbProcSlots; ++p) {
+        if (byProc[p] == 0) continue;
+        for (G4int m = 0; m < kNbMatSlots; ++m) {
+            G4long sum = 0;
+            for (G4int e = 0; e < kNbEBins; ++e) sum += fCounts[Index(p, m, e)];
+            if (sum == 0) continue;
+            G4cout << "  " << std::left << std::setw(16) << fSlotNames[p]
+                   << std::setw(20) << matName(m) << std::right << " :";
+            for (G4int e = 0; e < kNbEBins; ++e) G4cout << " " << fCounts[Index(p, m, e)];
+            G4cout << G4endl;
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#include "ProcessIdTable.hh"
+
+#include "G4AnalysisManager.hh"
+#include "G4AutoLock.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "G4ProcessTable.hh"
+#include "G4VProcess.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+std::vector<G4String> ProcessIdTable::fNames;
+
+namespace {
+    G4Mutex gProcessIdMutex = G4MUTEX_INITIALIZER;
+
+    using ProcessIdCache = std::unordered_map<const G4VProcess*, ProcessIdTable::Id>;
+
+    ProcessIdCache& ThreadCache()
+    {
+        static G4ThreadLocal ProcessIdCache* cache = nullptr;
+        if (!cache) cache = new ProcessIdCache();
+        return *cache;
+    }
+}
+
+void ProcessIdTable::Build()
+{
+    G4AutoLock lock(&gProcessIdMutex);
+    if (!fNames.empty()) return;
+
+    std::vector<G4String> names;
+    if (auto* procTable = G4ProcessTable::GetProcessTable()) {
+        if (const auto* list = procTable->GetNameList()) names = *list;
+    }
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+
+    fNames.reserve(names.size() + 2);
+    fNames.push_back("primary");   // kPrimaryId
+    fNames.push_back("unknown");   // kUnknownId
+    for (const auto& n : names) {
+        if (fNames.size() > std::numeric_limits<Id>::max()) break;
+        fNames.push_back(n);
+    }
+
+    G4cout << "[PROC][IDS] Table des processus construite : " << fNames.size() - 2
+           << " processus" << G4endl;
+}
+
+ProcessIdTable::Id ProcessIdTable::GetId(const G4VProcess* proc)
+{
+    if (!proc) return kPrimaryId;
+
+    auto& cache = ThreadCache();
+    const auto it = cache.find(proc);
+    if (it != cache.end()) return it->second;
+
+    const Id id = LookupSlow(proc);
+    cache.emplace(proc, id);
+    return id;
+}
+
+// Premier passage d'un processus sur ce thread : recherche dichotomique du nom
+ProcessIdTable::Id ProcessIdTable::LookupSlow(const G4VProcess* proc)
+{
+    G4AutoLock lock(&gProcessIdMutex);
+    if (fNames.size() <= 2) return kUnknownId;
+    const auto first = fNames.begin() + 2;
+    const auto it = std::lower_bound(first, fNames.end(), proc->GetProcessName());
+    if (it == fNames.end() || *it != proc->GetProcessName()) return kUnknownId;
+    return static_cast<Id>(it - fNames.begin());
+}
+
+const G4String& ProcessIdTable::GetName(G4int id)
+{
+    static const G4String kInvalid = "invalid";
+    return (id >= 0 && id < Size()) ? fNames[id] : kInvalid;
+}
+
+void ProcessIdTable::FillDictionaryNtuple(G4int ntupleId)
+{
+    auto* man = G4AnalysisManager::Instance();
+    if (ntupleId < 0 || !man || !man->IsActive()) return;
+
+    for (G4int id = 0; id < Size(); ++id) {
+        man->FillNtupleIColumn(ntupleId, 0, 0);
+        man->FillNtupleIColumn(ntupleId, 1, id);
+        man->FillNtupleSColumn(ntupleId, 2, fNames[id]);
+        man->AddNtupleRow(ntupleId);
+    }
+
+    // Particules : le PDG sert directement d'identifiant dans les ntuples
+    auto* particleIt = G4ParticleTable::GetParticleTable()->GetIterator();
+    particleIt->reset();
+    while ((*particleIt)()) {
+        const G4ParticleDefinition* def = particleIt->value();
+        if (!def || def->GetPDGEncoding() == 0) continue;
+        man->FillNtupleIColumn(ntupleId, 0, 1);
+        man->FillNtupleIColumn(ntupleId, 1, def->GetPDGEncoding());
+        man->FillNtupleSColumn(ntupleId, 2, def->GetParticleName());
+        man->AddNtupleRow(ntupleId);
+    }
+}
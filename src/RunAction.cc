@@ -13,22 +13,24 @@
 #include "G4RunManager.hh"
 #include "G4SDManager.hh"
 #include "SurfaceSpectrumSD.hh"
+#include "DetectorConstruction.hh"
+#include "SteppingAction.hh"
+#include "MuEnTable.hh"
 
+#include "G4EventManager.hh"
+#include "G4Material.hh"
+
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
+#include <string>
 
-#include "SphereHit.hh"
-#include "SteppingAction.hh"  // Pour le suivi step par step
-
-extern G4long gEnterPlanePrim;
-extern G4long gLeavePlanePrim;
-
-extern G4long gEnterPlanePrim;
-extern G4long gLeavePlanePrim;
-
-// maps définies dans SteppingAction.cc
-extern std::map<std::string,int> gLostByProc;
-extern std::map<std::string,int> gLostByMat;
+#include "SphereHitSink.hh"     // Hits SphereSD écrits en flux (plus de stockage par événement)
+#include "StepTraceRecorder.hh"  // Pour le suivi step par step
+#include "PhaseSpaceWriter.hh"   // Espace des phases à la sortie du collimateur (/phasespace/...)
+#include "VolumeRoleRegistry.hh"
+#include "ProcessIdTable.hh"
 
 // ============================================================================
 // [ADD] Helper de logs : SEQ en mono-thread, sinon MT-MASTER / MT-WORKER
@@ -42,7 +44,9 @@ namespace {
         #endif
     }
     // [ADD] Protéger SetupAnalysis() contre une double exécution (si 2 ctors utilisés)
-    static bool gAnalysisSetupDone = false;
+    // [FIX] Par thread : chaque G4AnalysisManager (master et workers) doit déclarer
+    //       ses histogrammes / ntuples pour que la fusion au Write() fonctionne
+    G4ThreadLocal bool gAnalysisSetupDone = false;
 } // namespace
 
 //  Ce constructeur initialise les accumulateurs globaux utilisés pour compter, sur l’ensemble du run :
@@ -81,8 +85,22 @@ fTotalEntrantInWaterSphere(0), fTotalInteractedInWaterSphere(0)
     // [ADD] compteur global des primaires (option B)
     accMgr->Register(fPrimariesGenerated);
 
+    // [LOSS] table dense processus × matériau × énergie (même ordre d'enregistrement master/workers)
+    fLossTable.Register(accMgr);
+    fDoseMesh.Register(accMgr);
+
+    // Compteurs ENTER/LEAVE des primaires par plan de scoring
+    accMgr->Register(&fPlanePrimCrossings);
+    accMgr->Register(&fPlanePrimWeights);
+    accMgr->Register(&fDoseSums);
+    accMgr->Register(&fTleSums);
+    accMgr->Register(&fDepthEdep);
+
     fRunMessenger = new RunMessenger(this);
 
+    // Écriture de l'espace des phases : instance (et commandes /phasespace/...) créée sur chaque thread
+    PhaseSpaceWriter::Instance();
+
     // -------------------- [ADD] Activation & setup analysis --------------------
     if (!gAnalysisSetupDone) {
         auto* am = G4AnalysisManager::Instance();
@@ -98,41 +116,20 @@ fTotalEntrantInWaterSphere(0), fTotalInteractedInWaterSphere(0)
 //      - auto eventAction = new EventAction();
 //      - auto runAction   = new RunAction(eventAction);
 //
-//  On indique à Geant4 : "Je veux que ces compteurs soient suivis, fusionnés, et accessibles à la fin du run".
-//  Cela permet :
-//      - De faire un Reset() automatique au début du run
-//      - De faire un Merge() en multithread pour combiner les valeurs
-//      - D’utiliser GetValue() pour accéder aux résultats finaux
-RunAction::RunAction(EventAction* eventAction)
-: fTotalEntrantInBe(0), fTotalInteractedInBe(0),
-fTotalEntrantInWaterSphere(0), fTotalInteractedInWaterSphere(0)
+//  Délègue au constructeur par défaut : un seul bloc d'enregistrement des accumulateurs,
+//  identique (et dans le même ordre) sur le master et les workers.
+RunAction::RunAction(EventAction*)
+: RunAction()
 {
-    auto accMgr = G4AccumulableManager::Instance();
-    accMgr->Register(fTotalEntrantInBe);
-    accMgr->Register(fTotalInteractedInBe);
-    accMgr->Register(fTotalEntrantInWaterSphere);
-    accMgr->Register(fTotalInteractedInWaterSphere);
-
-    accMgr->Register(fNValidParticles_lt_35);
-    accMgr->Register(fNValidParticles_gt_35);
-
-    // [ADD] compteur global des primaires (option B)
-    accMgr->Register(fPrimariesGenerated);
-
-    fRunMessenger = new RunMessenger(this);
-
-    // -------------------- [ADD] Activation & setup analysis --------------------
-    if (!gAnalysisSetupDone) {
-        auto* am = G4AnalysisManager::Instance();
-        am->SetActivation(true);   // [ADD]
-        SetupAnalysis();           // [ADD]
-        gAnalysisSetupDone = true;
-    }
     // (si besoin, stocke eventAction dans un membre ici)
 }
 
 RunAction::~RunAction(){
-    delete fRunMessenger;}
+    delete fRunMessenger;
+    // Fin du thread : fichiers refermés et tampons par thread libérés
+    StepTraceRecorder::Destroy();
+    SphereHitSink::Destroy();
+    PhaseSpaceWriter::Destroy();}
 
 G4int RunAction::GetTotalEntrantInBe() const {
     return fTotalEntrantInBe.GetValue();}
@@ -149,15 +146,56 @@ G4int RunAction::GetTotalInteractedInWaterSphere() const {
 void RunAction::BeginOfRunAction(const G4Run* run)
 {
     // ==================== Step Tracking ====================
-    // Réinitialiser le compteur et imprimer l'en-tête du tableau
-    SteppingAction::ResetTrackedParticlesCount();
+    // Trace binaire du thread courant : nouveau fichier par run (ouvert au premier step tracé)
+    StepTraceRecorder::Instance()->BeginRun(run->GetRunID());
+    SphereHitSink::Instance()->BeginRun(run->GetRunID(), fRunVerbose);
+    PhaseSpaceWriter::Instance()->BeginRun(run->GetRunID());
     // =======================================================
 
-    auto* am = G4AnalysisManager::Instance();
+    // [FIX] Reset des accumulables sur chaque thread (les workers gardaient sinon
+    //       les comptes du run précédent), puis slots de processus de la table [LOSS]
+    G4AccumulableManager::Instance()->Reset();
+    fLossTable.BuildProcessSlots();
+
+    // Grille de dose : dimensions (/dose/mesh/...) et binning des H3 sur chaque thread
+    fDoseMesh.BeginRun(G4Threading::IsMasterThread());
+
+    // Profil en profondeur : binning sur l'épaisseur d'eau réelle, H2 identiques sur chaque thread
+    if (const auto* detector = dynamic_cast<const DetectorConstruction*>(
+            G4RunManager::GetRunManager()->GetUserDetectorConstruction())) {
+        G4double radialStep = 0., halfZ = 0., zCenter = 0.;
+        detector->GetWaterRingGeometry(radialStep, halfZ, zCenter);
+        if (halfZ > 0.) {
+            fDepthHalfZ = halfZ;
+            fDepthInvWidth = kNbDepthBins / (2. * halfZ);
+        }
 
-    #ifdef G4MULTITHREADED
-    if (!G4Threading::IsMasterThread()) return;
-    #endif
+        // Estimateur par longueur de trace demandé (workers / séquentiel) : sans μen/ρ pour
+        // le matériau des couronnes, il ne compterait rien ; arrêt plutôt qu'un bilan vide
+        const auto* stepping = dynamic_cast<const SteppingAction*>(
+            G4EventManager::GetEventManager()->GetUserSteppingAction());
+        const G4Material* ringMaterial = detector->GetWaterRingMaterial();
+        if (stepping && stepping->GetTrackLengthEstimator() && !MuEnTable::ForMaterial(ringMaterial)) {
+            G4ExceptionDescription ed;
+            ed << "/stepping/trackLengthEstimator actif mais μen/ρ non tabulé pour le matériau des couronnes ("
+               << (ringMaterial ? ringMaterial->GetName() : G4String("aucun")) << ").";
+            G4Exception("RunAction::BeginOfRunAction", "TLE01", FatalException, ed);
+        }
+    }
+    for (const G4int id : {GetDepthEdepH2Id(), GetDepthDoseH2Id()}) {
+        if (id >= 0) {
+            G4AnalysisManager::Instance()->SetH2(id, kNbWaterRings, -0.5, kNbWaterRings - 0.5,
+                                                 kNbDepthBins, 0., 2. * fDepthHalfZ / mm);
+        }
+    }
+
+    // Critère d'arrêt sur incertitude (chaque thread juge sur ses propres événements)
+    fConvergence.BeginRun();
+
+    // Table processus -> id (run-wide, construite une seule fois ; sans effet ensuite)
+    ProcessIdTable::Build();
+
+    auto* am = G4AnalysisManager::Instance();
 
     //G4cout << ThreadTag() << " [RUN] BeginOfRunAction: start run "<< run->GetRunID() << G4endl;
 
@@ -167,17 +205,25 @@ void RunAction::BeginOfRunAction(const G4Run* run)
     //G4cout << ThreadTag() << " [RUN] IsActive AFTER  = " << am->IsActive() << G4endl; // [LOG]
 
     // [ADD] Ouvrir (ou rouvrir) le fichier en début de run
+    // [FIX] Sur tous les threads : les workers n'écrivent pas de fichier propre
+    //       (histogrammes et ntuples fusionnés dans celui du master), mais doivent l'ouvrir
     am->OpenFile("output.root");
+
+    #ifdef G4MULTITHREADED
+    if (!G4Threading::IsMasterThread()) return;
+    #endif
+
+    // Temps réel du run pour l'efficacité des estimateurs de dose (arrêté en EndOfRunAction)
+    fRunTimer.Start();
+
+    // Dictionnaire des identifiants internés (processus / particules), une fois par fichier
+    ProcessIdTable::FillDictionaryNtuple(GetDictionaryNtupleId());
     //G4cout << ThreadTag() << " [RUN] Opened analysis file: output.root" << G4endl;    // [LOG]
 
     // [ADD] (optionnel) log d’ID de l’ntuple plane_passages
     //G4cout << "[RUN] plane_passages ntuple id = " << GetPlanePassageNtupleId() << G4endl; // [LOG]
 
 
-    // Réinitialiser les accumulateurs pour ce run
-    G4AccumulableManager::Instance()->Reset();
-
-
     // [KEEP] Câblage du SensitiveDetector « SpecSD » vers l’ID de l’ntuple plane_passages
     {
         auto* sdMan = G4SDManager::GetSDMpointer();
@@ -208,6 +254,8 @@ void RunAction::BeginOfRunAction(const G4Run* run)
     // Réinitialiser les compteurs de photons transmis
     fTransmitted10000 = 0;
     fTransmittedTotal = 0;
+    fTransmittedWeight10000 = 0.;
+    fTransmittedWeightTotal = 0.;
 }
 
 //  La fonction RunAction::EndOfRunAction(const G4Run*)est appelée automatiquement
@@ -217,9 +265,15 @@ void RunAction::BeginOfRunAction(const G4Run* run)
 //      - Afficher un résumé du run
 //      - Afficher un bilan des hits par événement
 //      - Fermer correctement le fichier d’analyse
-void RunAction::EndOfRunAction(const G4Run*)
+void RunAction::EndOfRunAction(const G4Run* run)
 {
     auto* am = G4AnalysisManager::Instance();
+
+    // ==================== Step Tracking ====================
+    // Chaque thread vide son tampon de trace et ferme son fichier
+    StepTraceRecorder::Instance()->EndRun();
+    SphereHitSink::Instance()->EndRun();
+    PhaseSpaceWriter::Instance()->EndRun(run->GetNumberOfEvent());
     //G4cout << "[RunAction] Fin du run, appel à FinalizeAnalysis()" << G4endl;
 
     //Fusion des accumulateurs (multithreading)
@@ -227,6 +281,8 @@ void RunAction::EndOfRunAction(const G4Run*)
     //    -Cette ligne fusionne tous les compteurs en un total global.
     //    -En mono-thread, cela n’a aucun effet néfaste.
 
+    // Bilan du critère d'arrêt (par thread : chaque thread juge sur ses propres événements)
+    fConvergence.EndRun();
 
     G4AccumulableManager::Instance()->Merge();
 
@@ -236,6 +292,14 @@ void RunAction::EndOfRunAction(const G4Run*)
     isMaster = G4Threading::IsMasterThread();
     #endif
 
+    // [FIX] Workers : Write() fusionne leurs histogrammes (Σw, Σw²) et ntuples dans le master,
+    //       qui écrit ensuite le fichier unique (EndOfRunAction des workers avant celle du master)
+    if (!isMaster) {
+        am->Write();
+        am->CloseFile(false);
+        return;
+    }
+
     if (isMaster) {
         // (sécurité) s’assurer que l’analyse est bien active pour Write/Close
         if (!am->IsActive()) {
@@ -268,19 +332,7 @@ void RunAction::EndOfRunAction(const G4Run*)
         << fTotalInteractedInWaterSphere.GetValue() << G4endl;
         G4cout << "===============================================" << G4endl;
 
-        // Bilan hits par évènement
-        for (const auto& kv : fHitsByEvent) {
-            auto eventID = kv.first;
-            const auto& hits = kv.second;
-            G4double totalEdep = 0.0;
-            for (const auto& hit : hits) totalEdep += hit.GetEdep();
-
-            if (fRunVerbose == 1) {
-                G4cout << "→ Event #" << eventID
-                << " : " << hits.size() << " hits, "
-                << "E_dep total = " << totalEdep / keV << " keV" << G4endl;
-            }
-        }
+        // Bilan hits par évènement : imprimé au fil de l'eau par SphereHitSink (fRunVerbose == 1)
 
         // Récap “spectre émission”
         G4cout << "========== Résumé spectre emission ==========" << G4endl;
@@ -290,42 +342,28 @@ void RunAction::EndOfRunAction(const G4Run*)
         << fNValidParticles_gt_35.GetValue() << G4endl;
         G4cout << "=============================================" << G4endl;
 
-        // Compteurs côté Stepping : primaires au plan
-        G4cout << "[STEP][SUMMARY] enter_plane_prim=" << gEnterPlanePrim
-        << " leave_plane_prim=" << gLeavePlanePrim << G4endl;
+        // Compteurs côté Stepping : primaires aux plans de scoring
+        for (G4int p = 0; p < VolumeRoleRegistry::kNbScorePlanes; ++p) {
+            G4cout << "[STEP][SUMMARY] " << VolumeRoleRegistry::GetScorePlaneName(p)
+            << " enter_plane_prim=" << fPlanePrimCrossings[2*p]
+            << " leave_plane_prim=" << fPlanePrimCrossings[2*p + 1]
+            << " enter_plane_prim_w=" << fPlanePrimWeights[4*p]
+            << " leave_plane_prim_w=" << fPlanePrimWeights[4*p + 2] << G4endl;
+        }
 
 
         auto* sdm = G4SDManager::GetSDMpointer();
         if (auto* sd = dynamic_cast<SurfaceSpectrumSD*>(sdm->FindSensitiveDetector("SpecSD", false))) {
             sd->PrintSummary();
 
-            // [LOSS] Pertes de primaires avant z=60 mm : ventilation
-            if (!gLostByProc.empty() || !gLostByMat.empty()) {
-                G4cout << "[LOSS][BY-PROC]" << G4endl;
-                for (const auto& kv : gLostByProc) {
-                    G4cout << "  " << kv.first << " : " << kv.second << G4endl;
-                }
-                G4cout << "[LOSS][BY-MAT]" << G4endl;
-                for (const auto& kv : gLostByMat) {
-                    G4cout << "  " << kv.first << " : " << kv.second << G4endl;
-                }
-            } else {
-                G4cout << "[LOSS] no primary lost before z=60 mm (maps empty)" << G4endl;
-            }
         } else {
             G4cout << "[WARN] SpecSD not found in SDManager at EndOfRunAction()" << G4endl;
         }
 
-        G4cout << "=======================================================\n";
+        // [LOSS] Pertes de primaires avant z=60 mm : ventilation processus / matériau / énergie
+        fLossTable.Print();
 
-        // ==================== Step Tracking Summary ====================
-        G4cout << "\n================================================================================\n"
-               << "FIN DU SUIVI STEP PAR STEP - " << SteppingAction::GetTrackedParticlesCount() 
-               << " evenements suivis (max=" 
-               << SteppingAction::GetMaxTrackedParticles() << ")\n"
-               << "================================================================================\n" 
-               << G4endl;
-        // ===============================================================
+        G4cout << "=======================================================\n";
 
         // ==================== Remplissage des histogrammes de DOSE (fin de run) ====================
         // Conversion : Edep (keV) -> Dose (pGy)
@@ -364,8 +402,24 @@ void RunAction::EndOfRunAction(const G4Run*)
                    << dose_ring_nGy << " nGy\n";
         }
         G4cout << "=====================================================\n";
+
+        // Dose moyenne ± erreur relative et efficacité, par anneau et pour l'eau totale
+        fRunTimer.Stop();
+        const G4long nEvents = run ? run->GetNumberOfEvent() : 0;
+        ReportDoseStatistics(fDoseSums, 0, nEvents, fRunTimer.GetRealElapsed());
+        // Estimateur par longueur de trace : matériau des couronnes vérifié en début de run
+        // (TLE01), une somme nulle signifie donc que l'estimateur n'était pas demandé
+        if (fTleSums[2*kNbWaterRings] > 0.) {
+            ReportDoseStatistics(fTleSums, 1, nEvents, fRunTimer.GetRealElapsed());
+        }
         // ====================================================================================
 
+        // Grille de dose 3D (accumulables fusionnés ci-dessus)
+        fDoseMesh.Write(GetDoseMeshH3Id(), GetDoseMeshMassH3Id());
+
+        // Profil anneau × profondeur (accumulables fusionnés ci-dessus)
+        WriteDepthProfile();
+
         // 3) Écriture / fermeture du ROOT (une seule fois)
         G4cout << ThreadTag() << " [RUN] EndOfRunAction: about to Write()" << G4endl;
         am->Write();
@@ -406,29 +460,6 @@ void RunAction::UpdateFromEvent(const EventAction* event)
 
 }
 
-//  La fonction suivante est une méthode simple mais importante dans ta classe RunAction :
-//  Cette méthode permet d’associer tous les SphereHit d’un événement donné à son eventID,
-//  en les enregistrant dans une structure de données interne à RunAction. Cela permet :
-//    - De stocker les hits pour chaque événement
-//    - De les analyser ou résumer à la fin du run (EndOfRunAction)
-//    - D’accéder facilement à tous les hits d’un événement spécifique
-//
-//  eventID : identifiant de l’événement courant, fourni par Geant4 (ex: 0, 1, 2…)
-//  hits : vecteur de SphereHit, contenant tous les hits détectés dans la sphère d’eau durant cet événement
-void RunAction::AddHitsForEvent(G4int eventID, const std::vector<SphereHit>& hits)
-{
-    //  Stockage dans une map
-    //  fHitsByEvent est un std::map<G4int, std::vector<SphereHit>> (déclarée dans RunAction.hh)
-    //  Cette ligne associe le vecteur hits à l’eventID dans la map
-    //  Si une entrée existait déjà pour cet eventID, elle est remplacée.
-    fHitsByEvent[eventID] = hits;
-}
-//  À la fin du run (EndOfRunAction), on peut écrire :
-//  for (const auto& [eventID, hits] : fHitsByEvent)
-//    Et faire un bilan par événement, par exemple :
-//    nombre de hits
-//    énergie déposée
-//    statistiques par position ou particule
 
 // [ADD] Option B : méthode const pour compter les primaires (appelée depuis PrimaryGenerator)
 //      fPrimariesGenerated est 'mutable' dans RunAction.hh pour autoriser l'incrément en méthode const.
@@ -459,6 +490,97 @@ void RunAction::AddEdepFromEvent(const G4double* edepRing, G4double edepTotal)
     }
     fTotalEdepWater += edepTotal;
     fEdepWater10000 += edepTotal;
+
+    // Σx et Σx² par événement (incertitude histoire par histoire), fusionnés entre threads
+    for (G4int i = 0; i < kNbWaterRings; i++) {
+        fDoseSums[2*i]     += edepRing[i];
+        fDoseSums[2*i + 1] += edepRing[i] * edepRing[i];
+    }
+    fDoseSums[2*kNbWaterRings]     += edepTotal;
+    fDoseSums[2*kNbWaterRings + 1] += edepTotal * edepTotal;
+}
+
+void RunAction::AddTrackLengthFromEvent(const G4double* tleRing, G4double tleTotal)
+{
+    if (tleTotal <= 0.) return;   // estimateur désactivé ou aucun photon dans l'eau
+    for (G4int i = 0; i < kNbWaterRings; i++) {
+        fTleSums[2*i]     += tleRing[i];
+        fTleSums[2*i + 1] += tleRing[i] * tleRing[i];
+    }
+    fTleSums[2*kNbWaterRings]     += tleTotal;
+    fTleSums[2*kNbWaterRings + 1] += tleTotal * tleTotal;
+}
+
+//  Dose moyenne par événement et erreur relative de la moyenne R par région
+//  (ConvergenceMonitor::RelativeError, même estimateur que le critère d'arrêt)
+//  Efficacité (figure de mérite) : ε = 1 / (R² · T), T = temps réel du run (s)
+void RunAction::ReportDoseStatistics(const ArrayAccumulable<G4double>& sums, G4int estimator,
+                                     G4long nEvents, G4double time_s)
+{
+    constexpr G4double keV_to_pGy_per_gram = 0.1602;
+    const G4int ntupleId = GetDoseStatsNtupleId();
+    auto* am = G4AnalysisManager::Instance();
+
+    G4cout << "\n========== Incertitude dose (histoire par histoire) — "
+           << (estimator == 0 ? "dépôt analogique" : "kerma par longueur de trace") << " ==========\n";
+    G4cout << "Événements N = " << nEvents << ", temps réel T = " << time_s << " s\n";
+
+    for (G4int k = 0; k < kNbDoseRegions; k++) {
+        const G4double sum  = sums[2*k];
+        const G4double sum2 = sums[2*k + 1];
+        const G4double mass = (k < kNbWaterRings) ? kMassRing[k] : kMassTotalWater;
+
+        const G4double relErr = std::max(0., ConvergenceMonitor::RelativeError(sum, sum2, nEvents));
+        const G4double fom = (relErr > 0. && time_s > 0.) ? 1. / (relErr * relErr * time_s) : 0.;
+        const G4double dose_pGy = sum * keV_to_pGy_per_gram / mass;
+
+        G4cout << "  " << (k < kNbWaterRings ? "Anneau " + std::to_string(k) : std::string("Eau totale"))
+               << " : D = " << dose_pGy << " pGy ± " << 100. * relErr << " %"
+               << " , efficacité 1/(R²T) = " << fom << " s^-1\n";
+
+        if (ntupleId >= 0) {
+            am->FillNtupleIColumn(ntupleId, 0, k);
+            am->FillNtupleDColumn(ntupleId, 1, sum);
+            am->FillNtupleDColumn(ntupleId, 2, sum2);
+            am->FillNtupleDColumn(ntupleId, 3, dose_pGy);
+            am->FillNtupleDColumn(ntupleId, 4, relErr);
+            am->FillNtupleDColumn(ntupleId, 5, fom);
+            am->FillNtupleIColumn(ntupleId, 6, static_cast<G4int>(nEvents));
+            am->FillNtupleDColumn(ntupleId, 7, time_s);
+            am->FillNtupleIColumn(ntupleId, 8, estimator);
+            am->AddNtupleRow(ntupleId);
+        }
+    }
+    G4cout << "==============================================================" << G4endl;
+}
+
+//  H2 anneau × profondeur : énergie (keV) et dose (pGy), masse d'une tranche = masse de
+//  l'anneau / kNbDepthBins (couronnes homogènes en z)
+void RunAction::WriteDepthProfile() const
+{
+    constexpr G4double keV_to_pGy_per_gram = 0.1602;
+    const G4int edepId = GetDepthEdepH2Id();
+    const G4int doseId = GetDepthDoseH2Id();
+    auto* am = G4AnalysisManager::Instance();
+    const G4double binWidth_mm = 2. * fDepthHalfZ / mm / kNbDepthBins;
+
+    G4cout << "[DOSE][DEPTH] Dose par tranche de " << binWidth_mm << " mm (entrée -> sortie de l'eau) :\n";
+    for (G4int ring = 0; ring < kNbWaterRings; ring++) {
+        const G4double sliceMass = kMassRing[ring] / kNbDepthBins;
+        G4double doseIn = 0., doseOut = 0.;
+        for (G4int bin = 0; bin < kNbDepthBins; bin++) {
+            const G4double edep = fDepthEdep[static_cast<std::size_t>(ring * kNbDepthBins + bin)];
+            const G4double dose = edep * keV_to_pGy_per_gram / sliceMass;
+            const G4double depth = (bin + 0.5) * binWidth_mm;
+            if (edepId >= 0 && edep > 0.) am->FillH2(edepId, ring, depth, edep);
+            if (doseId >= 0 && dose > 0.) am->FillH2(doseId, ring, depth, dose);
+            if (bin == 0) doseIn = dose;
+            if (bin == kNbDepthBins - 1) doseOut = dose;
+        }
+        G4cout << "  Anneau " << ring << " : D(entrée) = " << doseIn << " pGy, D(sortie) = " << doseOut
+               << " pGy, rapport = " << (doseIn > 0. ? doseOut / doseIn : 0.) << "\n";
+    }
+    G4cout << G4endl;
 }
 
 G4double RunAction::GetTotalEdepRing(G4int ringIndex) const
@@ -505,7 +627,7 @@ void RunAction::CheckAndFillDoseHistograms(G4int eventID)
         
         // ===== AFFICHAGE PROGRESS TOUS LES 10000 ÉVÉNEMENTS =====
         G4cout << "[PROGRESS] Event " << eventID 
-               << " | Transmitted: " << fTransmitted10000
+               << " | Transmitted: " << fTransmitted10000 << " (Σw=" << fTransmittedWeight10000 << ")"
                << " | Edep(keV): Tot=" << fEdepWater10000
                << " R0=" << fEdepRing10000[0]
                << " R1=" << fEdepRing10000[1]
@@ -526,6 +648,7 @@ void RunAction::CheckAndFillDoseHistograms(G4int eventID)
         }
         fEdepWater10000 = 0.0;
         fTransmitted10000 = 0;
+        fTransmittedWeight10000 = 0.;
     }
 }
 
@@ -0,0 +1,113 @@
+#include "ScoringParallelWorld.hh"
+
+#include "DetectorConstruction.hh"
+#include "PlaneCrossingSD.hh"
+#include "PlanePrimaryCounterSD.hh"
+#include "SurfaceSpectrumSD.hh"
+#include "VolumeRoleRegistry.hh"
+#include "WaterRingDoseSD.hh"
+
+#include "G4Box.hh"
+#include "G4MultiSensitiveDetector.hh"
+#include "G4PVPlacement.hh"
+#include "G4SDManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Tubs.hh"
+#include "G4ios.hh"
+
+#include <string>
+
+ScoringParallelWorld::ScoringParallelWorld(const G4String& worldName, DetectorConstruction* detector)
+    : G4VUserParallelWorld(worldName), fDetector(detector)
+{}
+
+void ScoringParallelWorld::Construct()
+{
+    G4LogicalVolume* ghostWorld = GetWorld()->GetLogicalVolume();
+
+    // --- Plans de comptage fantômes (mêmes noms que les boîtes du mode "volume") ---
+    fPlanes.clear();
+    for (const auto& plane : fDetector->GetScoringPlanes()) {
+        const std::string lvName = VolumeRoleRegistry::GetScorePlaneName(plane.planeIndex);   // logicScorePlaneN
+        const std::string base   = lvName.substr(std::string("logic").size());                // ScorePlaneN
+
+        auto* solid = new G4Box("solid" + base, plane.hx, plane.hy, 0.5*(plane.zMax - plane.zMin));
+        GhostPlane ghost;
+        ghost.sdName   = plane.sdName;
+        ghost.logical  = new G4LogicalVolume(solid, nullptr, lvName);
+        ghost.physical = new G4PVPlacement(nullptr, G4ThreeVector(0., 0., 0.5*(plane.zMin + plane.zMax)),
+                                           ghost.logical, "phys" + base, ghostWorld, false, 0, true);
+        fPlanes.push_back(ghost);
+
+        G4cout << "[GEOM][PARALLEL] " << lvName << " : z ∈ [" << plane.zMin/mm << ", "
+               << plane.zMax/mm << "] mm" << G4endl;
+    }
+
+    // --- Couronnes d'eau fantômes, superposées au disque d'eau du monde de masse ---
+    G4double radialStep = 0., halfZ = 0., zCenter = 0.;
+    fDetector->GetWaterRingGeometry(radialStep, halfZ, zCenter);
+
+    fRingLVs.clear();
+    fRingPVs.clear();
+    for (G4int i = 0; i < DetectorConstruction::kNbWaterRings; ++i) {
+        const G4String idx = std::to_string(i);
+        auto* solid = new G4Tubs("solidWaterRing" + idx, i*radialStep, (i + 1)*radialStep, halfZ, 0., 360.*deg);
+        auto* lv = new G4LogicalVolume(solid, nullptr, "logicWaterRing" + idx);
+        auto* pv = new G4PVPlacement(nullptr, G4ThreeVector(0., 0., zCenter), lv,
+                                     "physWaterRing" + idx, ghostWorld, false, 0, true);
+        fRingLVs.push_back(lv);
+        fRingPVs.push_back(pv);
+    }
+    G4cout << "[GEOM][PARALLEL] " << fRingLVs.size() << " couronnes fantômes, z = "
+           << zCenter/mm << " mm" << G4endl;
+
+    // Les volumes fantômes portent les rôles plan / couronne (index utilisés par les SD)
+    VolumeRoleRegistry::Build();
+}
+
+void ScoringParallelWorld::ConstructSD()
+{
+    auto* sdManager = G4SDManager::GetSDMpointer();
+
+    // --- Plans : SD déjà créés par DetectorConstruction::ConstructSDandField(),
+    //     + compteurs ENTER/LEAVE des primaires (remplis par le SteppingAction dans les autres modes) ---
+    auto* primCounterSD = new PlanePrimaryCounterSD("PlanePrimaryCounterSD");
+    sdManager->AddNewDetector(primCounterSD);
+
+    for (const auto& ghost : fPlanes) {
+        auto* planeMultiSD = new G4MultiSensitiveDetector(ghost.sdName + "_ParallelMultiSD");
+        sdManager->AddNewDetector(planeMultiSD);
+
+        G4VSensitiveDetector* sd = sdManager->FindSensitiveDetector(ghost.sdName, /*warning=*/false);
+        if (sd) {
+            if (auto* specSD = dynamic_cast<SurfaceSpectrumSD*>(sd)) specSD->SetPlaneVolume(ghost.physical);
+            if (auto* planeSD = dynamic_cast<PlaneCrossingSD*>(sd)) planeSD->AddTargetVolume(ghost.physical);
+            planeMultiSD->AddSD(sd);
+        } else {
+            G4cout << "[SD][PARALLEL][WARN] " << ghost.sdName << " introuvable, "
+                   << ghost.logical->GetName() << " : compteurs de primaires seulement" << G4endl;
+        }
+        planeMultiSD->AddSD(primCounterSD);
+        SetSensitiveDetector(ghost.logical, planeMultiSD);
+        G4cout << "[SD][PARALLEL] " << (sd ? ghost.sdName + " + " : std::string()) << "PlanePrimaryCounterSD -> "
+               << ghost.logical->GetName() << G4endl;
+    }
+
+    // --- Couronnes : passages (ScorePlane4SD) + dépôt d'énergie (WaterRingDoseSD) ---
+    auto* doseSD = new WaterRingDoseSD("WaterRingDoseSD");
+    sdManager->AddNewDetector(doseSD);
+
+    auto* ringSD = dynamic_cast<PlaneCrossingSD*>(sdManager->FindSensitiveDetector("ScorePlane4SD", false));
+
+    auto* ringsSD = new G4MultiSensitiveDetector("WaterRingsMultiSD");
+    sdManager->AddNewDetector(ringsSD);
+    if (ringSD) ringsSD->AddSD(ringSD);
+    ringsSD->AddSD(doseSD);
+
+    for (std::size_t i = 0; i < fRingLVs.size(); ++i) {
+        if (ringSD) ringSD->AddTargetVolume(fRingPVs[i]);
+        SetSensitiveDetector(fRingLVs[i], ringsSD);
+    }
+    G4cout << "[SD][PARALLEL] " << (ringSD ? "ScorePlane4SD + " : "") << "WaterRingDoseSD -> "
+           << fRingLVs.size() << " couronnes fantômes" << G4endl;
+}
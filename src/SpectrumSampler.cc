@@ -0,0 +1,263 @@
+#include "SpectrumSampler.hh"
+
+#include "G4AutoLock.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <sstream>
+
+namespace {
+    constexpr char          kCacheMagic[8] = {'S', 'P', 'E', 'C', 'T', 'A', 'B', '1'};
+    constexpr std::uint32_t kCacheVersion  = 1;
+
+    // En-tête du cache binaire (suivi de nSegments x Segment)
+    struct CacheHeader {
+        char          magic[8];
+        std::uint32_t version;
+        std::uint32_t segmentSize;
+        std::uint64_t hash;
+        std::uint64_t nSegments;
+        G4double      mean;
+        G4double      rms;
+    };
+
+    // FNV-1a 64 bits
+    std::uint64_t Fnv1a(const void* data, std::size_t size, std::uint64_t hash = 14695981039346656037ull)
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    G4Mutex gSpectrumMutex = G4MUTEX_INITIALIZER;
+
+    // Tables partagées par clé (chemin + hash, ou clé du spectre intégré)
+    std::map<std::string, std::unique_ptr<SpectrumSampler>>& SharedTables()
+    {
+        static std::map<std::string, std::unique_ptr<SpectrumSampler>> tables;
+        return tables;
+    }
+}
+
+const SpectrumSampler* SpectrumSampler::FromTable(const G4String& key, const std::vector<G4double>& x,
+                                                  const std::vector<G4double>& y, G4double xCut)
+{
+    G4AutoLock lock(&gSpectrumMutex);
+    auto& tables = SharedTables();
+    auto it = tables.find(key);
+    if (it != tables.end()) return it->second.get();
+
+    auto sampler = std::make_unique<SpectrumSampler>();
+    if (!sampler->Build(x, y, xCut)) {
+        G4cerr << "[GEN][WARN] Spectre " << key << " vide au-dessus de la coupure" << G4endl;
+        return nullptr;
+    }
+    sampler->Print(key);
+    return tables.emplace(key, std::move(sampler)).first->second.get();
+}
+
+const SpectrumSampler* SpectrumSampler::FromFile(const G4String& path, G4double xCut)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        G4cerr << "[GEN][WARN] Fichier spectre " << path << " introuvable" << G4endl;
+        return nullptr;
+    }
+    const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    // Clé : contenu du fichier et coupure (une autre coupure donne une autre table)
+    const std::uint64_t hash = Fnv1a(&xCut, sizeof(xCut), Fnv1a(content.data(), content.size()));
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+    const std::string key = path + "#" + hex;
+
+    G4AutoLock lock(&gSpectrumMutex);
+    auto& tables = SharedTables();
+    auto it = tables.find(key);
+    if (it != tables.end()) return it->second.get();
+
+    auto sampler = std::make_unique<SpectrumSampler>();
+    const std::string cacheName = path + "." + hex + ".spt";
+    if (sampler->ReadCache(cacheName, hash)) {
+        sampler->Print(path + " (cache " + cacheName + ")");
+        return tables.emplace(key, std::move(sampler)).first->second.get();
+    }
+
+    // Texte / CSV : "E_keV intensité" par ligne, séparateurs espace , ou ; ; '#' : commentaire.
+    // Les lignes non numériques (en-têtes) sont ignorées.
+    std::vector<G4double> x, y;
+    std::istringstream lines(content);
+    std::string line;
+    while (std::getline(lines, line)) {
+        line = line.substr(0, line.find('#'));
+        for (char& c : line) if (c == ',' || c == ';' || c == '\t') c = ' ';
+        std::istringstream is(line);
+        G4double e = 0., w = 0.;
+        if (!(is >> e >> w)) continue;
+        if (!x.empty() && e * keV <= x.back()) {
+            G4cerr << "[GEN][WARN] " << path << " : énergies non croissantes (" << e << " keV), fichier rejeté" << G4endl;
+            return nullptr;
+        }
+        x.push_back(e * keV);
+        y.push_back(w);
+    }
+
+    if (!sampler->Build(x, y, xCut)) {
+        G4cerr << "[GEN][WARN] " << path << " : spectre vide au-dessus de " << xCut/keV << " keV" << G4endl;
+        return nullptr;
+    }
+    sampler->WriteCache(cacheName, hash);
+    sampler->Print(path + " (" + std::to_string(x.size()) + " points, cache " + cacheName + " écrit)");
+    return tables.emplace(key, std::move(sampler)).first->second.get();
+}
+
+G4bool SpectrumSampler::ReadCache(const std::string& fileName, std::uint64_t hash)
+{
+    std::ifstream in(fileName, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    const std::streamoff fileSize = in.tellg();
+    in.seekg(0);
+
+    CacheHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+    if (std::memcmp(header.magic, kCacheMagic, sizeof(header.magic)) != 0 || header.version != kCacheVersion ||
+        header.segmentSize != sizeof(Segment) || header.hash != hash || header.nSegments == 0) {
+        return false;
+    }
+    // Taille annoncée = taille réelle (pas d'allocation sur un nSegments corrompu)
+    if (fileSize < static_cast<std::streamoff>(sizeof(header)) ||
+        header.nSegments != static_cast<std::uint64_t>(fileSize - sizeof(header)) / sizeof(Segment) ||
+        (static_cast<std::uint64_t>(fileSize - sizeof(header)) % sizeof(Segment)) != 0) {
+        G4cerr << "[GEN][WARN] Cache " << fileName << " tronqué : table reconstruite depuis le spectre" << G4endl;
+        return false;
+    }
+
+    std::vector<Segment> segments(header.nSegments);
+    if (!in.read(reinterpret_cast<char*>(segments.data()),
+                 static_cast<std::streamsize>(segments.size() * sizeof(Segment)))) {
+        return false;
+    }
+
+    // Cache corrompu : alias hors table, seuil hors [0,1] ou segment dégénéré
+    G4bool valid = std::isfinite(header.mean) && std::isfinite(header.rms);
+    for (const Segment& s : segments) {
+        valid = valid && s.alias < header.nSegments && s.keep >= 0. && s.keep <= 1. &&
+                std::isfinite(s.x0) && s.dx > 0. && std::isfinite(s.dx) &&
+                s.upFraction >= 0. && s.upFraction <= 1.;
+    }
+    if (!valid) {
+        G4cerr << "[GEN][WARN] Cache " << fileName << " invalide : table reconstruite depuis le spectre" << G4endl;
+        return false;
+    }
+    fSegments.swap(segments);
+    fMean = header.mean;
+    fRms  = header.rms;
+    return true;
+}
+
+void SpectrumSampler::WriteCache(const std::string& fileName, std::uint64_t hash) const
+{
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        G4cerr << "[GEN][WARN] Cache " << fileName << " non écrit (table reconstruite au prochain lancement)" << G4endl;
+        return;
+    }
+
+    CacheHeader header{};
+    std::memcpy(header.magic, kCacheMagic, sizeof(header.magic));
+    header.version     = kCacheVersion;
+    header.segmentSize = sizeof(Segment);
+    header.hash        = hash;
+    header.nSegments   = fSegments.size();
+    header.mean        = fMean;
+    header.rms         = fRms;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(fSegments.data()),
+              static_cast<std::streamsize>(fSegments.size() * sizeof(Segment)));
+}
+
+void SpectrumSampler::Print(const G4String& label) const
+{
+    G4cout << "[GEN] Spectre " << label << " : " << fSegments.size() << " segments sur ["
+           << GetXmin()/keV << ", " << GetXmax()/keV << "] keV, <E> = "
+           << fMean/keV << " keV, rms = " << fRms/keV << " keV" << G4endl;
+}
+
+G4bool SpectrumSampler::Build(const std::vector<G4double>& x, const std::vector<G4double>& y, G4double xCut)
+{
+    fSegments.clear();
+    fMean = fRms = 0.;
+
+    // --- Segments au-dessus de la coupure, aires et moments exacts ---
+    const std::size_t n = std::min(x.size(), y.size());
+    std::vector<G4double> areas;
+    G4double total = 0., m1 = 0., m2 = 0.;
+
+    for (std::size_t j = 0; j + 1 < n; ++j) {
+        G4double x0 = x[j];
+        const G4double x1 = x[j + 1];
+        G4double y0 = std::max(0., y[j]);
+        const G4double y1 = std::max(0., y[j + 1]);
+        if (x1 <= x0 || x1 <= xCut) continue;
+        if (x0 < xCut) {
+            y0 += (y1 - y0) * (xCut - x0) / (x1 - x0);
+            x0 = xCut;
+        }
+
+        Segment s;
+        s.x0 = x0;
+        s.dx = x1 - x0;
+        s.upFraction = (y0 + y1 > 0.) ? y1 / (y0 + y1) : 0.5;
+        fSegments.push_back(s);
+
+        // x = x0 + t dx, densité y0 (1-t) + y1 t sur t ∈ [0,1]
+        const G4double dx = s.dx;
+        const G4double area = 0.5 * (y0 + y1) * dx;
+        areas.push_back(area);
+        total += area;
+        m1 += dx * (x0 * 0.5 * (y0 + y1) + dx * (y0 / 6. + y1 / 3.));
+        m2 += dx * (x0 * x0 * 0.5 * (y0 + y1) + 2. * x0 * dx * (y0 / 6. + y1 / 3.) + dx * dx * (y0 / 12. + y1 / 4.));
+    }
+
+    if (total <= 0.) {
+        fSegments.clear();
+        return false;
+    }
+    fMean = m1 / total;
+    fRms  = std::sqrt(std::max(0., m2 / total - fMean * fMean));
+
+    // --- Table d'alias (Vose) : probabilités des segments ramenées à 1/m chacune ---
+    const std::size_t m = fSegments.size();
+    std::vector<G4double> q(m);
+    std::vector<std::uint32_t> small, large;
+    for (std::size_t j = 0; j < m; ++j) {
+        q[j] = areas[j] * static_cast<G4double>(m) / total;
+        (q[j] < 1. ? small : large).push_back(static_cast<std::uint32_t>(j));
+    }
+    while (!small.empty() && !large.empty()) {
+        const std::uint32_t l = small.back(); small.pop_back();
+        const std::uint32_t g = large.back(); large.pop_back();
+        fSegments[l].keep  = q[l];
+        fSegments[l].alias = g;
+        q[g] = (q[g] + q[l]) - 1.;
+        (q[g] < 1. ? small : large).push_back(g);
+    }
+    // Reliquats (arrondis) : probabilité 1/m exactement
+    for (const auto& rest : {small, large}) {
+        for (const std::uint32_t j : rest) {
+            fSegments[j].keep  = 1.;
+            fSegments[j].alias = j;
+        }
+    }
+    return true;
+}
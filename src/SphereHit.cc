@@ -8,28 +8,49 @@
 
 #include "G4UnitsTable.hh"
 #include "G4ios.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+
+#include "ProcessIdTable.hh"
 
 G4ThreadLocal G4Allocator<SphereHit>* SphereHitAllocator=nullptr;
 
 SphereHit::SphereHit()
-: G4VHit(),fPosition(G4ThreeVector()),fEnergy(0.),fEdep(0.),fTime(0.),fParticleName(""),fVolumeName(""),fTrackID(-1) {}
+: G4VHit(), fData() {
+    fData.eventID        = -1;
+    fData.trackID        = -1;
+    fData.volumeId       = -1;
+    fData.processId      = ProcessIdTable::kUnknownId;
+    fData.processType    = -1;
+    fData.processSubType = -1;
+}
 
 SphereHit::~SphereHit() {}
 
-SphereHit::SphereHit(const SphereHit& right): G4VHit(right),fEdep(right.fEdep),fPosition(right.fPosition),fTime(right.fTime), fParticleName(right.fParticleName),fVolumeName(right.fVolumeName),fTrackID(right.fTrackID) {}
+SphereHit::SphereHit(const SphereHit& right): G4VHit(right), fData(right.fData) {}
 
 const SphereHit& SphereHit::operator=(const SphereHit& right) {
-    fPosition = right.fPosition;
-    fEnergy = right.fEnergy;
-    fEdep = right.fEdep;
-    fTime = right.fTime;
-    fParticleName = right.fParticleName;
-    fVolumeName = right.fVolumeName;
-    fTrackID = right.fTrackID;
-
+    fData = right.fData;
     return *this;
 }
 
+void SphereHit::SetVolume(const G4VPhysicalVolume* pv) {
+    const G4LogicalVolume* lv = pv ? pv->GetLogicalVolume() : nullptr;
+    fData.volumeId = lv ? static_cast<std::int16_t>(lv->GetInstanceID()) : std::int16_t(-1);
+}
+
+G4String SphereHit::GetVolumeName() const {
+    for (const auto* lv : *G4LogicalVolumeStore::GetInstance()) {
+        if (lv && lv->GetInstanceID() == fData.volumeId) return lv->GetName();
+    }
+    return G4String("unknown");
+}
+
+const G4String& SphereHit::GetProcessName() const {
+    return ProcessIdTable::GetName(fData.processId);
+}
+
 G4bool SphereHit::operator==(const SphereHit& right) const {
     return (this == &right);
 }
@@ -39,7 +60,7 @@ void SphereHit::Draw() {
     // visualiser le hit
     G4VVisManager* vis = G4VVisManager::GetConcreteInstance();
     if(vis) {
-        G4Circle circle(fPosition);
+        G4Circle circle(GetPosition());
         circle.SetScreenSize(0.05);
         circle.SetFillStyle(G4Circle::filled);
         circle.SetVisAttributes(G4VisAttributes(G4Colour(1,0,0))); //rouge
@@ -48,10 +69,11 @@ void SphereHit::Draw() {
 }
 
 void SphereHit::Print() {
-    G4cout << "EventID = " << fEventID
-    << ", Hit: position = " << G4BestUnit(fPosition, "Length")
-    << ", énergie déposée = " << G4BestUnit(fEdep, "Energy")
-    << ", time = " << fTime/CLHEP::ns
-    << ", ns, particle = " << fParticleName
-    << ", volume = " << fVolumeName<<G4endl;
+    G4cout << "EventID = " << fData.eventID
+    << ", Hit: position = " << G4BestUnit(GetPosition(), "Length")
+    << ", énergie déposée = " << G4BestUnit(GetEdep(), "Energy")
+    << ", time = " << fData.time_ns
+    << ", ns, pdg = " << fData.pdg
+    << ", process = " << GetProcessName()
+    << ", volume = " << GetVolumeName()<<G4endl;
 }
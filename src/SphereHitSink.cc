@@ -0,0 +1,132 @@
+#include "SphereHitSink.hh"
+#include "SphereHit.hh"
+
+#include "G4HCofThisEvent.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4SDManager.hh"
+#include "G4Threading.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    G4ThreadLocal SphereHitSink* gSink = nullptr;
+}
+
+SphereHitSink* SphereHitSink::Instance()
+{
+    if (!gSink) gSink = new SphereHitSink();
+    return gSink;
+}
+
+void SphereHitSink::Destroy()
+{
+    delete gSink;
+    gSink = nullptr;
+}
+
+SphereHitSink::SphereHitSink()
+{
+    fBuffer.resize(kBufferSize);
+}
+
+SphereHitSink::~SphereHitSink()
+{
+    EndRun();
+}
+
+void SphereHitSink::BeginRun(G4int runID, G4int verbose)
+{
+    fRunID = runID;
+    fVerbose = verbose;
+    fCount = 0;
+    fHCID = -2;
+    fEventsWithHits = 0;
+    fHitsWritten = 0;
+    if (fFile.is_open()) fFile.close();
+    fFileName.clear();
+}
+
+void SphereHitSink::Consume(G4int eventID, G4HCofThisEvent* hce)
+{
+    if (!hce) return;
+
+    // Résolution une fois par run ; sans SphereSD, coût réduit à ce test
+    if (fHCID == -2) fHCID = G4SDManager::GetSDMpointer()->GetCollectionID("SphereSD/SphereHitsCollection");
+    if (fHCID < 0) return;
+
+    const auto* hits = static_cast<const SphereHitsCollection*>(hce->GetHC(fHCID));
+    if (!hits || hits->entries() == 0) return;
+
+    G4double totalEdep = 0.;
+    for (std::size_t i = 0; i < hits->entries(); ++i) {
+        const SphereHit* hit = (*hits)[i];
+        if (fCount == fBuffer.size()) Flush();
+        fBuffer[fCount++] = hit->GetRecord();
+        totalEdep += hit->GetEdep();
+    }
+    ++fEventsWithHits;
+
+    if (fVerbose == 1) {
+        G4cout << "→ Event #" << eventID
+               << " : " << hits->entries() << " hits, "
+               << "E_dep total = " << totalEdep / keV << " keV" << G4endl;
+    }
+}
+
+// En-tête + dictionnaire des volumes (InstanceID -> nom), écrits une fois par fichier
+void SphereHitSink::OpenFile()
+{
+    const G4int tid = G4Threading::G4GetThreadId();
+    fFileName = "spherehits_run" + std::to_string(fRunID) + "_"
+              + (tid < 0 ? std::string("seq") : "t" + std::to_string(tid)) + ".bin";
+
+    fFile.open(fFileName, std::ios::binary | std::ios::trunc);
+    if (!fFile) {
+        G4cerr << "[HITS][ERROR] Impossible d'ouvrir " << fFileName << G4endl;
+        return;
+    }
+
+    const auto* lvStore = G4LogicalVolumeStore::GetInstance();
+
+    SphereHitIO::FileHeader header;
+    std::memcpy(header.magic, SphereHitIO::kMagic, sizeof(header.magic));
+    header.version    = SphereHitIO::kVersion;
+    header.recordSize = sizeof(SphereHitIO::Record);
+    header.nVolumes   = static_cast<std::uint32_t>(lvStore->size());
+    header.threadId   = tid;
+    fFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const auto* lv : *lvStore) {
+        const std::uint32_t id = static_cast<std::uint32_t>(lv->GetInstanceID());
+        const std::string& name = lv->GetName();
+        const std::uint16_t len = static_cast<std::uint16_t>(std::min<std::size_t>(name.size(), 0xFFFF));
+        fFile.write(reinterpret_cast<const char*>(&id), sizeof(id));
+        fFile.write(reinterpret_cast<const char*>(&len), sizeof(len));
+        fFile.write(name.data(), len);
+    }
+}
+
+void SphereHitSink::Flush()
+{
+    if (fCount == 0) return;
+    if (!fFile.is_open()) OpenFile();
+    if (fFile) {
+        fFile.write(reinterpret_cast<const char*>(fBuffer.data()),
+                    static_cast<std::streamsize>(fCount * sizeof(SphereHitIO::Record)));
+        fHitsWritten += static_cast<G4long>(fCount);
+    }
+    fCount = 0;
+}
+
+void SphereHitSink::EndRun()
+{
+    Flush();
+    if (!fFile.is_open()) return;
+
+    fFile.close();
+    G4cout << "[HITS] " << fEventsWithHits << " événements avec hits, "
+           << fHitsWritten << " hits écrits dans " << fFileName << G4endl;
+}
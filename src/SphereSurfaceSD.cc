@@ -11,11 +11,15 @@
 #include "G4HCofThisEvent.hh"
 
 #include "G4TouchableHistory.hh"
+#include "G4VPhysicalVolume.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4AnalysisManager.hh"
 #include "G4LogicalVolumeStore.hh"
 
 #include "G4ios.hh"
+#include "SimTrace.hh"
+#include "ProcessIdTable.hh"
+#include "VolumeRoleRegistry.hh"
 
 // Définit un détecteur sensible (Sensitive Detector, SD)
 // attaché à la surface de la sphère d’eau (logicsphereWater).
@@ -141,11 +145,14 @@ G4bool SphereSurfaceSD::ProcessHits(G4Step* step, G4TouchableHistory*) {
     //  Donc logicalPre et logicalPost sont les volumes logiques traversés pendant ce step.
     //
 
-    auto logicalPre   = pre->GetTouchableHandle()->GetVolume()->GetLogicalVolume();
-    auto logicalPost  = post->GetTouchableHandle()->GetVolume()->GetLogicalVolume();
+    const auto* pvPre   = pre->GetPhysicalVolume();
+    const auto* pvPost  = post->GetPhysicalVolume();
+    const auto* logicalPre  = pvPre  ? pvPre->GetLogicalVolume()  : nullptr;
+    const auto* logicalPost = pvPost ? pvPost->GetLogicalVolume() : nullptr;
 
-    G4String namePre  = logicalPre->GetName();
-    G4String namePost = logicalPost->GetName();
+    // Rôles via le registre (pas de copie de nom par step)
+    const bool preInSphere  = VolumeRoleRegistry::Lookup(logicalPre).Has(VolumeRole::kWaterSphere);
+    const bool postInSphere = VolumeRoleRegistry::Lookup(logicalPost).Has(VolumeRole::kWaterSphere);
 
     G4double energy = pre->GetKineticEnergy();
     auto analysisManager = G4AnalysisManager::Instance();
@@ -153,38 +160,27 @@ G4bool SphereSurfaceSD::ProcessHits(G4Step* step, G4TouchableHistory*) {
         G4cerr << "[ERREUR] analysisManager est NULL !" << G4endl;
         return true;
     }
-    if (fSDVerboseLevel == 1) {}
+    if (SIM_TRACE(fSDVerboseLevel, 1)) {}
     // Détection d’une sortie de la sphère (entrée non détectée ici)
     // Si une particule sort de logicsphereWater,
     // On enregistre son énergie dans un histogramme (ID 1).
 
-    if (namePre == "logicsphereWater" && namePost != "logicsphereWater") {
-        if (fSDVerboseLevel == 1) {
+    if (preInSphere && !postInSphere) {
+        if (SIM_TRACE(fSDVerboseLevel, 1)) {
             G4cout << "[DEBUG ProcessHits] ← Sortie de la sphère à E = "<<energy/MeV<<" MeV"<< G4endl;}
         // [SUPPRIMÉ] analysisManager->FillH1(1, energy);
     }
 
     auto edep = step->GetTotalEnergyDeposit();
-    if (fSDVerboseLevel == 1) {
+    if (SIM_TRACE(fSDVerboseLevel, 1)) {
         G4cout <<"[DEBUG ProcessHits][ProcessHits] ← Energie deposee dans la sphère= "<<edep/MeV<<" MeV"<<G4endl;}
 
-    //pname contient le nom de la particule en cours de step
-    //  step->GetTrack() : récupère le G4Track (la particule actuelle)
-    //  ->GetParticleDefinition() : accède à la définition (G4ParticleDefinition)
-    //  ->GetParticleName() : renvoie le nom en clair (ex: "gamma", "e-", "proton")
-    G4String pname = step->GetTrack()->GetParticleDefinition()->GetParticleName();
-
     // time donne le moment où la particule est à la position pre
     // GetGlobalTime() retourne le temps écoulé depuis le début du run
     //      Unité : temps absolu (typiquement en nanosecondes)
     //      Utile pour mesurer des délais, des trajectoires dans le temps
     G4double time = pre->GetGlobalTime();
 
-    //  vname contient le nom du volume physique traversé, par exemple "spherePV".
-    //  pre->GetPhysicalVolume() retourne le volume physique (G4VPhysicalVolume) dans lequel se trouve pre
-    //  ->GetName() donne son nom (défini via SetName() dans DetectorConstruction)
-    G4String vname = pre->GetPhysicalVolume()->GetName();
-
     // posDetector est la position du centre du volume sensible dans le repère de son parent.
     //  physVol->GetTranslation() retourne le vecteur de translation du volume dans son parent (
     //  typiquement la position du détecteur dans le monde).
@@ -202,9 +198,8 @@ G4bool SphereSurfaceSD::ProcessHits(G4Step* step, G4TouchableHistory*) {
     hit->SetEdep(step->GetTotalEnergyDeposit());
     hit->SetEnergy(step->GetPostStepPoint()->GetKineticEnergy());
     hit->SetTrackID(step->GetTrack()->GetTrackID());
-    hit->SetParticleName(pname);
     hit->SetTime(time);
-    hit->SetVolumeName(vname);
+    hit->SetVolume(pre->GetPhysicalVolume());   // nom résolu seulement à l'affichage
 
 
     // Particle PDG code and process info for this step ---
@@ -215,17 +210,17 @@ G4bool SphereSurfaceSD::ProcessHits(G4Step* step, G4TouchableHistory*) {
     if (step->GetPostStepPoint()) proc = step->GetPostStepPoint()->GetProcessDefinedStep();
     if (!proc && step->GetPreStepPoint()) proc = step->GetPreStepPoint()->GetProcessDefinedStep();
     if (proc) {
-        hit->SetProcessName(proc->GetProcessName());
+        hit->SetProcessId(ProcessIdTable::GetId(proc));
         hit->SetProcessType(static_cast<G4int>(proc->GetProcessType()));
         hit->SetProcessSubType(proc->GetProcessSubType());
     } else {
-        hit->SetProcessName("Unknown");
+        hit->SetProcessId(ProcessIdTable::kUnknownId);
         hit->SetProcessType(-1);
         hit->SetProcessSubType(-1);
     }
 
     G4int evt = G4RunManager::GetRunManager()->GetCurrentEvent()->GetEventID();
-   if (fSDVerboseLevel == 1) {
+   if (SIM_TRACE(fSDVerboseLevel, 1)) {
        G4cout << "\n[DEBUG ProcessHits] "<<evt<<G4endl;
         G4cout << "\n[DEBUG ProcessHits] Hits position"<<step->GetPreStepPoint()->GetPosition()<<G4endl;
         G4cout << "\n[DEBUG ProcessHits] edep"<< edep<<G4endl;
@@ -236,7 +231,7 @@ G4bool SphereSurfaceSD::ProcessHits(G4Step* step, G4TouchableHistory*) {
     // qui sera enregistrée dans EventAction.
     fHitsCollection->insert(hit);
 
-    if (fSDVerboseLevel == 1) {
+    if (SIM_TRACE(fSDVerboseLevel, 1)) {
         G4cout << "[DEBUG ProcessHits] Fin OK" << G4endl;}
     return true;
 }
@@ -250,7 +245,7 @@ void SphereSurfaceSD::EndOfEvent(G4HCofThisEvent*) {
     // .entries() renvoie le nombre de SphereHit enregistrés pendant cet événement.
     // Nombre de hits enregistrés
     G4int Nentries = fHitsCollection->entries();
-    if (fSDVerboseLevel == 1) {
+    if (SIM_TRACE(fSDVerboseLevel, 1)) {
         G4cout << "[DEBUG End Of Event] Nentries = "<<Nentries<< G4endl;}
 
     //  Boucle sur tous les hits
@@ -258,7 +253,7 @@ void SphereSurfaceSD::EndOfEvent(G4HCofThisEvent*) {
         // parcourt chaque SphereHit enregistré dans cet événement.
         // i est simplement l’index dans le tableau.
 
-        if (fSDVerboseLevel == 1) {
+        if (SIM_TRACE(fSDVerboseLevel, 1)) {
             G4cout << "[DEBUG End Of Event] i = "<<i<< G4endl;
             // Affichage du hit
         //  appelle la méthode Print() sur le hit correspondant
@@ -0,0 +1,161 @@
+#include "StepTraceRecorder.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4StepPoint.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    inline std::int16_t VolumeId(const G4StepPoint* point)
+    {
+        const G4VPhysicalVolume* pv = point ? point->GetPhysicalVolume() : nullptr;
+        const G4LogicalVolume* lv = pv ? pv->GetLogicalVolume() : nullptr;
+        return lv ? static_cast<std::int16_t>(lv->GetInstanceID()) : std::int16_t(-1);
+    }
+
+    inline void StorePosition(float* dst, const G4ThreeVector& pos)
+    {
+        dst[0] = static_cast<float>(pos.x()/mm);
+        dst[1] = static_cast<float>(pos.y()/mm);
+        dst[2] = static_cast<float>(pos.z()/mm);
+    }
+
+    G4ThreadLocal StepTraceRecorder* gRecorder = nullptr;
+}
+
+StepTraceRecorder* StepTraceRecorder::Instance()
+{
+    if (!gRecorder) gRecorder = new StepTraceRecorder();
+    return gRecorder;
+}
+
+void StepTraceRecorder::Destroy()
+{
+    delete gRecorder;
+    gRecorder = nullptr;
+}
+
+StepTraceRecorder::StepTraceRecorder()
+{
+    fBuffer.resize(kBufferSize);
+}
+
+StepTraceRecorder::~StepTraceRecorder()
+{
+    EndRun();
+}
+
+void StepTraceRecorder::AddTracedEventID(G4int eventID)
+{
+    auto it = std::lower_bound(fExplicitEventIDs.begin(), fExplicitEventIDs.end(), eventID);
+    if (it == fExplicitEventIDs.end() || *it != eventID) fExplicitEventIDs.insert(it, eventID);
+}
+
+void StepTraceRecorder::BeginRun(G4int runID)
+{
+    fRunID = runID;
+    fCount = 0;
+    fArmed = false;
+    fCurrentEventID = -1;
+    fTracedEvents = 0;
+    fRecordsWritten = 0;
+    if (fFile.is_open()) fFile.close();
+    fFileName.clear();
+}
+
+// Appelé une fois par événement : c'est ici (et non dans le hot path) que se fait la sélection
+void StepTraceRecorder::ArmForEvent(G4int eventID)
+{
+    fCurrentEventID = eventID;
+    fArmed = (eventID < fMaxTracedEvents) ||
+             std::binary_search(fExplicitEventIDs.begin(), fExplicitEventIDs.end(), eventID);
+    if (fArmed) ++fTracedEvents;
+}
+
+void StepTraceRecorder::Record(const G4Step* step)
+{
+    const G4Track* track = step->GetTrack();
+    const G4StepPoint* pre  = step->GetPreStepPoint();
+    const G4StepPoint* post = step->GetPostStepPoint();
+    if (!track || !pre || !post) return;
+
+    if (fCount == fBuffer.size()) Flush();
+
+    StepTrace::Record& r = fBuffer[fCount++];
+    r.eventID    = fCurrentEventID;
+    r.trackID    = track->GetTrackID();
+    r.parentID   = track->GetParentID();
+    r.stepNumber = track->GetCurrentStepNumber();
+    r.pdg        = track->GetDefinition() ? track->GetDefinition()->GetPDGEncoding() : 0;
+    r.ekin_keV   = static_cast<float>(pre->GetKineticEnergy()/keV);
+    r.preVolume  = VolumeId(pre);
+    r.postVolume = VolumeId(post);
+    StorePosition(r.prePos,  pre->GetPosition());
+    StorePosition(r.postPos, post->GetPosition());
+}
+
+// En-tête + dictionnaire des volumes (InstanceID -> nom), écrits une fois par fichier
+void StepTraceRecorder::OpenFile()
+{
+    const G4int tid = G4Threading::G4GetThreadId();
+    fFileName = "steptrace_run" + std::to_string(fRunID) + "_"
+              + (tid < 0 ? std::string("seq") : "t" + std::to_string(tid)) + ".bin";
+
+    fFile.open(fFileName, std::ios::binary | std::ios::trunc);
+    if (!fFile) {
+        G4cerr << "[STEPTRACE][ERROR] Impossible d'ouvrir " << fFileName << G4endl;
+        return;
+    }
+
+    const auto* lvStore = G4LogicalVolumeStore::GetInstance();
+
+    StepTrace::FileHeader header;
+    std::memcpy(header.magic, StepTrace::kMagic, sizeof(header.magic));
+    header.version    = StepTrace::kVersion;
+    header.recordSize = sizeof(StepTrace::Record);
+    header.nVolumes   = static_cast<std::uint32_t>(lvStore->size());
+    header.threadId   = tid;
+    fFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const auto* lv : *lvStore) {
+        const std::uint32_t id = static_cast<std::uint32_t>(lv->GetInstanceID());
+        const std::string& name = lv->GetName();
+        const std::uint16_t len = static_cast<std::uint16_t>(std::min<std::size_t>(name.size(), 0xFFFF));
+        fFile.write(reinterpret_cast<const char*>(&id), sizeof(id));
+        fFile.write(reinterpret_cast<const char*>(&len), sizeof(len));
+        fFile.write(name.data(), len);
+    }
+}
+
+void StepTraceRecorder::Flush()
+{
+    if (fCount == 0) return;
+    if (!fFile.is_open()) OpenFile();
+    if (fFile) {
+        fFile.write(reinterpret_cast<const char*>(fBuffer.data()),
+                    static_cast<std::streamsize>(fCount * sizeof(StepTrace::Record)));
+        fRecordsWritten += static_cast<G4long>(fCount);
+    }
+    fCount = 0;
+}
+
+void StepTraceRecorder::EndRun()
+{
+    Flush();
+    fArmed = false;
+    if (!fFile.is_open()) return;
+
+    fFile.close();
+    G4cout << "[STEPTRACE] " << fTracedEvents << " événements suivis, "
+           << fRecordsWritten << " steps écrits dans " << fFileName
+           << " (décodage : steptrace_decode " << fFileName << ")" << G4endl;
+}
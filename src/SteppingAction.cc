@@ -14,52 +14,31 @@
 #include "G4AnalysisManager.hh"
 #include "G4TrackStatus.hh"
 #include "G4VProcess.hh"
+#include "G4EmProcessSubType.hh"
 #include "G4Material.hh"
+#include "G4Gamma.hh"
 
 #include "MyTrackInfo.hh"
 #include "G4Threading.hh"
 #include "RunAction.hh"
 #include "SteppingMessenger.hh"
+#include "VolumeRoleRegistry.hh"
+#include "MuEnTable.hh"
+#include "SimTrace.hh"
 
 #include <cfloat>
 #include <algorithm>
 #include <cmath>
-#include <map>
-#include <set>
-#include <iomanip>
-
-// ============================================================================
-// [B] Compteurs globaux visibles depuis RunAction (pour le bilan de fin de run)
-//    -> Dans RunAction::EndOfRunAction, déclare :
-//       extern G4long gEnterPlanePrim, gLeavePlanePrim;
-//       G4cout << "[STEP][SUMMARY] enter_plane_prim=" << gEnterPlanePrim
-//              << " leave_plane_prim=" << gLeavePlanePrim << G4endl;
-// ============================================================================
-G4long gEnterPlanePrim = 0;
-G4long gLeavePlanePrim = 0;
-
-
-// [LOSS] Comptage de primaires perdus avant z=60 mm (par processus et matériau)
-std::map<std::string,int> gLostByProc;
-std::map<std::string,int> gLostByMat;
-
-
-// Sécurisation MT (optionnelle mais recommandée)
-#ifdef G4MULTITHREADED
-#include "G4AutoLock.hh"
-namespace { G4Mutex gPlanePrimMutex = G4MUTEX_INITIALIZER; }
-namespace { G4Mutex gLossMapMutex   = G4MUTEX_INITIALIZER; }
-namespace { G4Mutex gStepTrackingMutex = G4MUTEX_INITIALIZER; }
-#endif
-
-// ==================== Step Tracking - Membres statiques ====================
-G4int SteppingAction::fTrackedEventsCount = 0;
-G4int SteppingAction::fMaxTrackedEvents = 10;
-std::set<G4int> SteppingAction::fTrackedEventIDs;
-std::set<G4int> SteppingAction::fTrackedTrackIDs;
-G4int SteppingAction::fCurrentEventID = -1;
-
 
+namespace {
+    // Processus physique réel : ni transport ni diffusion multiple (comparaison d'entiers,
+    // pas de nom de processus à chaque step)
+    inline G4bool IsPhysicalInteraction(const G4VProcess* process)
+    {
+        return process && process->GetProcessType() != fTransportation
+                       && process->GetProcessSubType() != fMultipleScattering;
+    }
+}
 
 //  Constructeur => hérites de G4UserSteppingAction.
 //  crée un objet de la classe SteppingAction, en enregistrant un pointeur vers une instance de EventAction.
@@ -70,12 +49,19 @@ G4int SteppingAction::fCurrentEventID = -1;
 //      - Il prend un pointeur vers un EventAction comme argument.
 //      - et fourni ce pointeur dans ActionInitialization :
 //  Inclusion d'une commande par messenger pour ajuster le niveau de verbose
-//  La variable est fVerboseLevel initiliser à 1
+//  La variable est fSteppingVerboseLevel initialisée à 0 (traces via /stepping/verbose)
 SteppingAction::SteppingAction(EventAction* eventAction)
 : G4UserSteppingAction(), fEventAction(eventAction)
 {
     fSteppingMessenger = new SteppingMessenger(this);
-    fSteppingVerboseLevel = 1;
+    fSteppingVerboseLevel = 0;
+    fTraceRecorder = StepTraceRecorder::Instance();
+    fPhaseSpace = PhaseSpaceWriter::Instance();
+
+    // [LOSS] Table de pertes du thread (RunAction déjà associé dans ActionInitialization::Build)
+    fRunAction = fEventAction ? fEventAction->GetRunAction() : nullptr;
+    fLossTable = fRunAction ? fRunAction->GetLossTable() : nullptr;
+    fDoseMesh  = fRunAction ? fRunAction->GetDoseMesh() : nullptr;
 }
 //  G4UserSteppingAction() appelles ile constructeur de la classe de base : G4UserSteppingAction.
 //  Cela est obligatoire car SteppingAction hérite de G4UserSteppingAction.
@@ -97,175 +83,6 @@ SteppingAction::~SteppingAction()
     delete fSteppingMessenger;
 }
 
-// ==================== Step Tracking - Méthodes statiques ====================
-
-void SteppingAction::ResetTrackedParticlesCount()
-{
-    #ifdef G4MULTITHREADED
-    G4AutoLock lock(&gStepTrackingMutex);
-    #endif
-    fTrackedEventsCount = 0;
-    fTrackedEventIDs.clear();
-    fTrackedTrackIDs.clear();
-    fCurrentEventID = -1;
-    
-    G4cout << "\n"
-           << "========================================================================================================\n"
-           << "                         SUIVI STEP PAR STEP DES " << fMaxTrackedEvents << " PREMIERS EVENEMENTS\n"
-           << "========================================================================================================\n"
-           << std::setw(4)  << "Evt"
-           << std::setw(5)  << "Trk"
-           << std::setw(4)  << "Stp"
-           << std::setw(8)  << "Part"
-           << std::setw(4)  << "Sec"
-           << std::setw(10) << "Ekin(keV)"
-           << "  " << std::left << std::setw(22) << "PreVolume" << std::right
-           << std::setw(26) << "PrePos(mm)"
-           << "  " << std::left << std::setw(22) << "PostVolume" << std::right
-           << std::setw(26) << "PostPos(mm)"
-           << G4endl;
-    G4cout << std::string(138, '-') << G4endl;
-}
-
-G4int SteppingAction::GetTrackedParticlesCount()
-{
-    return fTrackedEventsCount;
-}
-
-void SteppingAction::SetMaxTrackedParticles(G4int n)
-{
-    fMaxTrackedEvents = n;
-}
-
-G4int SteppingAction::GetMaxTrackedParticles()
-{
-    return fMaxTrackedEvents;
-}
-
-G4bool SteppingAction::ShouldTrackParticle(const G4Track* track, G4int eventID)
-{
-    if (!track) return false;
-    
-    G4int trackID = track->GetTrackID();
-    G4int parentID = track->GetParentID();
-    
-    // Nouvel événement ?
-    if (eventID != fCurrentEventID) {
-        #ifdef G4MULTITHREADED
-        G4AutoLock lock(&gStepTrackingMutex);
-        #endif
-        
-        // Vérifier si on a déjà atteint le max d'événements
-        if (fTrackedEventsCount >= fMaxTrackedEvents) {
-            return false;
-        }
-        
-        // Vérifier si cet événement est déjà suivi
-        if (fTrackedEventIDs.find(eventID) == fTrackedEventIDs.end()) {
-            // Nouvel événement à suivre
-            fTrackedEventIDs.insert(eventID);
-            fTrackedEventsCount++;
-            fTrackedTrackIDs.clear();  // Reset les trackID pour ce nouvel événement
-            fCurrentEventID = eventID;
-            
-            G4cout << "\n>>> Evenement #" << eventID 
-                   << " (total suivi: " << fTrackedEventsCount << "/" << fMaxTrackedEvents << ") <<<\n" << G4endl;
-        } else {
-            fCurrentEventID = eventID;
-        }
-    }
-    
-    // Vérifier si cet événement est dans la liste des événements suivis
-    if (fTrackedEventIDs.find(eventID) == fTrackedEventIDs.end()) {
-        return false;
-    }
-    
-    // Si c'est une particule primaire (parentID == 0)
-    if (parentID == 0) {
-        if (fTrackedTrackIDs.find(trackID) == fTrackedTrackIDs.end()) {
-            #ifdef G4MULTITHREADED
-            G4AutoLock lock(&gStepTrackingMutex);
-            #endif
-            fTrackedTrackIDs.insert(trackID);
-        }
-        return true;
-    }
-    
-    // Si c'est une secondaire, suivre si parent est suivi
-    if (fTrackedTrackIDs.find(parentID) != fTrackedTrackIDs.end()) {
-        if (fTrackedTrackIDs.find(trackID) == fTrackedTrackIDs.end()) {
-            #ifdef G4MULTITHREADED
-            G4AutoLock lock(&gStepTrackingMutex);
-            #endif
-            fTrackedTrackIDs.insert(trackID);
-        }
-        return true;
-    }
-    
-    return false;
-}
-
-void SteppingAction::PrintStepInfo(const G4Step* step, G4int eventID)
-{
-    const G4Track* track = step->GetTrack();
-    const G4StepPoint* prePoint = step->GetPreStepPoint();
-    const G4StepPoint* postPoint = step->GetPostStepPoint();
-    
-    if (!track || !prePoint || !postPoint) return;
-    
-    G4int trackID = track->GetTrackID();
-    G4int parentID = track->GetParentID();
-    G4int stepNumber = track->GetCurrentStepNumber();
-    G4String particleName = track->GetDefinition()->GetParticleName();
-    G4int isSecondary = (parentID == 0) ? 0 : 1;
-    G4double ekin = prePoint->GetKineticEnergy() / CLHEP::keV;
-    
-    G4String preVolumeName = "OutOfWorld";
-    G4String postVolumeName = "OutOfWorld";
-    
-    if (prePoint->GetTouchableHandle()->GetVolume()) {
-        preVolumeName = prePoint->GetTouchableHandle()->GetVolume()->GetName();
-    }
-    if (postPoint->GetTouchableHandle()->GetVolume()) {
-        postVolumeName = postPoint->GetTouchableHandle()->GetVolume()->GetName();
-    }
-    
-    // Tronquer les noms de volumes longs (max 20 caractères)
-    const size_t maxVolNameLen = 20;
-    if (preVolumeName.length() > maxVolNameLen) {
-        preVolumeName = preVolumeName.substr(0, maxVolNameLen-2) + "..";
-    }
-    if (postVolumeName.length() > maxVolNameLen) {
-        postVolumeName = postVolumeName.substr(0, maxVolNameLen-2) + "..";
-    }
-    
-    // Tronquer le nom de particule si nécessaire
-    if (particleName.length() > 6) {
-        particleName = particleName.substr(0, 6);
-    }
-    
-    G4ThreeVector prePos = prePoint->GetPosition();
-    G4ThreeVector postPos = postPoint->GetPosition();
-    
-    std::ostringstream prePosStr, postPosStr;
-    prePosStr << std::fixed << std::setprecision(2) 
-              << "(" << prePos.x()/mm << "," << prePos.y()/mm << "," << prePos.z()/mm << ")";
-    postPosStr << std::fixed << std::setprecision(2) 
-               << "(" << postPos.x()/mm << "," << postPos.y()/mm << "," << postPos.z()/mm << ")";
-    
-    G4cout << std::setw(4)  << eventID
-           << std::setw(5)  << trackID
-           << std::setw(4)  << stepNumber
-           << std::setw(8)  << particleName
-           << std::setw(4)  << isSecondary
-           << std::setw(10) << std::fixed << std::setprecision(3) << ekin
-           << "  " << std::left << std::setw(20) << preVolumeName << std::right
-           << std::setw(26) << prePosStr.str()
-           << "  " << std::left << std::setw(20) << postVolumeName << std::right
-           << std::setw(26) << postPosStr.str()
-           << G4endl;
-}
-
 //  Cette fonction UserSteppingAction(const G4Step* step) est appelée à chaque
 //  step de chaque particule.
 void SteppingAction::UserSteppingAction(const G4Step *step)
@@ -277,32 +94,34 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
 
     auto track     = step->GetTrack();
 
-    // ==================== Step Tracking des 10 premiers événements ====================
-    if (track && ShouldTrackParticle(track, eventID)) {
-        PrintStepInfo(step, eventID);
+    // ==================== Step Tracking des événements sélectionnés ====================
+    // Un seul test prédictible hors des événements armés (cf. StepTraceRecorder)
+    if (fTraceRecorder->IsArmed()) {
+        fTraceRecorder->Record(step);
     }
     // ==================== Fin Step Tracking ====================
 
-    // Ajout du 15/07
-    MyTrackInfo* trackInfo = static_cast<MyTrackInfo*>(track->GetUserInformation());
-    if (!trackInfo) {
-        if (fSteppingVerboseLevel == 1) {
-            G4cout << "[DEBUG SteppingAction] MyTrackInfo est nul → création..." << G4endl;
-        }
-        trackInfo = new MyTrackInfo();
-        track->SetUserInformation(trackInfo);
-
-        const G4VProcess* creator = track->GetCreatorProcess();
-        G4String pname = (creator ? creator->GetProcessName() : "primary");
-        if (fSteppingVerboseLevel == 1) {
-            G4cout << "[DEBUG SteppingAction] Processus créateur = " << pname << G4endl;
+    // ==================== Espace des phases (étape 1) ====================
+    // Passage du plan vers +z enregistré ; avec kill, la particule et les secondaires créés
+    // au-delà du plan dans ce step s'arrêtent là (l'étape 2 les simule à partir du fichier)
+    if (fPhaseSpace->IsEnabled() && fPhaseSpace->Record(step) && fPhaseSpace->KillAtPlane()) {
+        track->SetTrackStatus(fStopAndKill);
+        if (const auto* secondaries = step->GetSecondaryInCurrentStep()) {
+            for (const G4Track* secondary : *secondaries) {
+                if (secondary->GetPosition().z() >= fPhaseSpace->GetPlaneZ())
+                    const_cast<G4Track*>(secondary)->SetTrackStatus(fStopAndKill);
+            }
         }
-
-        trackInfo->SetCreatorProcess(pname);
+        return;
     }
 
+    // MyTrackInfo attaché dans TrackingAction::PreUserTrackingAction (pool thread-local) ;
+    // Attach() ne sert ici que de filet de sécurité si aucun TrackingAction n'est enregistré
+    MyTrackInfo* trackInfo = static_cast<MyTrackInfo*>(track->GetUserInformation());
+    if (!trackInfo) trackInfo = MyTrackInfo::Attach(track);
+
     if (track->GetCurrentStepNumber() == 1){
-        if (fSteppingVerboseLevel == 1) {
+        if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
             G4cout<<"\n[DEBUG SteppingAction Step 1 Event]"<<eventID<<"\n Vertex="<<track->GetVertexPosition()/mm<<G4endl;}
     }
 
@@ -354,9 +173,14 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
     //  Ces noms ont été définis dans ta géométrie, souvent via SetName(...).
     if (!preLogic || !postLogic) return;
 
-     //  Récupération des noms de volumes
-    G4String namePre  = preLogic->GetName();
-    G4String namePost = postLogic->GetName();
+    //  Rôles des volumes pre/post (registre construit à la fin de DetectorConstruction::Construct)
+    //  Lookup par InstanceID : pas d'allocation ni de comparaison de chaînes dans le hot path
+    const VolumeRoleInfo& rolePre  = VolumeRoleRegistry::Lookup(preLogic);
+    const VolumeRoleInfo& rolePost = VolumeRoleRegistry::Lookup(postLogic);
+
+     //  Noms de volumes (références, sans copie) — utilisés uniquement par les traces
+    const G4String& namePre  = preLogic->GetName();
+    const G4String& namePost = postLogic->GetName();
 
     //  Récupération des matériaux
     G4Material* materialPre  = preLogic->GetMaterial();
@@ -365,8 +189,9 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
     //  Lecture des noms de matériaux
     //  Cette ligne évite les crashs si materialPre ou materialPost est nul.
     //  Cela permet d’avoir des chaînes valides, par exemple pour affichage ou comparaison.
-    G4String matNamePre  = materialPre  ? materialPre->GetName()  : "null";
-    G4String matNamePost = materialPost ? materialPost->GetName() : "null";
+    static const G4String kNullName = "null";
+    const G4String& matNamePre  = materialPre  ? materialPre->GetName()  : kNullName;
+    const G4String& matNamePost = materialPost ? materialPost->GetName() : kNullName;
 
     // [ADD] LV pointer trace désactivé pour réduire la verbosité
     // Décommenter pour débogage:
@@ -377,7 +202,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
      // DEBUG STEP  : position, nom de volume logique et matériaux
     G4ThreeVector prePos  = prePoint->GetPosition();
     G4ThreeVector postPos = postPoint->GetPosition();
-    if (fSteppingVerboseLevel == 1) {
+    if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
         G4cout << " \n[DEBUG SteppingAction] Event]  " << eventID<< G4endl;
         G4cout << " \n[DEBUG SteppingAction] Step : " << track->GetCurrentStepNumber()<< G4endl;
         G4cout << " \n[DEBUG SteppingAction] PreStep position : " << prePos / mm << " mm" << G4endl;
@@ -392,7 +217,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
     }
 
       // [TRACE] Frontières d'entrée/sortie dans logicScorePlane ===
-    do {
+    if (SIM_TRACE_SAMPLED()) do {
         const auto* track = step->GetTrack();
         if (!track || track->GetParentID()!=0) break; // primaire seulement
 
@@ -400,20 +225,16 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
         const auto post = step->GetPostStepPoint();
         if (!pre || !post) break;
 
-        const auto* prePV  = pre->GetPhysicalVolume();
-        const auto* postPV = post->GetPhysicalVolume();
-        const auto* preLV  = prePV  ? prePV->GetLogicalVolume()  : nullptr;
-        const auto* postLV = postPV ? postPV->GetLogicalVolume() : nullptr;
+        const bool preOnPlane  = (rolePre.planeIndex  == 0);
+        const bool postOnPlane = (rolePost.planeIndex == 0);
 
-        const bool enter = (preLV  && preLV->GetName()  != "logicScorePlane") &&
-        (postLV && postLV->GetName() == "logicScorePlane") &&
+        const bool enter = !preOnPlane && postOnPlane &&
         (post->GetStepStatus()==fGeomBoundary);
 
-        const bool leave = (preLV  && preLV->GetName()  == "logicScorePlane") &&
-        (postLV && postLV->GetName() != "logicScorePlane") &&
+        const bool leave = preOnPlane && !postOnPlane &&
         (post->GetStepStatus()==fGeomBoundary);
 
-        static int seen = 0, maxPrint = 5;  // Réduit de 40 à 5
+        static G4ThreadLocal int seen = 0, maxPrint = 5;  // Réduit de 40 à 5
         if ((enter || leave) && seen < maxPrint) {
             const auto& rpre  = pre->GetPosition();
             const auto& rpost = post->GetPosition();
@@ -427,7 +248,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
     } while(0);
 
     // [TRACE] Croisement du plan z=60 mm par le primaire ===
-    do {
+    if (SIM_TRACE_SAMPLED()) do {
         const auto* track = step->GetTrack();
         if (!track) break;
         if (track->GetParentID() != 0) break; // primaire uniquement
@@ -447,7 +268,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
             const auto* preLV  = prePV  ? prePV->GetLogicalVolume()  : nullptr;
             const auto* postLV = postPV ? postPV->GetLogicalVolume() : nullptr;
 
-            static int seen = 0, maxPrint = 5; // Réduit de 40 à 5
+            static G4ThreadLocal int seen = 0, maxPrint = 5; // Réduit de 40 à 5
             if (seen < maxPrint) {
                 G4cout << "[TRACE][Z=60] evt=" << (G4RunManager::GetRunManager()->GetCurrentEvent()
                 ? G4RunManager::GetRunManager()->GetCurrentEvent()->GetEventID() : -1)
@@ -458,61 +279,43 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
         }
     } while(0);
 
-    // Comptage entrée/sortie du plan pour PRIMAIRES uniquement (ParentID==0)
-    // Compteurs globaux à définir ailleurs (par ex. en haut du .cc) :
-    //    G4long gEnterPlanePrim = 0;
-    //    G4long gLeavePlanePrim = 0;
-    extern G4long gEnterPlanePrim;
-    extern G4long gLeavePlanePrim;
-
-    // --- Compteurs entrée/sortie plan pour PRIMAIRES (ParentID==0) ---
-    // Reconnaissance du plan via LV ("logicScorePlane") ou PV ("physScorePlane")
-    {
-        const bool preIsPlane  = (namePre  == "logicScorePlane")  ||
-        (preVolumeHandle  && preVolumeHandle->GetName()  == "physScorePlane");
-        const bool postIsPlane = (namePost == "logicScorePlane")  ||
-        (postVolumeHandle && postVolumeHandle->GetName() == "physScorePlane");
-        const bool isPrimary   = (track->GetParentID() == 0);
-
-    if (isPrimary) {
-    // ENTER : !preIsPlane && postIsPlane
-            if (!preIsPlane && postIsPlane) {
-            #ifdef G4MULTITHREADED
-                { G4AutoLock lock(&gPlanePrimMutex); ++gEnterPlanePrim; }
-            #else
-                ++gEnterPlanePrim;
-            #endif
-
-            static int dbgEnter = 0;
-                if (dbgEnter < 10 && fSteppingVerboseLevel == 1) {
-                    const auto pos = postPoint->GetPosition();
-                    G4cout << "[STEP][ENTER][prim] -> plane at ("
-                    << pos.x()/mm << "," << pos.y()/mm << "," << pos.z()/mm << ") mm" << G4endl;
-                    ++dbgEnter;
-                }
+    // --- Plans de comptage virtuels : passages détectés sur le segment pre -> post ---
+    // (ntuples plane_passages / ScorePlaneN + compteurs ENTER/LEAVE des primaires)
+    fVirtualPlanes.Process(step, fRunAction);
+
+    // --- Compteurs entrée/sortie des plans de scoring pour PRIMAIRES (ParentID==0) ---
+    // Plans reconnus via le registre des rôles (planeIndex), compteurs par thread
+    // dans RunAction (accumulables fusionnés en fin de run, sans mutex)
+    if (fRunAction && track->GetParentID() == 0 && rolePre.planeIndex != rolePost.planeIndex) {
+        // ENTER : le post-step est dans un plan différent du pre-step
+        if (rolePost.planeIndex >= 0) {
+            fRunAction->CountPlanePrimEnter(rolePost.planeIndex, track->GetWeight());
+
+            static G4ThreadLocal int dbgEnter = 0;
+            if (dbgEnter < 10 && SIM_TRACE(fSteppingVerboseLevel, 1)) {
+                const auto pos = postPoint->GetPosition();
+                G4cout << "[STEP][ENTER][prim] -> " << VolumeRoleRegistry::GetScorePlaneName(rolePost.planeIndex)
+                << " at (" << pos.x()/mm << "," << pos.y()/mm << "," << pos.z()/mm << ") mm" << G4endl;
+                ++dbgEnter;
             }
+        }
 
-    // LEAVE : preIsPlane && !postIsPlane
-            if (preIsPlane && !postIsPlane) {
-            #ifdef G4MULTITHREADED
-                { G4AutoLock lock(&gPlanePrimMutex); ++gLeavePlanePrim; }
-            #else
-                ++gLeavePlanePrim;
-            #endif
-
-            static int dbgLeave = 0;
-                if (dbgLeave < 10 && fSteppingVerboseLevel == 1) {
-                    const auto pos = prePoint->GetPosition();
-                    G4cout << "[STEP][LEAVE][prim] <- plane from ("
-                    << pos.x()/mm << "," << pos.y()/mm << "," << pos.z()/mm << ") mm" << G4endl;
-                    ++dbgLeave;
+        // LEAVE : le pre-step était dans un plan que l'on quitte
+        if (rolePre.planeIndex >= 0) {
+            fRunAction->CountPlanePrimLeave(rolePre.planeIndex, track->GetWeight());
+
+            static G4ThreadLocal int dbgLeave = 0;
+            if (dbgLeave < 10 && SIM_TRACE(fSteppingVerboseLevel, 1)) {
+                const auto pos = prePoint->GetPosition();
+                G4cout << "[STEP][LEAVE][prim] <- " << VolumeRoleRegistry::GetScorePlaneName(rolePre.planeIndex)
+                << " from (" << pos.x()/mm << "," << pos.y()/mm << "," << pos.z()/mm << ") mm" << G4endl;
+                ++dbgLeave;
             }
         }
     }
-    }
 
     // DEBUG STEP  : position, nom de volume logique et matériaux
-    if (fSteppingVerboseLevel == 1) {
+    if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
         G4cout << " \n[DEBUG SteppingAction] Event]  " << eventID<< G4endl;
         G4cout << " \n[DEBUG SteppingAction] Step : " << track->GetCurrentStepNumber()<< G4endl;
         G4cout << " \n[DEBUG SteppingAction] PreStep position : " << prePos / mm << " mm" << G4endl;
@@ -540,9 +343,11 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
     //      Si la particule n’était pas dans le Béryllium avant (namePre != ...)
     //      Et qu’elle se trouve dedans après (namePost == ...)
     //      Alors, la particule vient juste d’entrer dans le volume Béryllium.
-    if (namePre != "MiniX-TubeXFenetreBeryllium-Beryllium" &&
-        namePost == "MiniX-TubeXFenetreBeryllium-Beryllium") {
-        if (fSteppingVerboseLevel == 1) {
+    const bool preInBe  = rolePre.Has(VolumeRole::kBeWindow);
+    const bool postInBe = rolePost.Has(VolumeRole::kBeWindow);
+
+    if (!preInBe && postInBe) {
+        if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
             G4cout<<"🔸[DEBUG SteppingAction] Une particule entre dans MiniX-TubeXFenetreBeryllium-Beryllium !"<< G4endl;
             G4cout <<" \n[DEBUG SteppingAction] energy = "<<energy/keV<<G4endl;
         }
@@ -557,7 +362,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
 
       auto runAction = static_cast<const RunAction*>(G4RunManager::GetRunManager()->GetUserRunAction());
       if (runAction) {
-          if (fSteppingVerboseLevel == 1) {
+          if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
               G4cout << "[DEBUG SteppingAction] Entrée Béryllium : courant = "
           << fEventAction->GetNbEntrantInBe()
           << ", total global = " << runAction->GetTotalEntrantInBe() << G4endl;}
@@ -569,7 +374,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
     G4ThreeVector position_input = postPoint->GetPosition();
     G4String pname = track->GetParticleDefinition()->GetParticleName();
 
-    if (fSteppingVerboseLevel == 1) {
+    if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
         G4cout<<"[DEBUG SteppingAction]"<<"→ Position input :"<<position_input/mm<<"mm"<<G4endl;
         G4cout<<"[DEBUG SteppingAction]"<<"→ Particule :"<< pname<<", Énergie input :"<<energy/keV<<"keV"<<G4endl;}
 
@@ -590,8 +395,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
     //  La particule était dans le Béryllium
     //  Elle n’y est plus après le step
     //    C’est donc une détection de sortie du Béryllium.
-    if (namePre == "MiniX-TubeXFenetreBeryllium-Beryllium" &&
-        namePost != "MiniX-TubeXFenetreBeryllium-Beryllium") {
+    if (preInBe && !postInBe) {
 
     //  Position de sortie
     //
@@ -624,28 +428,25 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
 
     // Détection d’interaction dans le Béryllium
     // Teste si l’un des deux points du step est dans le Béryllium
-    if (namePre == "MiniX-TubeXFenetreBeryllium-Beryllium" ||
-        namePost == "MiniX-TubeXFenetreBeryllium-Beryllium") {
+    if (preInBe || postInBe) {
 
     // Dépôt d'énergie et processus défini
     G4double edep = step->GetTotalEnergyDeposit();
     const G4VProcess* process = postPoint->GetProcessDefinedStep();
 
-    if (process)
-        G4String procName = process->GetProcessName();
-        if (fSteppingVerboseLevel == 1) {
-            G4cout<<"\n[DEBUG SteppingAction] 💥 → Processus : "<<process->GetProcessName()<< G4endl;
-            G4cout<<"\n[DEBUG SteppingAction] 💥 → Dépôt d’énergie : "<<edep/keV<<"keV"<< G4endl;}
+    const G4bool physical = IsPhysicalInteraction(process);
+    if (process && SIM_TRACE(fSteppingVerboseLevel, 1)) {
+        G4cout<<"\n[DEBUG SteppingAction] 💥 → Processus : "<<process->GetProcessName()<< G4endl;
+        G4cout<<"\n[DEBUG SteppingAction] 💥 → Dépôt d’énergie : "<<edep/keV<<"keV"<< G4endl;}
 
     // Vérifie s’il y a eu interaction : dépôt d’énergie ou processus physique réel
 
-    if ((edep > 0.0 && edep < DBL_MAX) ||
-        (process && process->GetProcessName() != "Transportation" && process->GetProcessName() != "msc")){
-        if (fSteppingVerboseLevel == 1) {
+    if ((edep > 0.0 && edep < DBL_MAX) || physical){
+        if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
             G4cout << "\n[DEBUG SteppingAction] 💥 Interaction dans le Béryllium !" << G4endl;}
-        // Filtrer les processus non physiques
-        if (process->GetProcessName() != "Transportation" && process->GetProcessName() != "msc") {
-            if (fSteppingVerboseLevel == 1) {
+        // Filtrer les processus non physiques (process nul : dépôt sans processus défini)
+        if (physical) {
+            if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
                 G4cout << "\n[DEBUG SteppingAction] 💥 Interaction dans le Béryllium !" << G4endl;
                 G4cout << " [DEBUG SteppingAction] → Particule : "<<track->GetParticleDefinition()->GetParticleName()<<G4endl;
                 G4cout << " [DEBUG SteppingAction] → Processus : "<<process->GetProcessName()<<G4endl;
@@ -655,10 +456,10 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
         // ✅ Boucle sur les secondaires produits
         const auto* secondaries = step->GetSecondaryInCurrentStep();
         if (secondaries && !secondaries->empty()) {
-            if (fSteppingVerboseLevel == 1) {
+            if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
                 G4cout<<"[DEBUG SteppingAction] → Secondaires produits :"<<secondaries->size()<<G4endl;}
             for (const auto* sec : *secondaries) {
-                if (fSteppingVerboseLevel == 1) {
+                if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
                     G4cout << "[DEBUG SteppingAction]   ↪ "<< sec->GetParticleDefinition()->GetParticleName()
                     <<", E = "<<sec->GetKineticEnergy()/keV<<" keV"
                     <<", créé par : "
@@ -678,9 +479,8 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
     }
     }
 
-    if (namePre == "MiniX-TubeXFenetreBeryllium-Beryllium" &&
-    namePost != "MiniX-TubeXFenetreBeryllium-Beryllium") {
-        if (fSteppingVerboseLevel == 1) {
+    if (preInBe && !postInBe) {
+        if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
             G4cout << "[DEBUG SteppingAction] → Particule : "<<track->GetParticleDefinition()->GetParticleName()<<", Énergie output :"<< energy/keV<<"keV"<< G4endl;}
     }
 
@@ -693,97 +493,58 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
     // c'est-à-dire dans le volume PRE-step (où la particule commence), 
     // PAS dans le volume POST-step (où elle arrive).
     {
-        // Vérifier si on est dans un anneau d'eau
-        G4int ringIndex = -1;
-        if (namePre.find("logicWaterRing") != std::string::npos) {
-            // Extraire le numéro de l'anneau (dernier caractère)
-            char lastChar = namePre[namePre.length() - 1];
-            if (lastChar >= '0' && lastChar <= '4') {
-                ringIndex = lastChar - '0';
-            }
-        }
-        
+        // Index de l'anneau d'eau (-1 si le volume pre-step n'est pas une couronne)
+        const G4int ringIndex = rolePre.ringIndex;
+
         if (ringIndex >= 0) {
             G4double edepWater = step->GetTotalEnergyDeposit();
             if (edepWater > 0.0 && edepWater < DBL_MAX) {
                 // Transmettre l'énergie déposée à EventAction
                 if (fEventAction) {
-                    fEventAction->AddEdepToRing(ringIndex, edepWater / keV);  // en keV
+                    // keV × poids (biaisage de la source) : dose non biaisée
+                    fEventAction->AddEdepToRing(ringIndex, edepWater / keV * prePoint->GetWeight());
+                    if (fRunAction) fRunAction->AddDepthEdep(ringIndex, step);
                     
-                    if (fSteppingVerboseLevel == 1) {
+                    if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
                         G4cout << "[DOSE] Edep dans anneau " << ringIndex 
                                << " : " << edepWater/keV << " keV" << G4endl;
                     }
                 }
             }
+
+            // Estimateur de kerma par longueur de trace (/stepping/trackLengthEstimator) :
+            // chaque pas de photon dans la couronne contribue w · L · E · μen(E), y compris
+            // sans interaction ; kerma de collision ≈ dose ici (électrons de quelques µm)
+            if (fTrackLengthEstimator && fEventAction && track->GetDefinition() == G4Gamma::Definition()) {
+                if (const MuEnTable* muEn = MuEnTable::ForMaterial(materialPre)) {
+                    const G4double ekin = prePoint->GetKineticEnergy();
+                    const G4double tle  = prePoint->GetWeight() * step->GetStepLength() * ekin * muEn->GetMuEn(ekin);
+                    fEventAction->AddTrackLengthToRing(ringIndex, tle / keV);   // en keV
+                }
+            }
         }
     }
     // ==================== Fin dépôt d'énergie anneaux d'eau ====================
 
+    // Grille de dose 3D : dépôt placé en un point aléatoire du step (cf. DoseMesh)
+    if (fDoseMesh) fDoseMesh->Fill(step);
+
     G4ThreeVector pos_1 = prePoint->GetPosition();
     G4ThreeVector pos_2 = postPoint->GetPosition();
 
     G4int tid = G4Threading::G4GetThreadId();
 
-    if (fSteppingVerboseLevel == 2) {
+    if (SIM_TRACE(fSteppingVerboseLevel, 2)) {
         G4cout<<"[DEBUG SteppingAction] [Thread "<<tid<<"] Event #"<<eventID<<" → de "<<namePre<<" → " << namePost<< ", TrackID = " << track->GetTrackID() << G4endl;
     }
     //
 
     // 🔍 Affichage des volumes traversés à chaque step
-    if (fSteppingVerboseLevel == 2) {
+    if (SIM_TRACE(fSteppingVerboseLevel, 2)) {
         G4cout<<"[DEBUG SteppingAction] Event #"<<eventID<<"[Trace] de "<<namePre<<" ("<<matNamePre<<")"<<" → "<<namePost<<" ("<< matNamePost<<")"<<G4endl;
         G4cout<<"[DEBUG SteppingAction] Event #"<<eventID<<" → Position input : "<<pos_1/mm<<" mm"<<" → Position output : "<<pos_2 / mm<<" mm"<<G4endl;
     }
 
-    // Récupération ou création du TrackInfo
-    //  Ce bloc de code gère l’attachement et la gestion d'informations personnalisées
-    //  (via une classe MyTrackInfo) à chaque particule (G4Track),
-    //  pour suivre son historique (par exemple : entrée dans un volume, processus créateur...).
-    //
-    //  Geant4 permet d'attacher à chaque G4Track un objet utilisateur via :
-    //  utilise ici avec ta classe personnalisée MyTrackInfo, dérivée de G4VUserTrackInformation.
-    //
-    // MyTrackInfo* trackInfo = static_cast<MyTrackInfo*>(track->GetUserInformation());
-    //
-    // Si c’est le premier step du track
-    // création d' un MyTrackInfo et
-    // stockage du processus créateur (primary, compt, eBrem, etc.)
-    // 17/5  MyTrackInfo* trackInfo = static_cast<MyTrackInfo*>(track->GetUserInformation());
-    //  Création de l’objet si inexistant
-    //
-    //  Si le pointeur était nul, on crée un objet MyTrackInfo
-    //  Et on l’associe au track avec SetUserInformation(...)
-    //  Cela garantit que chaque track a ses propres infos personnalisées (comme "est-il déjà entré dans le cube ?")
-
-    if (!trackInfo) {
-        if (fSteppingVerboseLevel == 1) {
-            G4cout<<"[DEBUG SteppingAction] MyTrackInfo est nul → création..."<< G4endl;}
-        trackInfo = new MyTrackInfo();
-        track->SetUserInformation(trackInfo);
-
-        //  Enregistrement du processus créateur
-        //  récupères ici le processus qui a généré ce track, s’il s’agit d’un secondaire.
-        //  Si creator == nullptr, c’est une particule primaire.
-        const G4VProcess* creator = track->GetCreatorProcess();
-        G4String pname = (creator ? creator->GetProcessName() : "primary");
-        if (fSteppingVerboseLevel == 1) {
-            G4cout<<"[DEBUG SteppingAction] Processus créateur = "<< pname<<G4endl;}
-        //  Stockage du nom du processus dans MyTrackInfo
-        //  Si c’est une particule secondaire, on enregistre son processus d’origine ("compt", "eBrem", "eIoni"…).
-        //  Sinon on note "primary".
-        if (creator) {
-            G4String pname = creator->GetProcessName();
-            if (pname.length() > 100) {
-                if (fSteppingVerboseLevel == 1) {
-                    G4cerr<<"[DEBUG SteppingAction] ⚠️ Nom de processus anormalement long → "<<pname<<G4endl;}
-            }
-            trackInfo->SetCreatorProcess(pname);
-        } else {
-            trackInfo->SetCreatorProcess("primary");
-        }
-    }
-
     // Détection de l’entrée dans le cube
     // Si le track n’est pas encore marqué comme "entré dans le cube"
     // Et que son postStep est dans "logicWaterCube" → alors :
@@ -791,7 +552,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
     // Cela sert à :
     // Enregistrer l’entrée uniquement la première fois
     // Éviter de compter plusieurs fois si la particule repasse ou rebondit
-    if (!trackInfo->HasEnteredCube() && namePost == "logicWaterCube") {
+    if (!trackInfo->HasEnteredCube() && rolePost.Has(VolumeRole::kWaterCube)) {
         trackInfo->SetEnteredCube(true);
     }
 
@@ -805,7 +566,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
     //  La particule arrive dans la sphère après le step.
     //
     //  Marquer l’entrée une seule fois :
-    if (!trackInfo->HasEnteredSphere() && namePost == "logicsphereWater") {
+    if (!trackInfo->HasEnteredSphere() && rolePost.Has(VolumeRole::kWaterSphere)) {
         trackInfo->SetEnteredSphere(true);
         //  Met à jour le MyTrackInfo pour ce track.
         //  Cela garantit qu’on n’entrera plus jamais dans ce bloc pour ce track,
@@ -819,7 +580,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
         // Incrémenter compteur entrée sphère
         fEventAction->IncrementNbEntrantInWaterSphere();
         G4int NbEntrantInWaterSphere = fEventAction->GetNbEntrantInWaterSphere();
-        if (fSteppingVerboseLevel == 1) {
+        if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
             G4cout<<"NbEntrantInWaterSphere : "<<NbEntrantInWaterSphere<<G4endl;}
     }
 
@@ -831,7 +592,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
     //
     // Cela permet de comparer histogramme 0 (entrée) et 1 (sortie)
     // pour analyser l’atténuation ou la perte d’énergie.
-    if (namePre == "logicsphereWater" && namePost == "logicWaterCube") {
+    if (rolePre.Has(VolumeRole::kWaterSphere) && rolePost.Has(VolumeRole::kWaterCube)) {
         // [SUPPRIMÉ] // [SUPPRIMÉ] if (analysisManager)
             // [SUPPRIMÉ] analysisManager->FillH1(1, energy);  // Histogramme 1 : sortie sphère
     }
@@ -855,7 +616,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
     //            G4cout << " → Processus : " << process->GetProcessName() << G4endl;
     //        G4cout << " → Dépôt d’énergie : " << edep / keV << " keV" << G4endl;
 
-    if (namePre == "logicsphereWater" && namePost == "logicsphereWater") {
+    if (rolePre.Has(VolumeRole::kWaterSphere) && rolePost.Has(VolumeRole::kWaterSphere)) {
         G4double edep = step->GetTotalEnergyDeposit();
         const G4VProcess* process = postPoint->GetProcessDefinedStep();
         //G4String pname = track->GetParticleDefinition()->GetParticleName();
@@ -864,8 +625,8 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
             //G4String procName = process->GetProcessName();
 
             // Filtrer les processus non physiques
-            if (process->GetProcessName() != "Transportation" && process->GetProcessName() != "msc") {
-                if (fSteppingVerboseLevel == 1) {
+            if (IsPhysicalInteraction(process)) {
+                if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
                     G4cout<<"\n[DEBUG SteppingAction] 💦 Interaction dans WaterSphere !"<<G4endl;
                     G4cout<<" [DEBUG SteppingAction] → Particule : "<<track->GetParticleDefinition()->GetParticleName()<<G4endl;
                     G4cout<<" [DEBUG SteppingAction] → Processus : "<<process->GetProcessName()<<G4endl;
@@ -874,10 +635,10 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
                 // ✅ Boucle sur les secondaires produits
                 const auto* secondaries = step->GetSecondaryInCurrentStep();
                 if (secondaries && !secondaries->empty()) {
-                    if (fSteppingVerboseLevel == 1) {
+                    if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
                         G4cout<<"[DEBUG SteppingAction] → Secondaires produits : "<<secondaries->size()<<G4endl;}
                     for (const auto* sec : *secondaries) {
-                        if (fSteppingVerboseLevel == 1) {
+                        if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
                             G4cout<<"[DEBUG SteppingAction] ↪ "<<sec->GetParticleDefinition()->GetParticleName()
                             <<", E ="<<sec->GetKineticEnergy()/keV<<" keV"
                             <<", créé par : "
@@ -891,7 +652,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
             // Incrémenter compteur d'interaction
             fEventAction->IncrementNbInteractedInWaterSphere();
             G4int NbInteractedInWaterSphere = fEventAction->GetNbInteractedInWaterSphere();
-            if (fSteppingVerboseLevel == 1) {
+            if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
                 G4cout<<"[DEBUG SteppingAction] NbInteractedtInWaterSphere : "<<NbInteractedInWaterSphere<<G4endl;
             }
             // [SUPPRIMÉ] // [SUPPRIMÉ] if (analysisManager)
@@ -919,7 +680,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
     //  Cela permet ensuite dans EventAction::EndOfEventAction() d’enregistrer :
     if (track->GetTrackID() == 1 && track->GetCurrentStepNumber() == 1) {
         fEventAction->SetTrackInfo(trackInfo);
-        if (fSteppingVerboseLevel == 1) {
+        if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
             G4cout<<"[DEBUG SteppingAction] SetTrackInfo (initial) pour track primaire"<<G4endl;}}
 
     // Tuer les particules sortant du cube vers l'extérieur
@@ -933,17 +694,17 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
     // track->SetTrackStatus(fStopAndKill) :
     // Tue immédiatement la particule
     // Empêche Geant4 de continuer à la propager (gain de performance)
-    if (namePre == "logicWaterCube" &&
-        namePost != "logicWaterCube" &&
-        namePost != "logicsphereWater") {
-        if (fSteppingVerboseLevel == 1) {
+    if (rolePre.Has(VolumeRole::kWaterCube) &&
+        !rolePost.Has(VolumeRole::kWaterCube) &&
+        !rolePost.Has(VolumeRole::kWaterSphere)) {
+        if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
             G4cout <<"[DEBUG SteppingAction] ☠️ Particule tuée (sortie définitive de logicWaterCube)"<<G4endl;
             G4cout <<"[DEBUG SteppingAction] de "<<namePre<<" → "<<namePost<<G4endl;}
         track->SetTrackStatus(fStopAndKill);
     }
 
     // Test de l sortie de la sphere logicEnveloppeGDML
-    if (namePre == "logicEnveloppeGDML" && namePost != "logicEnveloppeGDML") {
+    if (rolePre.Has(VolumeRole::kEnvelope) && !rolePost.Has(VolumeRole::kEnvelope)) {
         G4ThreeVector sortie = postPoint->GetPosition();
         G4String particleName = track->GetParticleDefinition()->GetParticleName();
         G4double energyOut = track->GetKineticEnergy();
@@ -957,7 +718,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
         G4double phiDeg   = phi / deg;
         G4double cosTheta = std::cos(theta);
 
-        if (fSteppingVerboseLevel == 1) {
+        if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
             G4cout << "\n[DEBUG SteppingAction] 🚪 Sortie de la sphère EnveloppeGDML détectée !" << G4endl;
             G4cout << "  → Position sortie : " << sortie / mm << " mm" << G4endl;
             G4cout << "  → Particule       : " << particleName << G4endl;
@@ -966,12 +727,12 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
 
         // Filtrage : primaire
     if (isPrimary) {
-        if (fSteppingVerboseLevel == 1) {
+        if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
             G4cout<<"\n[DEBUG SteppingAction] ✅ Sortie d'une particule primaire ("<<particleName<<")de l'enveloppe GDML"<<G4endl;
             G4cout<<"r → "<<r<<"theta → "<<thetaDeg<<"phi → "<<phiDeg<<G4endl;}
         // [SUPPRIMÉ] // [SUPPRIMÉ] if (analysisManager)
         {
-            if (fSteppingVerboseLevel == 1) {
+            if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
                 G4cout<<"\n[DEBUG SteppingAction] ✅ Remplissage des histos →"<<G4endl;}
             // [SUPPRIMÉ] analysisManager->FillH1(7, thetaDeg);
             // [SUPPRIMÉ] analysisManager->FillH1(8, phiDeg);
@@ -979,12 +740,12 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
         }
 
     } else {
-        if (fSteppingVerboseLevel == 1) {
+        if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
         G4cout<<"\n[DEBUG SteppingAction] 🌀 Sortie d'une particule secondaire ("<<particleName<<") de l'enveloppe GDML"<<G4endl;
         G4cout<<"r → "<<r<<"theta → "<<thetaDeg<<"phi → "<<phiDeg<<G4endl;}
         // [SUPPRIMÉ] // [SUPPRIMÉ] if (analysisManager)
         {
-            if (fSteppingVerboseLevel == 1) {
+            if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
                 G4cout<<"\n[DEBUG SteppingAction] 🌀 Remplissage des histos →"<<G4endl;}
             // [SUPPRIMÉ] analysisManager->FillH1(9, thetaDeg);
             // [SUPPRIMÉ] analysisManager->FillH1(10, phiDeg);
@@ -995,7 +756,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
 
     //  Debug (optionnel)
     //G4int eventID = G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID();
-    if (fSteppingVerboseLevel == 1) {
+    if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
         G4cout << "[DEBUG SteppingAction]  Event #"<<eventID<<" — trackID: "<<track->GetTrackID()<< G4endl;
         G4cout << "[DEBUG SteppingAction] → de "<<namePre<<" → "<<namePost<<G4endl;
       if (trackInfo->HasEnteredCube())
@@ -1004,11 +765,8 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
         G4cout << "[DEBUG SteppingAction] ✓ Entré dans sphère\n";
     }
 
-    G4String creator = trackInfo->GetCreatorProcess();
-    if (creator.empty()) creator = "unknown";
-
-    if (fSteppingVerboseLevel == 1) {
-        G4cout<<"[DEBUG SteppingAction] → Processus créateur : "<<creator<<G4endl;}
+    if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
+        G4cout<<"[DEBUG SteppingAction] → Processus créateur : "<<ProcessIdTable::GetName(trackInfo->GetCreatorProcessId())<<G4endl;}
 
 
 
@@ -1026,7 +784,7 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
         // si la particule est réellement entrée dans ces volumes
         if (trackInfo && fEventAction) {
             fEventAction->SetTrackInfo(trackInfo);
-            if (fSteppingVerboseLevel == 1) {
+            if (SIM_TRACE(fSteppingVerboseLevel, 1)) {
                 G4cout << "[DEBUG SteppingAction] SetTrackInfo (FINAL) - "
                        << "cube=" << trackInfo->HasEnteredCube()
                        << " sphere=" << trackInfo->HasEnteredSphere() << G4endl;
@@ -1038,26 +796,18 @@ void SteppingAction::UserSteppingAction(const G4Step *step)
         const auto* lv   = pv ? pv->GetLogicalVolume() : nullptr;
         const auto* mat  = postPoint->GetMaterial();
 
-        // [LOSS] Si le primaire s'arrête avant le plan z=60 mm, comptabiliser (proc + matériau)
-        do {
-            constexpr G4double zPlane = 60.*mm;
-            const G4double zPost = postPoint->GetPosition().z();
-            if (zPost >= zPlane) break; // pas "perdu avant le plan"
-            const auto* preMat   = prePoint->GetMaterial();
-            const auto* stepProc = postPoint->GetProcessDefinedStep();
-            const std::string mname = preMat ? std::string(preMat->GetName()) : "Unknown";
-            const std::string pname = stepProc ? std::string(stepProc->GetProcessName()) : "Unknown";
-            #ifdef G4MULTITHREADED
-            { G4AutoLock lock(&gLossMapMutex); ++gLostByMat[mname]; ++gLostByProc[pname]; }
-            #else
-            ++gLostByMat[mname];
-            ++gLostByProc[pname];
-            #endif
-        } while(0);
+        // [LOSS] Si le primaire s'arrête avant le plan z=60 mm, comptabiliser
+        //        (sous-type de processus, matériau, énergie pre-step) sans verrou ni string
+        constexpr G4double zPlane = 60.*mm;
+        if (fLossTable && postPoint->GetPosition().z() < zPlane) {
+            fLossTable->Count(postPoint->GetProcessDefinedStep(),
+                              prePoint->GetMaterial(),
+                              prePoint->GetKineticEnergy());
+        }
 
         // COMMENTÉ pour réduire la taille du fichier log
         /*
-        static int seen=0, maxPrint=60;
+        static G4ThreadLocal int seen=0, maxPrint=60;
         if (seen < maxPrint) {
         const auto* rm = G4RunManager::GetRunManager();
         const int eid  = (rm && rm->GetCurrentEvent()) ? rm->GetCurrentEvent()->GetEventID() : -1;
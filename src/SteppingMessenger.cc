@@ -2,6 +2,7 @@
 #include "SteppingAction.hh"
 
 #include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithABool.hh"
 #include "G4UIdirectory.hh"
 #include "G4UIcommand.hh"
 
@@ -15,11 +16,31 @@ SteppingMessenger::SteppingMessenger(SteppingAction* stepping)
     fVerboseCmd->SetGuidance("Définit le niveau de verbosité pour SteppingAction.");
     fVerboseCmd->SetParameterName("verboseLevel", false);
     fVerboseCmd->SetRange("verboseLevel>=0");
+
+    fTraceEventsCmd = new G4UIcmdWithAnInteger("/stepping/traceEvents", this);
+    fTraceEventsCmd->SetGuidance("Trace binaire step par step des N premiers événements (eventID < N).");
+    fTraceEventsCmd->SetGuidance("Fichier steptrace_run<R>_<thread>.bin, décodé par steptrace_decode.");
+    fTraceEventsCmd->SetGuidance("0 par défaut : aucune trace écrite.");
+    fTraceEventsCmd->SetParameterName("nEvents", false);
+    fTraceEventsCmd->SetRange("nEvents>=0");
+
+    fTraceEventIDCmd = new G4UIcmdWithAnInteger("/stepping/traceEventID", this);
+    fTraceEventIDCmd->SetGuidance("Ajoute un eventID précis à la trace binaire step par step.");
+    fTraceEventIDCmd->SetParameterName("eventID", false);
+    fTraceEventIDCmd->SetRange("eventID>=0");
+
+    fTrackLengthCmd = new G4UIcmdWithABool("/stepping/trackLengthEstimator", this);
+    fTrackLengthCmd->SetGuidance("Dose des couronnes d'eau aussi par longueur de trace des photons (w·L·E·μen).");
+    fTrackLengthCmd->SetGuidance("Résultat à côté du dépôt analogique (RUN SUMMARY, ntuple dose_stats, estimator = 1).");
+    fTrackLengthCmd->SetParameterName("enable", false);
 }
 
 SteppingMessenger::~SteppingMessenger()
 {
     delete fVerboseCmd;
+    delete fTraceEventsCmd;
+    delete fTraceEventIDCmd;
+    delete fTrackLengthCmd;
 }
 
 void SteppingMessenger::SetNewValue(G4UIcommand* command, G4String value)
@@ -27,4 +48,13 @@ void SteppingMessenger::SetNewValue(G4UIcommand* command, G4String value)
     if (command == fVerboseCmd) {
         fStepping->SetVerbose(fVerboseCmd->GetNewIntValue(value));
     }
+    else if (command == fTraceEventsCmd) {
+        fStepping->GetTraceRecorder()->SetMaxTracedEvents(fTraceEventsCmd->GetNewIntValue(value));
+    }
+    else if (command == fTraceEventIDCmd) {
+        fStepping->GetTraceRecorder()->AddTracedEventID(fTraceEventIDCmd->GetNewIntValue(value));
+    }
+    else if (command == fTrackLengthCmd) {
+        fStepping->SetTrackLengthEstimator(fTrackLengthCmd->GetNewBoolValue(value));
+    }
 }
@@ -8,6 +8,8 @@
 #include "G4Track.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4VProcess.hh"
+#include "SimTrace.hh"
+#include "ProcessIdTable.hh"
 
 // ============================================================================
 // [ADD] Helper Master/Worker (ou SEQ) pour les logs
@@ -57,6 +59,7 @@ SurfaceSpectrumSD::~SurfaceSpectrumSD() = default;
 void SurfaceSpectrumSD::Initialize(G4HCofThisEvent*)
 {
   fRowsThisEvent = 0;  // [ADD] compteur par event
+  fPrimaryRowThisEvent = false;
   // COMMENTÉ pour réduire la taille du fichier log
   // auto ev  = G4RunManager::GetRunManager()->GetCurrentEvent();
   // G4int eid = ev ? ev->GetEventID() : -1;
@@ -91,16 +94,16 @@ G4bool SurfaceSpectrumSD::ProcessHits(G4Step* step, G4TouchableHistory*)
   const auto* prePV   = pre->GetPhysicalVolume();
   const auto* postPV  = post->GetPhysicalVolume();
 
-  // [ADD] Count ENTER/LEAVE plane occurrences (use PV name "physScorePlane")
-  const bool enteringPlane =
-  ( (!prePV) || (prePV->GetName() != "physScorePlane") ) &&
-  ( postPV && postPV->GetName() == "physScorePlane" );
+  // [ADD] Count ENTER/LEAVE plane occurrences (pointeur du PV "physScorePlane")
+  const bool preInPlane  = (prePV  != nullptr) && (prePV  == fPlanePV);
+  const bool postInPlane = (postPV != nullptr) && (postPV == fPlanePV);
+  const bool enteringPlane = !preInPlane && postInPlane;
   if (enteringPlane) { ++fCntEnter; }
 
   // [ADD] Trace léger : appels à ProcessHits (limité à 30 lignes)
   {
-    static int dbg_calls = 0;
-    if (dbg_calls < 30) {
+    static G4ThreadLocal int dbg_calls = 0;
+    if (SIM_TRACE_SAMPLED() && dbg_calls < 30) {
       G4cout << "[SpecSD::ProcessHits] pre=" << (prePV ? prePV->GetName() : "<null>")
       << " -> post=" << (postPV ? postPV->GetName() : "<null>")
       << " prePos=" << posPre/mm << " mm"
@@ -116,12 +119,10 @@ G4bool SurfaceSpectrumSD::ProcessHits(G4Step* step, G4TouchableHistory*)
   // [FIX] Ne compter que la **SORTIE** du plan mince :
   //  - prePV == physScorePlane
   //  - postPV != physScorePlane (ou nul)
-  const bool leavingPlane =
-  (prePV && prePV->GetName() == "physScorePlane") &&
-  (!postPV || postPV->GetName() != "physScorePlane");
+  const bool leavingPlane = preInPlane && !postInPlane;
   if (!leavingPlane) {
-    static int dbg_reject_leave = 0;
-    if (dbg_reject_leave < 10) {
+    static G4ThreadLocal int dbg_reject_leave = 0;
+    if (SIM_TRACE_SAMPLED() && dbg_reject_leave < 10) {
       G4cout << "[SpecSD] skip (not leaving physScorePlane)"
       << " pre="  << (prePV  ? prePV->GetName()  : "<null>")
       << " post=" << (postPV ? postPV->GetName() : "<null>")
@@ -131,9 +132,23 @@ G4bool SurfaceSpectrumSD::ProcessHits(G4Step* step, G4TouchableHistory*)
     return false;
   }
 
+  // [KEEP] Énergie et position au point de sortie (post-step)
+  return ScoreLeave(step->GetTrack(), posPost, post->GetKineticEnergy(), dir);
+}
+
+// ============================================================================
+// ScoreLeave : sortie du plan validée (appelé par ProcessHits en mode "volume",
+// par VirtualPlaneScorer en mode "virtual" avec la position interpolée)
+// ============================================================================
+G4bool SurfaceSpectrumSD::ScoreLeave(const G4Track* track, const G4ThreeVector& pos,
+                                     G4double ekin, const G4ThreeVector& dir)
+{
+  if (!track) return false;
+
   // [ADD] outward subset counter (only when outward-only filter is active and passed)
   if (fOutwardOnly && dir.z() > 0.) { 
     ++fCntOut;
+    fWeightOut += track->GetWeight();
     
     // [ADD] Incrémenter le compteur de photons transmis dans RunAction
     auto* runManager = G4RunManager::GetRunManager();
@@ -141,91 +156,83 @@ G4bool SurfaceSpectrumSD::ProcessHits(G4Step* step, G4TouchableHistory*)
       auto* runAction = const_cast<RunAction*>(
         static_cast<const RunAction*>(runManager->GetUserRunAction()));
       if (runAction) {
-        runAction->AddTransmittedPhoton();
+        runAction->AddTransmittedPhoton(track->GetWeight());
       }
     }
   }
 
   // [FIX] Direction monde : garder uniquement le flux sortant vers +Z si demandé
   if (fOutwardOnly && dir.z() <= 0.) {
-    static int dbg_reject_inward = 0;
-    if (dbg_reject_inward < 10) {
+    static G4ThreadLocal int dbg_reject_inward = 0;
+    if (SIM_TRACE_SAMPLED() && dbg_reject_inward < 10) {
       G4cout << "[SpecSD] REJECT (inward/side) dirZ=" << dir.z() << G4endl;
       ++dbg_reject_inward;
     }
     return false;
   }
 
-  // [KEEP] Énergie au point de sortie (post-step), en keV
-  const G4double E_keV = post->GetKineticEnergy()/keV;
+  // [KEEP] Énergie au point de sortie, en keV
+  const G4double E_keV = ekin/keV;
 
   // [KEEP] Binning du spectre
   const G4int ib = BinIndex(E_keV, fEMin_keV, fEMax_keV, fNBins);
-  if (ib >= 0) fBins[ib] += 1.0;
+  if (ib >= 0) fBins[ib] += track->GetWeight();   // Σ poids (1 par photon sans biaisage)
+
+  // [ADD] Spectre pondéré par classe (0 = primaire, 1 = secondaire) : le H1 garde Σw et Σw²
+  const G4int hid = fSpectrumH1Id[track->GetParentID() == 0 ? 0 : 1];
+  if (hid >= 0) {
+    auto* man = G4AnalysisManager::Instance();
+    if (man->IsActive()) man->FillH1(hid, E_keV, track->GetWeight());
+  }
 
   // [FIX] Écriture dans l'ntuple de passages (si actif)
   if (fPassageNtupleId >= 0) {
     auto* man = G4AnalysisManager::Instance();
     if (man && man->IsActive()) {
-      // [FIX] Position au point de sortie (post-step)
-      const auto pos = post->GetPosition();
+      // [FIX] Position au point de sortie
       const G4double x_mm = pos.x()/mm;
       const G4double y_mm = pos.y()/mm;
       const G4double z_mm = pos.z()/mm;
 
-      const auto* def     = step->GetTrack()->GetDefinition();
+      const auto* def     = track->GetDefinition();
       const G4int pdg     = def ? def->GetPDGEncoding()  : 0;
-      const G4String name = def ? def->GetParticleName() : "unknown";
 
-      // [ADD] TrackID, ParentID et processus créateur
-      const G4Track* track = step->GetTrack();
+      // [ADD] TrackID, ParentID et processus créateur (identifiant interné, cf. ntuple "dictionary")
       const G4int trackID = track->GetTrackID();
       const G4int parentID = track->GetParentID();
-      const G4VProcess* creatorProcess = track->GetCreatorProcess();
-      G4String creator_process = "primary";
-      if (creatorProcess) {
-          creator_process = creatorProcess->GetProcessName();
-      }
+      const G4int creator_process_id = ProcessIdTable::GetId(track->GetCreatorProcess());
 
       // ==================== Remplissage du ntuple plane_passages ====================
       // Structure harmonisée avec les autres ntuples:
-      // colonnes : pdg, name, is_secondary, x_mm, y_mm, z_mm, ekin_keV, trackID, parentID, creator_process
+      // colonnes : pdg, is_secondary, x_mm, y_mm, z_mm, ekin_keV, trackID, parentID, creator_process_id, weight
       
       // Calculer is_secondary (0 = primaire, 1 = secondaire)
       G4int is_secondary = (parentID == 0) ? 0 : 1;
 
       // Log limité pour vérification (3 premiers seulement)
-      static int c=0, maxPrint=3;
-      if (c < maxPrint) {
+      static G4ThreadLocal int c=0, maxPrint=3;
+      if (SIM_TRACE_SAMPLED() && c < maxPrint) {
         G4cout << "[plane_passages][fill#" << (c+1) << "] pdg="<<pdg
         << " x="<<x_mm<<" y="<<y_mm<<" E="<<E_keV<<" keV" << G4endl;
         ++c;
       }
       
       // Remplissage dans l'ordre des colonnes définies dans AnalysisManagerSetup.cc
-      man->FillNtupleIColumn(fPassageNtupleId, 0, pdg);             // Col 0: pdg (int)
-      man->FillNtupleSColumn(fPassageNtupleId, 1, name);            // Col 1: name (string)
-      man->FillNtupleIColumn(fPassageNtupleId, 2, is_secondary);    // Col 2: is_secondary (int)
-      man->FillNtupleDColumn(fPassageNtupleId, 3, x_mm);            // Col 3: x_mm (double)
-      man->FillNtupleDColumn(fPassageNtupleId, 4, y_mm);            // Col 4: y_mm (double)
-      man->FillNtupleDColumn(fPassageNtupleId, 5, z_mm);            // Col 5: z_mm (double)
-      man->FillNtupleDColumn(fPassageNtupleId, 6, E_keV);           // Col 6: ekin_keV (double)
-      man->FillNtupleIColumn(fPassageNtupleId, 7, trackID);         // Col 7: trackID (int)
-      man->FillNtupleIColumn(fPassageNtupleId, 8, parentID);        // Col 8: parentID (int)
-      man->FillNtupleSColumn(fPassageNtupleId, 9, creator_process); // Col 9: creator_process (string)
+      man->FillNtupleIColumn(fPassageNtupleId, 0, pdg);                // Col 0: pdg (int)
+      man->FillNtupleIColumn(fPassageNtupleId, 1, is_secondary);       // Col 1: is_secondary (int)
+      man->FillNtupleDColumn(fPassageNtupleId, 2, x_mm);               // Col 2: x_mm (double)
+      man->FillNtupleDColumn(fPassageNtupleId, 3, y_mm);               // Col 3: y_mm (double)
+      man->FillNtupleDColumn(fPassageNtupleId, 4, z_mm);               // Col 4: z_mm (double)
+      man->FillNtupleDColumn(fPassageNtupleId, 5, E_keV);              // Col 5: ekin_keV (double)
+      man->FillNtupleIColumn(fPassageNtupleId, 6, trackID);            // Col 6: trackID (int)
+      man->FillNtupleIColumn(fPassageNtupleId, 7, parentID);           // Col 7: parentID (int)
+      man->FillNtupleIColumn(fPassageNtupleId, 8, creator_process_id); // Col 8: creator_process_id (int)
+      man->FillNtupleDColumn(fPassageNtupleId, 9, track->GetWeight());  // Col 9: weight (double)
       man->AddNtupleRow(fPassageNtupleId);
 
       // [ADD] rows counter and unique primary event marker
       ++fCntRows;
-      {
-        const auto* tr = step->GetTrack();
-        if (tr && tr->GetParentID() == 0) {
-          auto* rm = G4RunManager::GetRunManager();
-          auto* ev = rm ? rm->GetCurrentEvent() : nullptr;
-          const int eid = ev ? ev->GetEventID() : -1;
-          fEventsPrimaryCounted.insert(eid);
-        }
-      }
+      if (parentID == 0) fPrimaryRowThisEvent = true;
 
       // [ADD] Compteurs (sans logs excessifs)
       ++fRowsThisEvent; ++fRowsTotal;
@@ -239,14 +246,14 @@ G4bool SurfaceSpectrumSD::ProcessHits(G4Step* step, G4TouchableHistory*)
       // }
 
       // Confirmation limitée désactivée (décommenter pour débogage)
-      // static int dbg_write = 0;
-      // if (dbg_write < 5) {
+      // static G4ThreadLocal int dbg_write = 0;
+      // if (SIM_TRACE_SAMPLED() && dbg_write < 5) {
       //   G4cout << "[SpecSD] WROTE row x=" << x_mm << " y=" << y_mm << " z=" << z_mm << G4endl;
       //   ++dbg_write;
       // }
     } else {
       // [WARN] Diag utile si l’analysis est inactive (ne devrait plus arriver)
-      static int dbg_inactive = 0;
+      static G4ThreadLocal int dbg_inactive = 0;
       if (dbg_inactive < 10) {
         G4cout << "[SpecSD][WARN] Analysis manager inactive — row NOT written"
         << " (ntupleId=" << fPassageNtupleId << ")"
@@ -260,6 +267,7 @@ G4bool SurfaceSpectrumSD::ProcessHits(G4Step* step, G4TouchableHistory*)
 }
 
 void SurfaceSpectrumSD::EndOfEvent(G4HCofThisEvent*) {
+  if (fPrimaryRowThisEvent) ++fEventsPrimaryCounted;
   // COMMENTÉ pour réduire la taille du fichier log
   // auto ev = G4RunManager::GetRunManager()->GetCurrentEvent();
   // G4int eid = ev ? ev->GetEventID() : -1;
@@ -274,8 +282,9 @@ void SurfaceSpectrumSD::PrintSummary() const {
   G4cout << "[SpecSD][SUMMARY] enter=" << fCntEnter
   << " leave=" << fCntLeave
   << " outward=" << fCntOut
+  << " outward_w=" << fWeightOut
   << " rows_written=" << fCntRows
-  << " unique_primary_events_counted=" << fEventsPrimaryCounted.size()
+  << " unique_primary_events_counted=" << fEventsPrimaryCounted
   << G4endl;
 }
 
@@ -7,10 +7,15 @@
 #include "G4TrackingManager.hh"
 #include "G4Trajectory.hh"
 
+#include "MyTrackInfo.hh"
+
 TrackingAction::TrackingAction() {}
 
 void TrackingAction::PreUserTrackingAction(const G4Track* track)
 {
+    // Infos utilisateur du track (pool thread-local, processus créateur en entier)
+    MyTrackInfo::Attach(track);
+
     // Demande à Geant4 de stocker les trajectoires
     fpTrackingManager->SetStoreTrajectory(true);
 
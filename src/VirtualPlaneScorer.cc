@@ -0,0 +1,89 @@
+#include "VirtualPlaneScorer.hh"
+
+#include "PlaneCrossingSD.hh"
+#include "RunAction.hh"
+#include "SurfaceSpectrumSD.hh"
+
+#include "G4ParticleDefinition.hh"
+#include "G4SDManager.hh"
+#include "G4Track.hh"
+#include "G4ios.hh"
+
+#include <cmath>
+
+std::vector<VirtualPlane> VirtualPlaneScorer::fPlanes;
+
+const VirtualPlane* VirtualPlaneScorer::FindPlane(const G4String& sdName)
+{
+    for (const auto& plane : fPlanes) {
+        if (plane.sdName == sdName) return &plane;
+    }
+    return nullptr;
+}
+
+void VirtualPlaneScorer::Bind()
+{
+    auto* sdm = G4SDManager::GetSDMpointer();
+    fSpecSDs.assign(fPlanes.size(), nullptr);
+    fCrossingSDs.assign(fPlanes.size(), nullptr);
+
+    for (std::size_t i = 0; i < fPlanes.size(); ++i) {
+        G4VSensitiveDetector* sd = sdm->FindSensitiveDetector(fPlanes[i].sdName, /*warning=*/false);
+        fSpecSDs[i]     = dynamic_cast<SurfaceSpectrumSD*>(sd);
+        fCrossingSDs[i] = dynamic_cast<PlaneCrossingSD*>(sd);
+        if (!sd) {
+            G4cout << "[SCORING][WARN] plan virtuel " << fPlanes[i].sdName
+                   << " : SD introuvable, seuls les compteurs de primaires seront remplis" << G4endl;
+        }
+    }
+    fBound = true;
+}
+
+void VirtualPlaneScorer::ProcessPlane(const G4Step* step, std::size_t i, RunAction* runAction)
+{
+    if (!fBound) Bind();
+
+    const VirtualPlane& plane = fPlanes[i];
+    const G4StepPoint* pre  = step->GetPreStepPoint();
+    const G4StepPoint* post = step->GetPostStepPoint();
+    const G4Track* track    = step->GetTrack();
+
+    const G4ThreeVector& p0 = pre->GetPosition();
+    const G4ThreeVector& p1 = post->GetPosition();
+    const G4double dz = p1.z() - p0.z();
+
+    // Neutres : pas de perte continue, l'énergie au plan est celle du pre-step.
+    // Chargés : interpolation linéaire de la perte continue le long du step.
+    const G4bool charged = track->GetDefinition()->GetPDGCharge() != 0.;
+    const G4double e0 = pre->GetKineticEnergy();
+    const G4double e1 = post->GetKineticEnergy();
+
+    // Face d'entrée puis face de sortie, dans le sens du déplacement
+    const G4double faces[2] = { dz > 0. ? plane.zMin : plane.zMax,
+                                dz > 0. ? plane.zMax : plane.zMin };
+
+    for (G4int k = 0; k < 2; ++k) {
+        const G4double zf = faces[k];
+        // Intervalle semi-ouvert : un step qui s'arrête sur la face la compte, le suivant non
+        if ((p0.z() < zf) == (p1.z() < zf)) continue;
+
+        const G4double f = (zf - p0.z()) / dz;
+        const G4ThreeVector pos = p0 + f * (p1 - p0);
+        if (std::abs(pos.x()) > plane.hx || std::abs(pos.y()) > plane.hy) continue;
+
+        const G4double ekin = charged ? e0 + f * (e1 - e0) : e0;
+        const G4bool entering = (k == 0);
+
+        if (runAction && track->GetParentID() == 0 && plane.planeIndex >= 0) {
+            if (entering) runAction->CountPlanePrimEnter(plane.planeIndex, track->GetWeight());
+            else          runAction->CountPlanePrimLeave(plane.planeIndex, track->GetWeight());
+        }
+
+        if (entering) {
+            if (fSpecSDs[i])     fSpecSDs[i]->CountEnter();
+            if (fCrossingSDs[i]) fCrossingSDs[i]->ScoreEntry(track, pos, ekin, pre->GetMomentumDirection());
+        } else {
+            if (fSpecSDs[i])     fSpecSDs[i]->ScoreLeave(track, pos, ekin, pre->GetMomentumDirection());
+        }
+    }
+}
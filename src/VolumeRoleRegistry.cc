@@ -0,0 +1,71 @@
+#include "VolumeRoleRegistry.hh"
+
+#include "G4LogicalVolumeStore.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <string>
+
+std::vector<VolumeRoleInfo> VolumeRoleRegistry::fByInstance;
+const VolumeRoleInfo VolumeRoleRegistry::fNone;
+
+namespace {
+    // Noms des volumes logiques des plans de comptage, dans l'ordre des index de plan
+    const char* const kScorePlaneLV[VolumeRoleRegistry::kNbScorePlanes] = {
+        "logicScorePlane", "logicScorePlane2", "logicScorePlane3", "logicScorePlane5"
+    };
+}
+
+const char* VolumeRoleRegistry::GetScorePlaneName(G4int planeIndex)
+{
+    if (planeIndex < 0 || planeIndex >= kNbScorePlanes) return "unknown";
+    return kScorePlaneLV[planeIndex];
+}
+
+// Les comparaisons de noms ne sont faites qu'ici, une fois par construction de géométrie
+void VolumeRoleRegistry::Build()
+{
+    auto* lvStore = G4LogicalVolumeStore::GetInstance();
+
+    std::size_t maxId = 0;
+    for (auto* lv : *lvStore) {
+        if (lv) maxId = std::max(maxId, static_cast<std::size_t>(lv->GetInstanceID()) + 1);
+    }
+    fByInstance.assign(maxId, VolumeRoleInfo());
+
+    G4int nClassified = 0;
+    for (auto* lv : *lvStore) {
+        if (!lv) continue;
+        const std::string name = lv->GetName();
+        VolumeRoleInfo info;
+
+        if (name == "logicWorld")                                 info.roles |= VolumeRole::kWorld;
+        if (name == "logicEnveloppeGDML")                         info.roles |= VolumeRole::kEnvelope;
+        if (name == "MiniX-TubeXFenetreBeryllium-Beryllium")      info.roles |= VolumeRole::kBeWindow;
+        if (name == "logicWaterCube")                             info.roles |= VolumeRole::kWaterCube;
+        if (name == "logicsphereWater")                           info.roles |= VolumeRole::kWaterSphere;
+
+        for (G4int p = 0; p < kNbScorePlanes; ++p) {
+            if (name == kScorePlaneLV[p]) {
+                info.roles |= VolumeRole::kScorePlane;
+                info.planeIndex = p;
+            }
+        }
+
+        // logicWaterRingN : N = dernier caractère (0..4)
+        const std::string ringPrefix = "logicWaterRing";
+        if (name.size() == ringPrefix.size() + 1 && name.compare(0, ringPrefix.size(), ringPrefix) == 0) {
+            const char c = name.back();
+            if (c >= '0' && c <= '4') {
+                info.roles |= VolumeRole::kWaterRing;
+                info.ringIndex = c - '0';
+            }
+        }
+
+        if (info.roles != VolumeRole::kNone) ++nClassified;
+        fByInstance[static_cast<std::size_t>(lv->GetInstanceID())] = info;
+    }
+
+    G4cout << "[GEOM][ROLES] Registre des rôles construit : " << nClassified
+           << " volumes classés sur " << lvStore->size() << G4endl;
+}
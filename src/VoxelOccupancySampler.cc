@@ -0,0 +1,70 @@
+#include "VoxelOccupancySampler.hh"
+
+#include "G4VSolid.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+
+G4bool VoxelOccupancySampler::Build(const G4VSolid* solid, const G4ThreeVector& boxMin,
+                                    const G4ThreeVector& boxMax, G4int nMax)
+{
+    fSolid = solid;
+    fVoxels.clear();
+    fNbFull = 0;
+    if (!solid || nMax < 1) return false;
+
+    const G4ThreeVector extent = boxMax - boxMin;
+    const G4double longest = std::max({extent.x(), extent.y(), extent.z()});
+    if (longest <= 0.) return false;
+
+    // Voxels ~cubiques : pas commun, ajusté axe par axe pour couvrir exactement la boîte
+    const G4double target = longest / nMax;
+    for (G4int a = 0; a < 3; ++a) {
+        fN[a] = std::max(1, static_cast<G4int>(std::ceil(extent[a] / target - 1e-9)));
+    }
+    fMin  = boxMin;
+    fStep = G4ThreeVector(extent.x() / fN[0], extent.y() / fN[1], extent.z() / fN[2]);
+    const G4double halfDiagonal = 0.5 * fStep.mag();
+
+    for (G4int k = 0; k < fN[2]; ++k) {
+        for (G4int j = 0; j < fN[1]; ++j) {
+            for (G4int i = 0; i < fN[0]; ++i) {
+                const G4ThreeVector center = fMin + G4ThreeVector((i + 0.5) * fStep.x(),
+                                                                  (j + 0.5) * fStep.y(),
+                                                                  (k + 0.5) * fStep.z());
+                const EInside where = solid->Inside(center);
+                if (where == kOutside && solid->DistanceToIn(center) >= halfDiagonal) continue;
+
+                std::uint32_t index = static_cast<std::uint32_t>((k * fN[1] + j) * fN[0] + i);
+                if (where == kInside && solid->DistanceToOut(center) >= halfDiagonal) {
+                    ++fNbFull;
+                } else {
+                    index |= kPartialFlag;
+                }
+                fVoxels.push_back(index);
+            }
+        }
+    }
+    return !fVoxels.empty();
+}
+
+G4bool VoxelOccupancySampler::Sample(G4ThreeVector& point, G4int maxAttempts) const
+{
+    const std::size_t n = fVoxels.size();
+    for (G4int attempt = 0; attempt < maxAttempts; ++attempt) {
+        const std::size_t pick = std::min(static_cast<std::size_t>(G4UniformRand() * n), n - 1);
+        const std::uint32_t entry = fVoxels[pick];
+        const std::uint32_t index = entry & ~kPartialFlag;
+
+        const G4int i = static_cast<G4int>(index % fN[0]);
+        const G4int j = static_cast<G4int>((index / fN[0]) % fN[1]);
+        const G4int k = static_cast<G4int>(index / (static_cast<std::uint32_t>(fN[0]) * fN[1]));
+        point = fMin + G4ThreeVector((i + G4UniformRand()) * fStep.x(),
+                                     (j + G4UniformRand()) * fStep.y(),
+                                     (k + G4UniformRand()) * fStep.z());
+
+        if (!(entry & kPartialFlag) || fSolid->Inside(point) != kOutside) return true;
+    }
+    return false;
+}
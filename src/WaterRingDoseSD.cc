@@ -0,0 +1,51 @@
+#include "WaterRingDoseSD.hh"
+
+#include "EventAction.hh"
+#include "MuEnTable.hh"
+#include "RunAction.hh"
+#include "SteppingAction.hh"
+#include "VolumeRoleRegistry.hh"
+
+#include "G4EventManager.hh"
+#include "G4Gamma.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4VPhysicalVolume.hh"
+
+WaterRingDoseSD::WaterRingDoseSD(const G4String& name)
+    : G4VSensitiveDetector(name)
+{}
+
+G4bool WaterRingDoseSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+    if (!step) return false;
+
+    const G4StepPoint* pre = step->GetPreStepPoint();
+    const G4VPhysicalVolume* pv = pre->GetPhysicalVolume();
+    const G4int ringIndex = pv ? VolumeRoleRegistry::Lookup(pv->GetLogicalVolume()).ringIndex : -1;
+    if (ringIndex < 0) return false;
+
+    if (!fEventAction) {
+        auto* eventManager = G4EventManager::GetEventManager();
+        fEventAction = dynamic_cast<EventAction*>(eventManager->GetUserEventAction());
+        fSteppingAction = dynamic_cast<SteppingAction*>(eventManager->GetUserSteppingAction());
+        if (!fEventAction) return false;
+    }
+
+    // Estimateur par longueur de trace : tout pas de photon, même sans dépôt
+    if (fSteppingAction && fSteppingAction->GetTrackLengthEstimator() &&
+        step->GetTrack()->GetDefinition() == G4Gamma::Definition()) {
+        if (const MuEnTable* muEn = MuEnTable::ForMaterial(pre->GetMaterial())) {
+            const G4double ekin = pre->GetKineticEnergy();
+            const G4double tle  = pre->GetWeight() * step->GetStepLength() * ekin * muEn->GetMuEn(ekin);
+            fEventAction->AddTrackLengthToRing(ringIndex, tle / keV);   // en keV
+        }
+    }
+
+    const G4double edep = step->GetTotalEnergyDeposit();
+    if (edep <= 0.) return false;
+
+    fEventAction->AddEdepToRing(ringIndex, edep / keV * pre->GetWeight());  // keV × poids
+    if (auto* runAction = fEventAction->GetRunAction()) runAction->AddDepthEdep(ringIndex, step);
+    return true;
+}
@@ -0,0 +1,170 @@
+// spectrum_sampler_test.cc — non-régression du tirage de la source 2 (sans run Geant4)
+//
+// Usage : spectrum_sampler_test [nSamples]
+//
+// Compare SpectrumSampler::Sample() (table d'alias) au tirage d'origine de
+// PrimaryGeneratorAction2 : InverseCumul() sur le spectre complet, puis rejet
+// sous kEcut = 3.5 keV. Les deux tirages portent sur le spectre intégré (MiniXSpectrum.hh,
+// même table que PrimaryGeneratorAction2::InitFunction) et sont comparés sur :
+//   - la moyenne et le rms (écart < 5 sigma statistiques, et aux moments exacts)
+//   - un chi2 à deux échantillons sur le binning de H0 "E_emission" (150 bins, 0-50 keV)
+// Code de retour non nul si un critère échoue (entrée CTest).
+
+#include "MiniXSpectrum.hh"
+#include "SpectrumSampler.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+    constexpr G4double kEcut = MiniXSpectrum::kCut_keV*keV;
+
+    // Binning de H0 (AnalysisManagerSetup.cc)
+    constexpr G4int    kNbBins = 150;
+    constexpr G4double kHistMin = 0.;
+    constexpr G4double kHistMax = 50.*keV;
+
+    // Référence : tirage d'origine de PrimaryGeneratorAction2 (InverseCumul, retiré du
+    // générateur), inversion de la cumulée (polynôme d'ordre 2 par segment)
+    class InverseCumulSampler {
+    public:
+        InverseCumulSampler(const std::vector<G4double>& x, const std::vector<G4double>& y)
+            : fX(x), fY(y), fSlp(x.size()), fYC(x.size())
+        {
+            const G4int n = static_cast<G4int>(fX.size());
+            for (G4int j = 0; j < n - 1; j++) fSlp[j] = (fY[j + 1] - fY[j]) / (fX[j + 1] - fX[j]);
+            fYC[0] = 0.;
+            for (G4int j = 1; j < n; j++) fYC[j] = fYC[j - 1] + 0.5 * (fY[j] + fY[j - 1]) * (fX[j] - fX[j - 1]);
+        }
+
+        G4double InverseCumul() const
+        {
+            const G4int n = static_cast<G4int>(fX.size());
+            G4double Yrndm = G4UniformRand()*fYC[n-1];
+            G4int j = n-2;
+            while ((fYC[j] > Yrndm) && (j > 0)) j--;
+            G4double Xrndm = fX[j];
+            G4double a = fSlp[j];
+            if (a != 0.) {
+                G4double b = fY[j]/a, c = 2*(Yrndm - fYC[j])/a;
+                G4double delta = b*b + c;
+                G4int sign = 1; if (a < 0.) sign = -1;
+                Xrndm += sign*std::sqrt(delta) - b;
+            } else if (fY[j] > 0.) {
+                Xrndm += (Yrndm - fYC[j])/fY[j];
+            }
+            return Xrndm;
+        }
+
+        // Boucle de rejet de GeneratePrimaries avant la table d'alias
+        G4double Sample() const
+        {
+            G4double energy;
+            do { energy = InverseCumul(); } while (energy <= kEcut);
+            return energy;
+        }
+
+    private:
+        std::vector<G4double> fX, fY, fSlp, fYC;
+    };
+
+    struct Moments {
+        G4double mean = 0.;
+        G4double rms = 0.;
+        std::vector<G4double> counts = std::vector<G4double>(kNbBins, 0.);
+    };
+
+    template <class Sampler>
+    Moments Fill(const Sampler& sampler, std::size_t n)
+    {
+        Moments m;
+        G4double s1 = 0., s2 = 0.;
+        for (std::size_t i = 0; i < n; ++i) {
+            const G4double e = sampler.Sample();
+            s1 += e;
+            s2 += e*e;
+            const G4int bin = static_cast<G4int>((e - kHistMin) / (kHistMax - kHistMin) * kNbBins);
+            if (bin >= 0 && bin < kNbBins) m.counts[bin] += 1.;
+        }
+        m.mean = s1 / n;
+        m.rms = std::sqrt(std::max(0., s2 / n - m.mean*m.mean));
+        return m;
+    }
+
+    G4bool Check(const char* label, G4double value, G4double reference, G4double tolerance)
+    {
+        const G4bool ok = std::abs(value - reference) < tolerance;
+        std::cout << "  " << std::left << std::setw(34) << label << std::right
+                  << std::setw(10) << value/keV << " vs " << std::setw(10) << reference/keV
+                  << " keV  (tol " << tolerance/keV << ")  " << (ok ? "OK" : "ECHEC") << std::endl;
+        return ok;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t nSamples = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 2000000;
+    G4Random::setTheSeed(20240611L);
+
+    std::vector<G4double> x(MiniXSpectrum::kNbPoints), y(MiniXSpectrum::kNbPoints);
+    for (G4int j = 0; j < MiniXSpectrum::kNbPoints; j++) {
+        x[j] = MiniXSpectrum::kEnergy_keV[j]*keV;
+        y[j] = MiniXSpectrum::kIntensity[j];
+    }
+
+    SpectrumSampler alias;
+    if (!alias.Build(x, y, kEcut)) {
+        std::cerr << "[ERREUR] construction de la table d'alias impossible" << std::endl;
+        return 1;
+    }
+    const InverseCumulSampler reference(x, y);
+
+    const Moments mAlias = Fill(alias, nSamples);
+    const Moments mRef   = Fill(reference, nSamples);
+
+    std::cout << std::fixed << std::setprecision(4)
+              << "Spectre intégré, coupure " << kEcut/keV << " keV, " << nSamples << " tirages" << std::endl;
+
+    // 5 sigma sur la différence de deux moyennes (et sur le rms, même ordre de grandeur)
+    const G4double tolerance = 5. * std::sqrt(2. / nSamples) * mRef.rms;
+
+    G4bool ok = true;
+    ok &= Check("moyenne alias / InverseCumul", mAlias.mean, mRef.mean, tolerance);
+    ok &= Check("rms alias / InverseCumul", mAlias.rms, mRef.rms, tolerance);
+    ok &= Check("moyenne alias / exacte", mAlias.mean, alias.GetMean(), tolerance);
+    ok &= Check("rms alias / exact", mAlias.rms, alias.GetRms(), tolerance);
+
+    // Chi2 à deux échantillons de même taille : somme (a - b)² / (a + b) sur les bins non vides
+    G4double chi2 = 0.;
+    G4int ndf = -1;
+    for (G4int i = 0; i < kNbBins; ++i) {
+        const G4double a = mAlias.counts[i], b = mRef.counts[i];
+        if (a + b <= 0.) continue;
+        chi2 += (a - b)*(a - b) / (a + b);
+        ++ndf;
+    }
+    // Seuil : chi2 réduit sous 1 + 5 sqrt(2/ndf) (5 sigma pour ndf grand)
+    const G4double chi2Max = ndf + 5. * std::sqrt(2. * ndf);
+    const G4bool chi2Ok = ndf > 0 && chi2 < chi2Max;
+    std::cout << std::setprecision(1)
+              << "  chi2 (binning H0)                  " << chi2 << " / " << ndf << " ndf  (max "
+              << chi2Max << ")  " << (chi2Ok ? "OK" : "ECHEC") << std::endl;
+    ok &= chi2Ok;
+
+    // Aucun tirage sous la coupure
+    for (G4int i = 0; i < kNbBins; ++i) {
+        if ((i + 1) * (kHistMax - kHistMin) / kNbBins <= kEcut && mAlias.counts[i] > 0.) {
+            std::cout << "  [ERREUR] tirages alias sous la coupure (bin " << i << ")" << std::endl;
+            ok = false;
+        }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+// steptrace_decode.cc — décodeur des fichiers steptrace_*.bin écrits par StepTraceRecorder
+//
+// Usage : steptrace_decode <fichier.bin> [eventID]
+//
+// Affiche le même tableau que l'ancien SteppingAction::PrintStepInfo
+// (un step par ligne), éventuellement restreint à un seul événement.
+
+#include "StepTraceRecord.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+namespace {
+    std::string ParticleName(std::int32_t pdg)
+    {
+        switch (pdg) {
+            case 22:   return "gamma";
+            case 11:   return "e-";
+            case -11:  return "e+";
+            case 2212: return "proton";
+            case 2112: return "neutron";
+            default:   return std::to_string(pdg);
+        }
+    }
+
+    std::string Truncate(const std::string& s, std::size_t maxLen)
+    {
+        return (s.size() > maxLen) ? s.substr(0, maxLen - 2) + ".." : s;
+    }
+
+    std::string FormatPos(const float* p)
+    {
+        std::ostringstream os;
+        os << std::fixed << std::setprecision(2) << "(" << p[0] << "," << p[1] << "," << p[2] << ")";
+        return os.str();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::cerr << "Usage : " << argv[0] << " <steptrace.bin> [eventID]" << std::endl;
+        return 1;
+    }
+
+    const bool filterEvent = (argc > 2);
+    const std::int32_t wantedEvent = filterEvent ? std::atoi(argv[2]) : -1;
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::cerr << "Impossible d'ouvrir " << argv[1] << std::endl;
+        return 1;
+    }
+
+    StepTrace::FileHeader header;
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, StepTrace::kMagic, sizeof(header.magic)) != 0) {
+        std::cerr << "Fichier invalide (signature STPTRACE absente)" << std::endl;
+        return 1;
+    }
+    if (header.version != StepTrace::kVersion || header.recordSize != sizeof(StepTrace::Record)) {
+        std::cerr << "Version de format incompatible (version=" << header.version
+                  << ", recordSize=" << header.recordSize << ")" << std::endl;
+        return 1;
+    }
+
+    // Dictionnaire InstanceID -> nom de volume logique
+    std::map<std::int32_t, std::string> volumes;
+    for (std::uint32_t i = 0; i < header.nVolumes; ++i) {
+        std::uint32_t id = 0;
+        std::uint16_t len = 0;
+        in.read(reinterpret_cast<char*>(&id), sizeof(id));
+        in.read(reinterpret_cast<char*>(&len), sizeof(len));
+        std::string name(len, '\0');
+        in.read(&name[0], len);
+        volumes[static_cast<std::int32_t>(id)] = name;
+    }
+    auto volumeName = [&volumes](std::int16_t id) -> std::string {
+        if (id < 0) return "OutOfWorld";
+        auto it = volumes.find(id);
+        return (it != volumes.end()) ? it->second : "#" + std::to_string(id);
+    };
+
+    std::cout << "Thread " << header.threadId << " — " << header.nVolumes << " volumes\n"
+              << std::setw(6)  << "Evt"
+              << std::setw(6)  << "Trk"
+              << std::setw(5)  << "Stp"
+              << std::setw(8)  << "Part"
+              << std::setw(4)  << "Sec"
+              << std::setw(10) << "Ekin(keV)"
+              << "  " << std::left << std::setw(22) << "PreVolume" << std::right
+              << std::setw(26) << "PrePos(mm)"
+              << "  " << std::left << std::setw(22) << "PostVolume" << std::right
+              << std::setw(26) << "PostPos(mm)"
+              << "\n" << std::string(141, '-') << "\n";
+
+    StepTrace::Record r;
+    long nRead = 0, nShown = 0;
+    std::int32_t lastEvent = -1;
+    while (in.read(reinterpret_cast<char*>(&r), sizeof(r))) {
+        ++nRead;
+        if (filterEvent && r.eventID != wantedEvent) continue;
+        if (r.eventID != lastEvent) {
+            std::cout << "\n>>> Evenement #" << r.eventID << " <<<\n";
+            lastEvent = r.eventID;
+        }
+        std::cout << std::setw(6)  << r.eventID
+                  << std::setw(6)  << r.trackID
+                  << std::setw(5)  << r.stepNumber
+                  << std::setw(8)  << Truncate(ParticleName(r.pdg), 6)
+                  << std::setw(4)  << (r.parentID == 0 ? 0 : 1)
+                  << std::setw(10) << std::fixed << std::setprecision(3) << r.ekin_keV
+                  << "  " << std::left << std::setw(22) << Truncate(volumeName(r.preVolume), 20) << std::right
+                  << std::setw(26) << FormatPos(r.prePos)
+                  << "  " << std::left << std::setw(22) << Truncate(volumeName(r.postVolume), 20) << std::right
+                  << std::setw(26) << FormatPos(r.postPos)
+                  << "\n";
+        ++nShown;
+    }
+
+    std::cout << "\n" << nShown << " steps affichés (" << nRead << " dans le fichier)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,134 @@
+// trackidset_bench.cc — microbenchmark du dédoublonnage de TrackID par événement
+//
+// Usage : trackidset_bench [nEvents]
+//
+// Compare TrackIdSet (bitset réutilisé) aux deux implémentations précédentes
+// des scorers de plans :
+//   - std::set<G4int>, vidé à chaque événement (ScorePlaneNSD d'origine)
+//   - std::vector<G4int> + recherche linéaire, capacité conservée (PlaneCrossingSD, user-008)
+// sur deux profils d'événements :
+//   - 1 à 50 traces (événement typique : photon primaire + quelques secondaires)
+//   - 1000 à 5000 traces (gerbe dans le fantôme)
+// Chaque trace est présentée 1 à 4 fois (plusieurs steps dans le volume / plusieurs
+// volumes cibles), comme les appels à ScoreEntry. Seul globals.hh (G4Types) est utilisé :
+// pas d'édition de liens avec Geant4.
+
+#include "TrackIdSet.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+    // Séquences d'appels pré-tirées (le tirage ne doit pas entrer dans la mesure)
+    struct Workload {
+        std::vector<std::vector<G4int>> events;
+        std::size_t nCalls = 0;
+    };
+
+    Workload MakeWorkload(std::size_t nEvents, G4int minTracks, G4int maxTracks, std::uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<G4int> nTracks(minTracks, maxTracks);
+        std::uniform_int_distribution<G4int> repeats(1, 4);
+
+        Workload w;
+        w.events.resize(nEvents);
+        for (auto& calls : w.events) {
+            const G4int n = nTracks(rng);
+            for (G4int id = 1; id <= n; ++id) {
+                const G4int r = repeats(rng);
+                for (G4int k = 0; k < r; ++k) calls.push_back(id);
+            }
+            // Ordre de traitement des traces (pile LIFO de Geant4) : mélangé
+            std::shuffle(calls.begin(), calls.end(), rng);
+            w.nCalls += calls.size();
+        }
+        return w;
+    }
+
+    class SetDedup {
+    public:
+        void Clear() { fSet.clear(); }
+        G4bool Insert(G4int id) { return fSet.insert(id).second; }
+    private:
+        std::set<G4int> fSet;
+    };
+
+    class VectorDedup {
+    public:
+        void Clear() { fIds.clear(); }
+        G4bool Insert(G4int id)
+        {
+            if (std::find(fIds.begin(), fIds.end(), id) != fIds.end()) return false;
+            fIds.push_back(id);
+            return true;
+        }
+    private:
+        std::vector<G4int> fIds;
+    };
+
+    // Temps moyen par appel (ns) ; accepted évite l'élimination du calcul par le compilateur
+    template <class Dedup>
+    double Run(Dedup& dedup, const Workload& w, std::size_t& accepted)
+    {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (const auto& calls : w.events) {
+            dedup.Clear();
+            for (const G4int id : calls) accepted += dedup.Insert(id) ? 1 : 0;
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(w.nCalls);
+    }
+
+    bool Benchmark(const std::string& label, const Workload& w)
+    {
+        TrackIdSet bitset;
+        SetDedup stdSet;
+        VectorDedup vec;
+
+        // Passe de chauffe (capacités atteintes, caches chauds), puis mesure
+        std::size_t warm = 0;
+        Run(bitset, w, warm); Run(stdSet, w, warm); Run(vec, w, warm);
+
+        std::size_t accBitset = 0, accSet = 0, accVec = 0;
+        const double tBitset = Run(bitset, w, accBitset);
+        const double tSet    = Run(stdSet, w, accSet);
+        const double tVec    = Run(vec, w, accVec);
+
+        std::cout << "\n" << label << " : " << w.events.size() << " événements, "
+                  << w.nCalls << " appels Insert" << std::endl;
+        std::cout << std::fixed << std::setprecision(2)
+                  << "  TrackIdSet           " << std::setw(9) << tBitset << " ns/appel" << std::endl
+                  << "  std::set<G4int>      " << std::setw(9) << tSet    << " ns/appel  (x"
+                  << tSet / tBitset << ")" << std::endl
+                  << "  vector + std::find   " << std::setw(9) << tVec    << " ns/appel  (x"
+                  << tVec / tBitset << ")" << std::endl;
+
+        // Les trois implémentations doivent accepter exactement les mêmes traces
+        if (accBitset != accSet || accBitset != accVec) {
+            std::cerr << "  [ERREUR] traces acceptées différentes : " << accBitset << " / "
+                      << accSet << " / " << accVec << std::endl;
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t nSmall = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    const std::size_t nLarge = std::max<std::size_t>(1, nSmall / 200);
+
+    bool ok = true;
+    ok &= Benchmark("Petits événements (1-50 traces)", MakeWorkload(nSmall, 1, 50, 12345u));
+    ok &= Benchmark("Grands événements (1000-5000 traces)", MakeWorkload(nLarge, 1000, 5000, 54321u));
+    return ok ? 0 : 1;
+}